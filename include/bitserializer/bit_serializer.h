@@ -3,12 +3,22 @@
 * This file is part of BitSerializer library, licensed under the MIT license.  *
 *******************************************************************************/
 #pragma once
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <fstream>
+#include <future>
+#include <iterator>
+#include <vector>
 #include "config.h"
 #include "serialization_detail/serialization_base_types.h"
 #include "serialization_detail/key_value_proxy.h"
 #include "serialization_detail/validators.h"
 #include "serialization_detail/serialization_context.h"
+#include "serialization_detail/thread_pool.h"
+#include "serialization_detail/async_file_stream.h"
+#include "serialization_detail/compression_stream.h"
+#include "serialization_detail/load_by_path.h"
 
 namespace BitSerializer
 {
@@ -31,6 +41,64 @@ namespace BitSerializer
 	/// </summary>
 	static SerializationOptions DefaultOptions;
 
+	namespace Detail
+	{
+		/// <summary>
+		/// Calls the loading function with the input stream, compressed data is decompressed on the fly
+		/// (the compression is set in options or is detected by magic bytes).
+		/// </summary>
+		template <typename TStreamElem, typename TFunc>
+		void LoadFromStream(std::basic_istream<TStreamElem, std::char_traits<TStreamElem>>& input, const StreamOptions& streamOptions, TFunc&& loadFunc)
+		{
+			if constexpr (std::is_same_v<TStreamElem, char>)
+			{
+				if (const auto decompressionBuffer = DecompressionInputBuffer::Create(*input.rdbuf(), streamOptions.inputCompression))
+				{
+					std::istream decompressedStream(decompressionBuffer.get());
+					try {
+						loadFunc(decompressedStream);
+					}
+					catch (const SerializationException&)
+					{
+						// The error of decompression is the root cause
+						decompressionBuffer->ThrowIfError();
+						throw;
+					}
+					decompressionBuffer->ThrowIfError();
+					return;
+				}
+			}
+			loadFunc(input);
+		}
+
+		/// <summary>
+		/// Calls the saving function with the output stream, which compresses data when it is required by options.
+		/// </summary>
+		template <typename TStreamElem, typename TFunc>
+		void SaveToStream(std::basic_ostream<TStreamElem, std::char_traits<TStreamElem>>& output, const StreamOptions& streamOptions, TFunc&& saveFunc)
+		{
+			if (streamOptions.compression == CompressionType::None)
+			{
+				saveFunc(output);
+				return;
+			}
+
+			if constexpr (std::is_same_v<TStreamElem, char>)
+			{
+				CompressionOutputBuffer compressionBuffer(*output.rdbuf(), streamOptions.compression, streamOptions.compressionLevel);
+				std::ostream compressedStream(&compressionBuffer);
+				saveFunc(compressedStream);
+				if (compressedStream.bad()) {
+					throw SerializationException(SerializationErrorCode::InputOutputError, "Failed to write compressed data");
+				}
+				compressionBuffer.Finish();
+			}
+			else {
+				throw SerializationException(SerializationErrorCode::InvalidOptions, "Compression is supported only for streams of `char`");
+			}
+		}
+	}
+
 	/// <summary>
 	/// Loads the object from one of archive supported data type (strings, binary data).
 	/// </summary>
@@ -55,6 +123,7 @@ namespace BitSerializer
 
 	/// <summary>
 	/// Loads the object from stream (archive should have support serialization to stream).
+	/// Compressed data is decompressed on the fly (gzip and zstd are detected by magic bytes, zlib should be set in the stream options).
 	/// </summary>
 	/// <param name="object">The serializing object.</param>
 	/// <param name="input">The input stream.</param>
@@ -65,14 +134,74 @@ namespace BitSerializer
 		constexpr auto hasInputDataTypeSupport = is_archive_support_input_data_type_v<typename TArchive::input_archive_type, std::basic_istream<TStreamElem, std::char_traits<TStreamElem>>>;
 		static_assert(hasInputDataTypeSupport, "BitSerializer. The archive does not support loading from passed stream type.");
 
+		if constexpr (hasInputDataTypeSupport)
+		{
+			Detail::LoadFromStream(input, serializationOptions.streamOptions, [&object, &serializationOptions](auto& stream)
+			{
+				SerializationContext context(serializationOptions);
+				typename TArchive::input_archive_type archive(stream, context);
+				KeyValueProxy::SplitAndSerialize(archive, std::forward<T>(object));
+				archive.Finalize();
+				context.OnFinishSerialization();
+			});
+		}
+	}
+
+	/// <summary>
+	/// Loads only the part of document which is addressed by the path in JSON Pointer style (e.g. "/config/limits"),
+	/// the path separator is the same as in the `GetPath()` of archive. Other values of document are skipped without binding.
+	/// </summary>
+	/// <param name="object">The serializing object (the target for the addressed value).</param>
+	/// <param name="input">The input array.</param>
+	/// <param name="path">The path to the value, empty path means the whole document.</param>
+	/// <param name="serializationOptions">The serialization options.</param>
+	/// <returns>`false` when the path was not found in the document.</returns>
+	template <typename TArchive, typename T, typename TInput, std::enable_if_t<!is_input_stream_v<TInput>, int> = 0>
+	static bool LoadObject(T&& object, const TInput& input, std::string_view path, const SerializationOptions& serializationOptions = DefaultOptions)
+	{
+		constexpr auto hasInputDataTypeSupport = is_archive_support_input_data_type_v<typename TArchive::input_archive_type, TInput>;
+		static_assert(hasInputDataTypeSupport, "BitSerializer. The archive doesn't support loading from passed data type.");
+
 		if constexpr (hasInputDataTypeSupport)
 		{
 			SerializationContext context(serializationOptions);
 			typename TArchive::input_archive_type archive(input, context);
-			KeyValueProxy::SplitAndSerialize(archive, std::forward<T>(object));
+			const bool isFound = Detail::LoadByPath(archive, path, object);
 			archive.Finalize();
 			context.OnFinishSerialization();
+			return isFound;
 		}
+		return false;
+	}
+
+	/// <summary>
+	/// Loads only the part of document from stream, which is addressed by the path in JSON Pointer style (e.g. "/config/limits").
+	/// Archives with streaming parsers (like CSV) skip preceding rows without binding.
+	/// </summary>
+	/// <param name="object">The serializing object (the target for the addressed value).</param>
+	/// <param name="input">The input stream.</param>
+	/// <param name="path">The path to the value, empty path means the whole document.</param>
+	/// <param name="serializationOptions">The serialization options.</param>
+	/// <returns>`false` when the path was not found in the document.</returns>
+	template <typename TArchive, typename T, typename TStreamElem>
+	static bool LoadObject(T&& object, std::basic_istream<TStreamElem, std::char_traits<TStreamElem>>& input, std::string_view path, const SerializationOptions& serializationOptions = DefaultOptions)
+	{
+		constexpr auto hasInputDataTypeSupport = is_archive_support_input_data_type_v<typename TArchive::input_archive_type, std::basic_istream<TStreamElem, std::char_traits<TStreamElem>>>;
+		static_assert(hasInputDataTypeSupport, "BitSerializer. The archive does not support loading from passed stream type.");
+
+		bool isFound = false;
+		if constexpr (hasInputDataTypeSupport)
+		{
+			Detail::LoadFromStream(input, serializationOptions.streamOptions, [&object, path, &serializationOptions, &isFound](auto& stream)
+			{
+				SerializationContext context(serializationOptions);
+				typename TArchive::input_archive_type archive(stream, context);
+				isFound = Detail::LoadByPath(archive, path, object);
+				archive.Finalize();
+				context.OnFinishSerialization();
+			});
+		}
+		return isFound;
 	}
 
 	/// <summary>
@@ -99,6 +228,7 @@ namespace BitSerializer
 
 	/// <summary>
 	/// Saves the object to stream (archive should have support serialization to stream).
+	/// The output is compressed when it is set in the stream options.
 	/// </summary>
 	/// <param name="object">The serializing object.</param>
 	/// <param name="output">The output stream.</param>
@@ -111,11 +241,14 @@ namespace BitSerializer
 
 		if constexpr (hasOutputDataTypeSupport)
 		{
-			SerializationContext context(serializationOptions);
-			typename TArchive::output_archive_type archive(output, context);
-			KeyValueProxy::SplitAndSerialize(archive, std::forward<T>(object));
-			archive.Finalize();
-			context.OnFinishSerialization();
+			Detail::SaveToStream(output, serializationOptions.streamOptions, [&object, &serializationOptions](auto& stream)
+			{
+				SerializationContext context(serializationOptions);
+				typename TArchive::output_archive_type archive(stream, context);
+				KeyValueProxy::SplitAndSerialize(archive, std::forward<T>(object));
+				archive.Finalize();
+				context.OnFinishSerialization();
+			});
 		}
 	}
 
@@ -171,6 +304,293 @@ namespace BitSerializer
 			throw SerializationException(SerializationErrorCode::InputOutputError, "Could not open file: " + Convert::ToString(std::forward<TString>(path)));
 	}
 
+	/// <summary>
+	/// Asynchronously loads the object from file (archive should have support serialization to stream).
+	/// The file is read by blocks in a background thread, so reading overlaps with parsing.
+	/// </summary>
+	/// <remarks>The object must stay alive until the returned future is ready.</remarks>
+	/// <param name="object">The serializing object.</param>
+	/// <param name="path">The file path.</param>
+	/// <param name="serializationOptions">The serialization options.</param>
+	/// <returns>The future, which rethrows exceptions of loading.</returns>
+	template <typename TArchive, typename T, typename TString>
+	static std::future<void> LoadObjectFromFileAsync(T& object, TString&& path, const SerializationOptions& serializationOptions = DefaultOptions)
+	{
+		static_assert(std::is_same_v<typename TArchive::preferred_stream_char_type, char>,
+			"BitSerializer. Asynchronous loading from file is supported only for archives with `char` streams.");
+
+		return std::async(std::launch::async, [&object, path = std::decay_t<TString>(std::forward<TString>(path)), serializationOptions]()
+		{
+			Detail::AsyncFileReadBuffer fileBuffer;
+			if (!fileBuffer.Open(path)) {
+				throw SerializationException(SerializationErrorCode::InputOutputError, "File not found: " + Convert::ToString(path));
+			}
+			std::istream stream(&fileBuffer);
+			LoadObject<TArchive>(object, stream, serializationOptions);
+		});
+	}
+
+	/// <summary>
+	/// Asynchronously saves the object to file (archive should have support serialization to stream).
+	/// Encoded blocks are written to the file in a background thread, so writing overlaps with encoding.
+	/// </summary>
+	/// <remarks>The object must stay alive until the returned future is ready.</remarks>
+	/// <param name="object">The serializing object.</param>
+	/// <param name="path">The file path.</param>
+	/// <param name="serializationOptions">The serialization options.</param>
+	/// <returns>The future, which rethrows exceptions of saving.</returns>
+	template <typename TArchive, typename T, typename TString>
+	static std::future<void> SaveObjectToFileAsync(T& object, TString&& path, const SerializationOptions& serializationOptions = DefaultOptions)
+	{
+		static_assert(std::is_same_v<typename TArchive::preferred_stream_char_type, char>,
+			"BitSerializer. Asynchronous saving to file is supported only for archives with `char` streams.");
+
+		return std::async(std::launch::async, [&object, path = std::decay_t<TString>(std::forward<TString>(path)), serializationOptions]()
+		{
+			Detail::AsyncFileWriteBuffer fileBuffer;
+			if (!fileBuffer.Open(path)) {
+				throw SerializationException(SerializationErrorCode::InputOutputError, "Could not open file: " + Convert::ToString(path));
+			}
+			std::ostream stream(&fileBuffer);
+			SaveObject<TArchive>(object, stream, serializationOptions);
+			if (stream.flush().fail()) {
+				throw SerializationException(SerializationErrorCode::InputOutputError, "Could not write file: " + Convert::ToString(path));
+			}
+		});
+	}
+
+	//-----------------------------------------------------------------------------
+
+	/// <summary>
+	/// Serializer session - keeps resources of archive (DOM allocators, trees, buffers) and output buffer between calls,
+	/// which reduces the cost of setup when serializing a lot of small objects.
+	/// The session is not thread-safe, each thread should use its own session.
+	/// </summary>
+	/// <example><code>
+	/// SerializerSession&lt;JsonArchive&gt; session;
+	/// const std::string&amp; json = session.SaveObject(message);
+	/// session.LoadObject(message, json);
+	/// </code></example>
+	template <typename TArchive>
+	class SerializerSession
+	{
+	public:
+		using preferred_output_format = typename TArchive::preferred_output_format;
+
+		explicit SerializerSession(const SerializationOptions& serializationOptions = DefaultOptions)
+			: mSerializationOptions(serializationOptions)
+		{ }
+
+		SerializerSession(const SerializerSession&) = delete;
+		SerializerSession& operator=(const SerializerSession&) = delete;
+
+		[[nodiscard]] const SerializationOptions& GetOptions() const noexcept {
+			return mSerializationOptions;
+		}
+
+		/// <summary>
+		/// Loads the object from one of archive supported data type (strings, binary data).
+		/// </summary>
+		/// <param name="object">The serializing object.</param>
+		/// <param name="input">The input array.</param>
+		template <typename T, typename TInput, std::enable_if_t<!is_input_stream_v<TInput>, int> = 0>
+		void LoadObject(T&& object, const TInput& input)
+		{
+			constexpr auto hasInputDataTypeSupport = is_archive_support_input_data_type_v<typename TArchive::input_archive_type, TInput>;
+			static_assert(hasInputDataTypeSupport, "BitSerializer. The archive doesn't support loading from passed data type.");
+
+			if constexpr (hasInputDataTypeSupport) {
+				Load(std::forward<T>(object), input);
+			}
+		}
+
+		/// <summary>
+		/// Loads the object from stream (archive should have support serialization to stream).
+		/// </summary>
+		/// <param name="object">The serializing object.</param>
+		/// <param name="input">The input stream.</param>
+		template <typename T, typename TStreamElem>
+		void LoadObject(T&& object, std::basic_istream<TStreamElem, std::char_traits<TStreamElem>>& input)
+		{
+			constexpr auto hasInputDataTypeSupport = is_archive_support_input_data_type_v<typename TArchive::input_archive_type, std::basic_istream<TStreamElem, std::char_traits<TStreamElem>>>;
+			static_assert(hasInputDataTypeSupport, "BitSerializer. The archive does not support loading from passed stream type.");
+
+			if constexpr (hasInputDataTypeSupport) {
+				Detail::LoadFromStream(input, mSerializationOptions.streamOptions, [this, &object](auto& stream) { Load(std::forward<T>(object), stream); });
+			}
+		}
+
+		/// <summary>
+		/// Saves the object to one of archive supported data type (strings, binary data).
+		/// The output string is reserved to the size of previous output for the same type of object.
+		/// </summary>
+		/// <param name="object">The serializing object.</param>
+		/// <param name="output">The output array.</param>
+		template <typename T, typename TOutput, std::enable_if_t<!is_output_stream_v<TOutput>, int> = 0>
+		void SaveObject(T&& object, TOutput& output)
+		{
+			constexpr auto hasOutputDataTypeSupport = is_archive_support_output_data_type_v<typename TArchive::output_archive_type, TOutput>;
+			static_assert(hasOutputDataTypeSupport, "BitSerializer. The archive does not support save to passed data type.");
+
+			if constexpr (hasOutputDataTypeSupport)
+			{
+				if constexpr (std::is_same_v<TOutput, std::string>)
+				{
+					size_t& lastOutputSize = mSessionResources.Get<TLastOutputSize<std::decay_t<T>>>().size;
+					if (const size_t requiredCapacity = output.size() + lastOutputSize; output.capacity() < requiredCapacity) {
+						output.reserve(requiredCapacity);
+					}
+					const size_t prevOutputSize = output.size();
+					Save(std::forward<T>(object), output);
+					lastOutputSize = output.size() >= prevOutputSize ? output.size() - prevOutputSize : output.size();
+				}
+				else {
+					Save(std::forward<T>(object), output);
+				}
+			}
+		}
+
+		/// <summary>
+		/// Saves the object to stream (archive should have support serialization to stream).
+		/// </summary>
+		/// <param name="object">The serializing object.</param>
+		/// <param name="output">The output stream.</param>
+		template <typename T, typename TStreamElem>
+		void SaveObject(T&& object, std::basic_ostream<TStreamElem, std::char_traits<TStreamElem>>& output)
+		{
+			constexpr auto hasOutputDataTypeSupport = is_archive_support_output_data_type_v<typename TArchive::output_archive_type, std::basic_ostream<TStreamElem, std::char_traits<TStreamElem>>>;
+			static_assert(hasOutputDataTypeSupport, "BitSerializer. The archive does not support save to passed stream type.");
+
+			if constexpr (hasOutputDataTypeSupport) {
+				Detail::SaveToStream(output, mSerializationOptions.streamOptions, [this, &object](auto& stream) { Save(std::forward<T>(object), stream); });
+			}
+		}
+
+		/// <summary>
+		/// Saves the object to the internal buffer of session.
+		/// </summary>
+		/// <param name="object">The serializing object.</param>
+		/// <returns>The reference to the output, which stays valid until the next call of this method.</returns>
+		template <typename T>
+		const preferred_output_format& SaveObject(T&& object)
+		{
+			mOutput.clear();
+			SaveObject(std::forward<T>(object), mOutput);
+			return mOutput;
+		}
+
+	private:
+		template <typename T, typename TInput>
+		void Load(T&& object, TInput& input)
+		{
+			SerializationContext context(mSerializationOptions, &mSessionResources);
+			typename TArchive::input_archive_type archive(input, context);
+			KeyValueProxy::SplitAndSerialize(archive, std::forward<T>(object));
+			archive.Finalize();
+			context.OnFinishSerialization();
+		}
+
+		template <typename T, typename TOutput>
+		void Save(T&& object, TOutput& output)
+		{
+			SerializationContext context(mSerializationOptions, &mSessionResources);
+			typename TArchive::output_archive_type archive(output, context);
+			KeyValueProxy::SplitAndSerialize(archive, std::forward<T>(object));
+			archive.Finalize();
+			context.OnFinishSerialization();
+		}
+
+		template <typename T>
+		struct TLastOutputSize
+		{
+			size_t size = 0;
+		};
+
+		// Options are copied, as the session can live longer than the passed object
+		const SerializationOptions mSerializationOptions;
+		SessionResources mSessionResources;
+		preferred_output_format mOutput;
+	};
+
+	//-----------------------------------------------------------------------------
+
+	namespace Detail
+	{
+		/// <summary>
+		/// Processes the batch of independent items in the thread pool, each participating thread takes the next free item
+		/// and uses its own serializer session. Returns the exception for each failed item (`nullptr` for succeeded ones).
+		/// </summary>
+		template <typename TArchive, typename TFunc>
+		std::vector<std::exception_ptr> ProcessBatch(size_t itemsNum, const SerializationOptions& serializationOptions, ThreadPool& threadPool, TFunc&& func)
+		{
+			std::vector<std::exception_ptr> errors(itemsNum);
+			std::atomic<size_t> nextItem = 0;
+			const size_t lanesNum = std::min(itemsNum, threadPool.GetThreadsNumber() + 1);
+			threadPool.ParallelFor(lanesNum, [&](size_t)
+			{
+				SerializerSession<TArchive> session(serializationOptions);
+				for (size_t index = nextItem++; index < itemsNum; index = nextItem++)
+				{
+					try {
+						func(session, index);
+					}
+					catch (...) {
+						errors[index] = std::current_exception();
+					}
+				}
+			});
+			return errors;
+		}
+	}
+
+	/// <summary>
+	/// Saves the batch of independent objects in parallel (the output container is resized to the number of objects).
+	/// A failure of one object does not abort the batch, errors are returned per object.
+	/// </summary>
+	/// <param name="objects">The range of serializing objects (with random access iterators).</param>
+	/// <param name="outputs">The container for outputs, like <c>std::vector&lt;std::string&gt;</c>.</param>
+	/// <param name="serializationOptions">The serialization options.</param>
+	/// <param name="threadPool">The thread pool (by default - shared pool of library).</param>
+	/// <returns>The exception for each failed object (<c>nullptr</c> for succeeded ones).</returns>
+	template <typename TArchive, typename TRange, typename TOutputs>
+	static std::vector<std::exception_ptr> SaveObjects(TRange&& objects, TOutputs& outputs,
+		const SerializationOptions& serializationOptions = DefaultOptions, ThreadPool& threadPool = ThreadPool::GetDefault())
+	{
+		const auto objectsIt = std::begin(objects);
+		const auto itemsNum = static_cast<size_t>(std::distance(objectsIt, std::end(objects)));
+		outputs.resize(itemsNum);
+		return Detail::ProcessBatch<TArchive>(itemsNum, serializationOptions, threadPool,
+			[&objectsIt, &outputs](SerializerSession<TArchive>& session, size_t index)
+		{
+			auto& output = outputs[index];
+			output.clear();
+			session.SaveObject(objectsIt[index], output);
+		});
+	}
+
+	/// <summary>
+	/// Loads the batch of independent objects in parallel (the container of targets is resized to the number of inputs).
+	/// A failure of one object does not abort the batch, errors are returned per object.
+	/// </summary>
+	/// <param name="inputs">The range of inputs (with random access iterators).</param>
+	/// <param name="targets">The container for loaded objects, like <c>std::vector&lt;TMessage&gt;</c>.</param>
+	/// <param name="serializationOptions">The serialization options.</param>
+	/// <param name="threadPool">The thread pool (by default - shared pool of library).</param>
+	/// <returns>The exception for each failed object (<c>nullptr</c> for succeeded ones).</returns>
+	template <typename TArchive, typename TRange, typename TTargets>
+	static std::vector<std::exception_ptr> LoadObjects(const TRange& inputs, TTargets& targets,
+		const SerializationOptions& serializationOptions = DefaultOptions, ThreadPool& threadPool = ThreadPool::GetDefault())
+	{
+		const auto inputsIt = std::begin(inputs);
+		const auto itemsNum = static_cast<size_t>(std::distance(inputsIt, std::end(inputs)));
+		targets.resize(itemsNum);
+		return Detail::ProcessBatch<TArchive>(itemsNum, serializationOptions, threadPool,
+			[&inputsIt, &targets](SerializerSession<TArchive>& session, size_t index)
+		{
+			session.LoadObject(targets[index], inputsIt[index]);
+		});
+	}
+
 } // namespace BitSerializer
 
 
@@ -3,15 +3,19 @@
 * This file is part of BitSerializer library, licensed under the MIT license.  *
 *******************************************************************************/
 #pragma once
+#include <array>
 #include <string>
+#include <string_view>
 #include <cctype>
-#include <cstring>
+#include <cstdint>
 #include <algorithm>
 #include <stdexcept>
+#include <type_traits>
 
 
 /// <summary>
 /// Registers a map of strings equivalents for enum type.
+/// The map and lookup tables (by value and by name) are built at compile time, the registration does not copy them.
 /// </summary>
 /// <example><code>
 /// REGISTER_ENUM(YOUR_ENUM_TYPE, {
@@ -20,7 +24,9 @@
 /// })
 /// </code></example>
 #define REGISTER_ENUM(enumType, ...) namespace { \
-	static const bool registration_##enumType = ::BitSerializer::Convert::Detail::EnumRegistry<enumType>::Register(__VA_ARGS__); \
+	static constexpr ::BitSerializer::Convert::Detail::EnumMetadata<enumType> enumMetadata_##enumType[] = __VA_ARGS__; \
+	static constexpr auto enumLookupTables_##enumType = ::BitSerializer::Convert::Detail::MakeEnumLookupTables(enumMetadata_##enumType); \
+	static const bool registration_##enumType = ::BitSerializer::Convert::Detail::EnumRegistry<enumType>::Register(enumMetadata_##enumType, enumLookupTables_##enumType); \
 }
 
 /// Deprecated enum registration
@@ -59,23 +65,167 @@ namespace BitSerializer::Convert::Detail
 		TEnum Value{};
 		std::string_view Name;
 
-		EnumMetadata() = default;
-		EnumMetadata(TEnum value, const char* name)
+		constexpr EnumMetadata() = default;
+		constexpr EnumMetadata(TEnum value, const char* name)
 			: Value(value), Name(name)
 		{ }
 	};
 
+	/// <summary>
+	/// Converts the code unit of any character type to lower case (only ASCII characters, does not depend on locale).
+	/// </summary>
+	template <typename TSym>
+	constexpr uint32_t ToLowerAscii(TSym sym) noexcept
+	{
+		const auto code = static_cast<uint32_t>(static_cast<std::make_unsigned_t<TSym>>(sym));
+		return (code >= 'A' && code <= 'Z') ? code + ('a' - 'A') : code;
+	}
+
+	/// <summary>
+	/// Calculates case-insensitive hash of the enum name (FNV-1a).
+	/// </summary>
+	template <typename TSym>
+	constexpr size_t HashEnumName(std::basic_string_view<TSym> name) noexcept
+	{
+		uint32_t hash = 2166136261u;
+		for (const TSym sym : name)
+		{
+			hash ^= ToLowerAscii(sym);
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+
+	/// <summary>
+	/// Compares the enum names without case sensitivity.
+	/// </summary>
+	template <typename TSym>
+	constexpr bool EqualEnumNames(std::basic_string_view<TSym> lhs, std::string_view rhs) noexcept
+	{
+		if (lhs.size() != rhs.size()) {
+			return false;
+		}
+		for (size_t i = 0; i < lhs.size(); ++i)
+		{
+			if (ToLowerAscii(lhs[i]) != ToLowerAscii(rhs[i])) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/// <summary>
+	/// Returns the number of slots in the hash table of enum names (the power of two, which is at least twice more than number of names).
+	/// </summary>
+	constexpr size_t GetEnumNameSlotsCount(size_t namesCount) noexcept
+	{
+		size_t slotsCount = 2;
+		while (slotsCount < namesCount * 2) {
+			slotsCount *= 2;
+		}
+		return slotsCount;
+	}
+
+	/// <summary>
+	/// Tables for looking up enum metadata by value and by name.
+	/// </summary>
+	template <size_t Size>
+	struct EnumLookupTables
+	{
+		/// Indexes of metadata which are sorted by value (when values are consecutive, the index is found directly)
+		std::array<size_t, Size> SortedIndexes{};
+		/// Hash table of names with linear probing (stores index of metadata + 1, zero means the empty slot)
+		std::array<size_t, GetEnumNameSlotsCount(Size)> NameSlots{};
+		bool IsDense = false;
+	};
+
+	/// <summary>
+	/// Builds lookup tables for enum metadata (can be evaluated at compile time).
+	/// The first registered metadata is found when there are several with the same value or name.
+	/// </summary>
+	template <typename TEnum, size_t Size>
+	constexpr EnumLookupTables<Size> MakeEnumLookupTables(const EnumMetadata<TEnum>(&descriptors)[Size])
+	{
+		using underlying_type = std::underlying_type_t<TEnum>;
+		EnumLookupTables<Size> tables;
+
+		// Stable insertion sort by value
+		for (size_t i = 0; i < Size; ++i)
+		{
+			size_t pos = i;
+			for (; pos > 0 && static_cast<underlying_type>(descriptors[i].Value) < static_cast<underlying_type>(descriptors[tables.SortedIndexes[pos - 1]].Value); --pos) {
+				tables.SortedIndexes[pos] = tables.SortedIndexes[pos - 1];
+			}
+			tables.SortedIndexes[pos] = i;
+		}
+
+		tables.IsDense = true;
+		const auto minValue = static_cast<uint64_t>(static_cast<underlying_type>(descriptors[tables.SortedIndexes[0]].Value));
+		for (size_t i = 1; i < Size; ++i)
+		{
+			if (static_cast<uint64_t>(static_cast<underlying_type>(descriptors[tables.SortedIndexes[i]].Value)) - minValue != i)
+			{
+				tables.IsDense = false;
+				break;
+			}
+		}
+
+		constexpr size_t slotsMask = GetEnumNameSlotsCount(Size) - 1;
+		for (size_t i = 0; i < Size; ++i)
+		{
+			size_t pos = HashEnumName(descriptors[i].Name) & slotsMask;
+			bool isDuplicate = false;
+			for (; tables.NameSlots[pos] != 0; pos = (pos + 1) & slotsMask)
+			{
+				if (EqualEnumNames(descriptors[i].Name, descriptors[tables.NameSlots[pos] - 1].Name))
+				{
+					isDuplicate = true;
+					break;
+				}
+			}
+			if (!isDuplicate) {
+				tables.NameSlots[pos] = i + 1;
+			}
+		}
+		return tables;
+	}
+
 
 	template <typename TEnum>
 	class EnumRegistry
 	{
 	public:
+		using underlying_type = std::underlying_type_t<TEnum>;
+
 		template <size_t Size>
 		[[deprecated("Please use new macro REGISTER_ENUM() for registration enum types")]]
 		static bool Register_(const EnumMetadata<TEnum>(&descriptors)[Size]) {
 			return Register<Size>(descriptors);
 		}
 
+		/// <summary>
+		/// Registers metadata with lookup tables, which should have static storage duration (they are not copied).
+		/// </summary>
+		template <size_t Size>
+		static bool Register(const EnumMetadata<TEnum>(&descriptors)[Size], const EnumLookupTables<Size>& lookupTables)
+		{
+			// Check is that type was already registered
+			if (mBeginIt != nullptr) {
+				return false;
+			}
+
+			mBeginIt = descriptors;
+			mEndIt = descriptors + Size;
+			mSortedIndexes = lookupTables.SortedIndexes.data();
+			mNameSlots = lookupTables.NameSlots.data();
+			mNameSlotsMask = lookupTables.NameSlots.size() - 1;
+			mIsDense = lookupTables.IsDense;
+			return true;
+		}
+
+		/// <summary>
+		/// Registers metadata from the temporary array (copies it and builds lookup tables at runtime).
+		/// </summary>
 		template <size_t Size>
 		static bool Register(const EnumMetadata<TEnum>(&descriptors)[Size])
 		{
@@ -85,35 +235,50 @@ namespace BitSerializer::Convert::Detail
 			}
 
 			static EnumMetadata<TEnum> descriptors_[Size];
-			std::memcpy(descriptors_, descriptors, sizeof(EnumMetadata<TEnum>) * Size);
-			mBeginIt = descriptors_;
-			mEndIt = descriptors_ + Size;
-			return true;
+			std::copy(descriptors, descriptors + Size, descriptors_);
+			static const EnumLookupTables<Size> lookupTables_ = MakeEnumLookupTables(descriptors_);
+			return Register(descriptors_, lookupTables_);
 		}
 
 		static const EnumMetadata<TEnum>& GetEnumMetadata(TEnum val)
 		{
-			const auto it = std::find_if(mBeginIt, mEndIt, [val](const EnumMetadata<TEnum>& metadata) {
-				return metadata.Value == val;
-			});
-			if (it == cend()) {
-				throw std::invalid_argument("Enum with passed value is not registered");
+			if (const size_t count = size(); count != 0)
+			{
+				if (mIsDense)
+				{
+					const auto offset = static_cast<uint64_t>(static_cast<underlying_type>(val))
+						- static_cast<uint64_t>(static_cast<underlying_type>(mBeginIt[mSortedIndexes[0]].Value));
+					if (offset < count) {
+						return mBeginIt[mSortedIndexes[offset]];
+					}
+				}
+				else
+				{
+					const auto it = std::lower_bound(mSortedIndexes, mSortedIndexes + count, val, [](size_t index, TEnum value) {
+						return static_cast<underlying_type>(mBeginIt[index].Value) < static_cast<underlying_type>(value);
+					});
+					if (it != mSortedIndexes + count && mBeginIt[*it].Value == val) {
+						return mBeginIt[*it];
+					}
+				}
 			}
-			return *it;
+			throw std::invalid_argument("Enum with passed value is not registered");
 		}
 
 		template <typename TSym>
 		static const EnumMetadata<TEnum>& GetEnumMetadata(std::basic_string_view<TSym> name)
 		{
-			const auto it = std::find_if(mBeginIt, mEndIt, [name](const auto& metadata) {
-				return std::equal(name.cbegin(), name.cend(), metadata.Name.cbegin(), metadata.Name.cend(), [](const TSym lhs, const char rhs) {
-					return std::tolower(static_cast<int>(lhs)) == std::tolower(rhs);
-				});
-			});
-			if (it == cend()) {
-				throw std::invalid_argument("Enum with passed name is not registered");
+			if (mNameSlots != nullptr)
+			{
+				for (size_t pos = HashEnumName(name) & mNameSlotsMask; mNameSlots[pos] != 0; pos = (pos + 1) & mNameSlotsMask)
+				{
+					const auto& metadata = mBeginIt[mNameSlots[pos] - 1];
+					if (EqualEnumNames(name, metadata.Name)) {
+						return metadata;
+					}
+				}
 			}
-			return *it;
+			throw std::invalid_argument("Enum with passed name is not registered");
 		}
 
 		template <typename TSym, typename TAllocator>
@@ -142,7 +307,11 @@ namespace BitSerializer::Convert::Detail
 		}
 
 	private:
-		static inline EnumMetadata<TEnum>* mBeginIt = nullptr;
-		static inline EnumMetadata<TEnum>* mEndIt = nullptr;
+		static inline const EnumMetadata<TEnum>* mBeginIt = nullptr;
+		static inline const EnumMetadata<TEnum>* mEndIt = nullptr;
+		static inline const size_t* mSortedIndexes = nullptr;
+		static inline const size_t* mNameSlots = nullptr;
+		static inline size_t mNameSlotsMask = 0;
+		static inline bool mIsDense = false;
 	};
 }
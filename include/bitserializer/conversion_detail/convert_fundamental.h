@@ -3,6 +3,9 @@
 * This file is part of BitSerializer library, licensed under the MIT license.  *
 *******************************************************************************/
 #pragma once
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
 #include <cstring>
 #include <cstdio>
 #include <cstdlib>
@@ -15,10 +18,69 @@
 namespace BitSerializer::Convert::Detail
 {
 	/// <summary>
-	/// Converts any UTF string to integer types.
+	/// Parses the integer number from the range of any characters (accepts the same format as `std::from_chars()`).
+	/// The iterator is moved to the first character which is not a part of number.
 	/// </summary>
-	template <typename T, typename TSym, std::enable_if_t<(std::is_integral_v<T>), int> = 0>
-	void To(std::basic_string_view<TSym> in, T& out)
+	template <typename T, typename TSym>
+	std::errc ParseInteger(const TSym*& it, const TSym* end, T& out) noexcept
+	{
+		using unsigned_type = std::make_unsigned_t<T>;
+		constexpr auto maxValue = std::numeric_limits<unsigned_type>::max();
+
+		const TSym* const startPos = it;
+		bool isNegative = false;
+		if constexpr (std::is_signed_v<T>)
+		{
+			if (it != end && *it == '-')
+			{
+				isNegative = true;
+				++it;
+			}
+		}
+
+		const TSym* const digitsPos = it;
+		unsigned_type value = 0;
+		bool isOverflow = false;
+		for (; it != end && *it >= '0' && *it <= '9'; ++it)
+		{
+			const auto digit = static_cast<unsigned_type>(*it - '0');
+			if (value > (maxValue - digit) / 10) {
+				isOverflow = true;
+			}
+			else {
+				value = static_cast<unsigned_type>(value * 10 + digit);
+			}
+		}
+
+		if (it == digitsPos)
+		{
+			it = startPos;
+			return std::errc::invalid_argument;
+		}
+		if (isOverflow) {
+			return std::errc::result_out_of_range;
+		}
+
+		if constexpr (std::is_signed_v<T>)
+		{
+			const auto limit = static_cast<unsigned_type>(static_cast<unsigned_type>(std::numeric_limits<T>::max()) + isNegative);
+			if (value > limit) {
+				return std::errc::result_out_of_range;
+			}
+			out = static_cast<T>(isNegative ? static_cast<unsigned_type>(0 - value) : value);
+		}
+		else {
+			out = value;
+		}
+		return {};
+	}
+
+	/// <summary>
+	/// Parses the integer number from any UTF string without throwing exceptions (leading spaces are skipped).
+	/// Returns `std::errc::not_supported` when the string contains a float number, the output value is changed only on success.
+	/// </summary>
+	template <typename T, typename TSym>
+	std::errc TryParseInteger(std::basic_string_view<TSym> in, T& out) noexcept
 	{
 		const auto* it = in.data();
 		const auto* end = it + in.size();
@@ -26,97 +88,199 @@ namespace BitSerializer::Convert::Detail
 		// ReSharper disable once CppPossiblyErroneousEmptyStatements
 		for (; (it != end) && (*it == 0x20 || *it == 0x09); ++it);	// Skip spaces
 
-		const auto validateResult = [](std::from_chars_result rc, std::string_view str)
+		T result;
+		if constexpr (std::is_same_v<TSym, char>)
 		{
-			if (rc.ec != std::errc())
-			{
-				if (rc.ec == std::errc::result_out_of_range) {
-					throw std::out_of_range("Argument out of range");
-				}
-				if (rc.ec == std::errc::invalid_argument) {
-					throw std::invalid_argument("Input string is not a number");
-				}
-				throw std::runtime_error("Unknown error");
+			const auto rc = std::from_chars(it, end, result);
+			if (rc.ec != std::errc()) {
+				return rc.ec;
 			}
-
-			// Check that string does not contain decimal fractions (parsing a float number to integer is not allowed)
-			if (rc.ptr + 1 < str.data() + str.size() && *rc.ptr == '.' && std::isdigit(*(rc.ptr + 1)))
-			{
-				throw std::invalid_argument("Unable to convert string with float number to integer");
+			it = rc.ptr;
+		}
+		else
+		{
+			// Other types of characters are parsed directly (without intermediate UTF-8 string)
+			if (const auto ec = ParseInteger(it, end, result); ec != std::errc()) {
+				return ec;
 			}
-		};
+		}
 
-		if constexpr (sizeof(TSym) == sizeof(char)) {
-			// Uses from_chars only for convert integers as GCC does not support floating types
-			validateResult(std::from_chars(it, end, out), in);
+		// Check that string does not contain decimal fractions (parsing a float number to integer is not allowed)
+		if (it + 1 < end && *it == '.' && it[1] >= '0' && it[1] <= '9') {
+			return std::errc::not_supported;
 		}
-		else {
-			std::string utf8Str;
-			Utf8::Encode(it, end, utf8Str);
-			validateResult(std::from_chars(utf8Str.data(), utf8Str.data() + utf8Str.size(), out), utf8Str);
+		out = result;
+		return {};
+	}
+
+	/// <summary>
+	/// Converts any UTF string to integer types.
+	/// </summary>
+	template <typename T, typename TSym, std::enable_if_t<(std::is_integral_v<T>), int> = 0>
+	void To(std::basic_string_view<TSym> in, T& out)
+	{
+		const auto ec = TryParseInteger(in, out);
+		if (ec != std::errc())
+		{
+			if (ec == std::errc::result_out_of_range) {
+				throw std::out_of_range("Argument out of range");
+			}
+			if (ec == std::errc::invalid_argument) {
+				throw std::invalid_argument("Input string is not a number");
+			}
+			if (ec == std::errc::not_supported) {
+				throw std::invalid_argument("Unable to convert string with float number to integer");
+			}
+			throw std::runtime_error("Unknown error");
 		}
 	}
 
+	/// <summary>
+	/// Size of buffer which is enough for the text representation of any floating point number.
+	/// </summary>
+	static constexpr size_t FloatCharsBufferSize = 64;
+
+#if !defined(__cpp_lib_to_chars)
 	namespace _stdWrappers
 	{
 		template <typename T> T _fromStr(const char*, char**) { throw; }
-		template <typename T> T _fromStr(const wchar_t*, wchar_t**) { throw; }
 
 		template <>	inline float _fromStr<float>(const char* str, char** out_strEnd) { return std::strtof(str, out_strEnd); }
-		template <>	inline float _fromStr<float>(const wchar_t* str, wchar_t** out_strEnd) { return std::wcstof(str, out_strEnd); }
-
 		template <>	inline double _fromStr<double>(const char* str, char** out_strEnd) { return std::strtod(str, out_strEnd); }
-		template <>	inline double _fromStr<double>(const wchar_t* str, wchar_t** out_strEnd) { return std::wcstod(str, out_strEnd); }
-
 		template <>	inline long double _fromStr<long double>(const char* str, char** out_strEnd) { return std::strtold(str, out_strEnd); }
-		template <>	inline long double _fromStr<long double>(const wchar_t* str, wchar_t** out_strEnd) { return std::wcstold(str, out_strEnd); }
 	}
+#endif
 
 	/// <summary>
-	/// Converts any UTF string to floating types.
+	/// Parses the floating point number from the range of ASCII characters (via `std::from_chars()` when it is supported by the standard library).
 	/// </summary>
-	template <typename T, typename TSym, std::enable_if_t<(std::is_floating_point_v<T>), int> = 0>
-	void To(std::basic_string_view<TSym> in, T& out)
+	template <typename T>
+	std::from_chars_result ParseFloat(const char* first, const char* last, T& out) noexcept
 	{
-		T result;
-		bool isNaN;
-		static constexpr size_t bufSize = 64;
-		const size_t size = (in.size() < bufSize) ? in.size() : bufSize - 1;
-		if constexpr (std::is_same_v<char, TSym>)
+#if defined(__cpp_lib_to_chars)
+		return std::from_chars(first, last, out);
+#else
+		// Fallback to locale dependent functions, which require the null-terminated string (the heap is used only for very long numbers)
+		const auto parse = [first, &out](const char* str) -> std::from_chars_result
 		{
-			// Copy to temporary buffer for prepare null-terminated c-string
-			char buf[bufSize];
-			std::memcpy(buf, in.data(), size);
-			buf[size] = 0;
 			char* endPos = nullptr;
-			result = _stdWrappers::_fromStr<T>(buf, &endPos);
-			isNaN = buf == endPos;
+			errno = 0;
+			out = _stdWrappers::_fromStr<T>(str, &endPos);
+			if (endPos == str) {
+				return { first, std::errc::invalid_argument };
+			}
+			return { first + (endPos - str), errno == ERANGE ? std::errc::result_out_of_range : std::errc() };
+		};
+
+		// Unlike `std::from_chars()`, the `strtod()` parses hexadecimal numbers, so the parsing is stopped at the prefix
+		const char* digitsPos = first != last && *first == '-' ? first + 1 : first;
+		if (last - digitsPos >= 2 && digitsPos[0] == '0' && (digitsPos[1] == 'x' || digitsPos[1] == 'X')) {
+			last = digitsPos + 1;
 		}
-		else if constexpr (sizeof(TSym) == sizeof(wchar_t))
+
+		const auto size = static_cast<size_t>(last - first);
+		if (size < FloatCharsBufferSize)
 		{
-			wchar_t buf[bufSize];
-			std::wmemcpy(buf, reinterpret_cast<wchar_t const*>(in.data()), size);
+			char buf[FloatCharsBufferSize];
+			std::memcpy(buf, first, size);
 			buf[size] = 0;
-			wchar_t* endPos = nullptr;
-			result = _stdWrappers::_fromStr<T>(buf, &endPos);
-			isNaN = buf == endPos;
+			return parse(buf);
+		}
+		try {
+			return parse(std::string(first, last).c_str());
+		}
+		catch (const std::bad_alloc&) {
+			return { first, std::errc::not_enough_memory };
+		}
+#endif
+	}
+
+	/// <summary>
+	/// Parses the floating point number from any UTF string without throwing exceptions.
+	/// Does not depend on locale, leading spaces and plus sign are skipped, the rest of string can contain only spaces.
+	/// The output value is changed only on success.
+	/// </summary>
+	template <typename T, typename TSym>
+	std::errc TryParseFloat(std::basic_string_view<TSym> in, T& out) noexcept
+	{
+		const auto* it = in.data();
+		const auto* end = it + in.size();
+
+		// ReSharper disable once CppPossiblyErroneousEmptyStatements
+		for (; (it != end) && (*it == 0x20 || *it == 0x09); ++it);	// Skip spaces
+		if (it != end && *it == '+' && (it + 1 == end || it[1] != '-')) {
+			++it;
+		}
+
+		T result;
+		if constexpr (sizeof(TSym) == sizeof(char))
+		{
+			const auto rc = ParseFloat(reinterpret_cast<const char*>(it), reinterpret_cast<const char*>(end), result);
+			if (rc.ec != std::errc()) {
+				return rc.ec;
+			}
+			it += rc.ptr - reinterpret_cast<const char*>(it);
 		}
 		else
 		{
-			std::string utf8Str;
-			Utf8::Encode(in.cbegin(), in.cend(), utf8Str);
-			char* endPos = nullptr;
-			result = _stdWrappers::_fromStr<T>(utf8Str.c_str(), &endPos);
-			isNaN = utf8Str.data() == endPos;
+			// The number consists of ASCII characters, so it is narrowed up to the first non-ASCII character
+			const auto* asciiEnd = it;
+			for (; asciiEnd != end && static_cast<uint32_t>(*asciiEnd) < 0x80; ++asciiEnd) {}
+			const auto size = static_cast<size_t>(asciiEnd - it);
+
+			std::from_chars_result rc;
+			if (size <= FloatCharsBufferSize)
+			{
+				char buf[FloatCharsBufferSize];
+				std::copy(it, asciiEnd, buf);
+				rc = ParseFloat(buf, buf + size, result);
+				it += rc.ptr - buf;
+			}
+			else
+			{
+				// Very long number (e.g. with many leading zeros)
+				try
+				{
+					const std::string longNumber(it, asciiEnd);
+					rc = ParseFloat(longNumber.data(), longNumber.data() + size, result);
+					it += rc.ptr - longNumber.data();
+				}
+				catch (const std::bad_alloc&) {
+					return std::errc::not_enough_memory;
+				}
+			}
+			if (rc.ec != std::errc()) {
+				return rc.ec;
+			}
 		}
 
-		if (errno == ERANGE) {
+		// The number should not be followed by other characters (e.g. "0x10" is not parsed as zero)
+		// ReSharper disable once CppPossiblyErroneousEmptyStatements
+		for (; (it != end) && (*it == 0x20 || *it == 0x09 || *it == 0x0D || *it == 0x0A); ++it);	// Skip spaces
+		if (it != end) {
+			return std::errc::invalid_argument;
+		}
+		out = result;
+		return {};
+	}
+
+	/// <summary>
+	/// Converts any UTF string to floating types.
+	/// Does not depend on locale, leading spaces and plus sign are skipped.
+	/// </summary>
+	template <typename T, typename TSym, std::enable_if_t<(std::is_floating_point_v<T>), int> = 0>
+	void To(std::basic_string_view<TSym> in, T& out)
+	{
+		const auto ec = TryParseFloat(in, out);
+		if (ec == std::errc::result_out_of_range) {
 			throw std::out_of_range("Argument out of range");
 		}
-		if (isNaN) {
+		if (ec == std::errc::not_enough_memory) {
+			throw std::bad_alloc();
+		}
+		if (ec != std::errc()) {
 			throw std::invalid_argument("Input string is not a number");
 		}
-		out = result;
 	}
 
 	/// <summary>
@@ -179,68 +343,102 @@ namespace BitSerializer::Convert::Detail
 	//------------------------------------------------------------------------------
 
 	/// <summary>
-	/// Converts any integer types to any UTF string.
+	/// Table of all two-digit numbers ("00".."99"), used for formatting integers by two digits at a time.
 	/// </summary>
-	template <class T, typename TSym, typename TAllocator, std::enable_if_t<(std::is_integral_v<T>), int> = 0>
-	void To(const T& in, std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& out)
+	inline constexpr char DigitPairs[] = "00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
+	/// <summary>
+	/// Size of buffer which is enough for the text representation of any integer number (including sign).
+	/// </summary>
+	template <typename T>
+	static constexpr size_t IntegerCharsBufferSize = std::numeric_limits<std::make_unsigned_t<T>>::digits10 + 3;
+
+	/// <summary>
+	/// Formats the integer number to the end of buffer (`bufferEnd` points past the last character).
+	/// Returns pointer to the first character, the buffer should have at least `IntegerCharsBufferSize` characters.
+	/// </summary>
+	template <typename T, typename TSym>
+	TSym* FormatInteger(T value, TSym* bufferEnd) noexcept
 	{
-		if constexpr (std::is_same_v<char, TSym>) {
-			out.append(std::to_string(in));
+		using unsigned_type = std::make_unsigned_t<T>;
+		auto number = static_cast<unsigned_type>(value);
+		bool isNegative = false;
+		if constexpr (std::is_signed_v<T>)
+		{
+			if (value < 0)
+			{
+				isNegative = true;
+				number = static_cast<unsigned_type>(0 - number);
+			}
 		}
-		else if constexpr (std::is_same_v<TSym, wchar_t>) {
-			out.append(std::to_wstring(in));
+
+		TSym* pos = bufferEnd;
+		while (number >= 100)
+		{
+			const auto index = static_cast<size_t>(number % 100) * 2;
+			number = static_cast<unsigned_type>(number / 100);
+			*--pos = static_cast<TSym>(DigitPairs[index + 1]);
+			*--pos = static_cast<TSym>(DigitPairs[index]);
 		}
-		else
+		if (number >= 10)
 		{
-			const auto utf8Str = std::to_string(in);
-			Utf8::Decode(utf8Str.cbegin(), utf8Str.cend(), out);
+			const auto index = static_cast<size_t>(number) * 2;
+			*--pos = static_cast<TSym>(DigitPairs[index + 1]);
+			*--pos = static_cast<TSym>(DigitPairs[index]);
+		}
+		else {
+			*--pos = static_cast<TSym>('0' + number);
+		}
+
+		if (isNegative) {
+			*--pos = static_cast<TSym>('-');
 		}
+		return pos;
 	}
 
-	namespace _formatTemplates
+	/// <summary>
+	/// Converts any integer types to any UTF string.
+	/// </summary>
+	template <class T, typename TSym, typename TAllocator, std::enable_if_t<(std::is_integral_v<T>), int> = 0>
+	void To(const T& in, std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& out)
 	{
-		template <typename T> const char* _get() { throw; }
-		template <typename T> const wchar_t* _getW() { throw; }
-
-		template <>	constexpr const char* _get<float>() { return "%.6g"; }
-		template <>	constexpr const wchar_t* _getW<float>() { return L"%.6g"; }
-
-		template <>	constexpr const char* _get<double>() { return "%.15g"; }
-		template <>	constexpr const wchar_t* _getW<double>() { return L"%.15g"; }
+		TSym buf[IntegerCharsBufferSize<T>];
+		TSym* const bufEnd = buf + IntegerCharsBufferSize<T>;
+		out.append(FormatInteger(in, bufEnd), bufEnd);
+	}
 
-		template <>	constexpr const char* _get<long double>() { return "%.15Lg"; }
-		template <>	constexpr const wchar_t* _getW<long double>() { return L"%.15Lg"; }
+#if !defined(__cpp_lib_to_chars)
+	namespace _formatTemplates
+	{
+		template <typename T> constexpr const char* _get() { return "%.*g"; }
+		template <> constexpr const char* _get<long double>() { return "%.*Lg"; }
 	}
+#endif
 
 	/// <summary>
 	/// Converts any floating point types to any UTF string.
+	/// Produces the shortest representation which is converted back to the same value (via `std::to_chars()` when it is supported by the standard library).
 	/// </summary>
 	template <class T, typename TSym, typename TAllocator, std::enable_if_t<(std::is_floating_point_v<T>), int> = 0>
 	void To(const T& in, std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& out)
 	{
-		constexpr auto bufSize = std::numeric_limits<T>::digits + 1;
-		if constexpr (sizeof(TSym) == sizeof(wchar_t)) {
-			wchar_t buf[bufSize];
-			const int result = swprintf(buf, bufSize, _formatTemplates::_getW<T>(), in);
-			if (result < 0 || result >= bufSize) {
-				throw std::overflow_error("Internal error");
-			}
-			out.append(std::cbegin(buf), std::cbegin(buf) + result);
+		char buf[FloatCharsBufferSize];
+#if defined(__cpp_lib_to_chars)
+		const auto result = std::to_chars(buf, buf + FloatCharsBufferSize, in);
+		if (result.ec != std::errc()) {
+			throw std::overflow_error("Internal error");
 		}
-		else
-		{
-			char buf[bufSize];
-			const int result = snprintf(buf, bufSize, _formatTemplates::_get<T>(), in);
-			if (result < 0 || result >= bufSize) {
-				throw std::overflow_error("Internal error");
-			}
-			if constexpr (std::is_same_v<char, TSym>) {
-				out.append(std::cbegin(buf), std::cbegin(buf) + result);
-			}
-			else {
-				Utf8::Decode(buf, buf + result, out);
-			}
+		const char* endPos = result.ptr;
+#else
+		// The precision of 'max_digits10' guarantees the round-trip, but the output is not always the shortest
+		const int result = snprintf(buf, FloatCharsBufferSize, _formatTemplates::_get<T>(), std::numeric_limits<T>::max_digits10, in);
+		if (result < 0 || result >= static_cast<int>(FloatCharsBufferSize)) {
+			throw std::overflow_error("Internal error");
 		}
+		const char* endPos = buf + result;
+#endif
+		// The number contains only ASCII characters, which are the same in any UTF
+		out.append(static_cast<const char*>(buf), endPos);
 	}
 
 	/// <summary>
@@ -8,10 +8,20 @@
 #include <cassert>
 #include <istream>
 #include <iterator>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <cstring>
+#include <type_traits>
+#include <vector>
 #include "convert_enum.h"
 
+// SSE2 is used for bulk checking characters when it is available (it is the baseline for all x86-64 CPUs)
+#if !defined(BITSERIALIZER_DISABLE_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define BITSERIALIZER_HAS_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace BitSerializer::Convert
 {
 	/// <summary>
@@ -90,6 +100,248 @@ namespace BitSerializer::Convert
 			}
 			return nullptr;
 		}
+
+		template <typename TChar>
+		constexpr bool IsUtfCharType() noexcept
+		{
+			return std::is_same_v<TChar, char> || std::is_same_v<TChar, wchar_t> || std::is_same_v<TChar, char16_t> || std::is_same_v<TChar, char32_t>
+#if defined(__cpp_char8_t)
+				|| std::is_same_v<TChar, char8_t>
+#endif
+				;
+		}
+
+		/// <summary>
+		/// Checks that iterator points to the contiguous memory (pointer or iterator of string, string_view or vector).
+		/// Such ranges are transcoded by blocks of characters, other iterators are handled one by one.
+		/// </summary>
+		template <typename TIt>
+		constexpr bool IsContiguousIterator() noexcept
+		{
+			if constexpr (std::is_pointer_v<TIt>) {
+				return true;
+			}
+			else
+			{
+				using char_type = std::remove_cv_t<std::remove_reference_t<decltype(*std::declval<TIt&>())>>;
+				if constexpr (IsUtfCharType<char_type>())
+				{
+					return std::is_same_v<TIt, typename std::basic_string<char_type>::iterator>
+						|| std::is_same_v<TIt, typename std::basic_string<char_type>::const_iterator>
+						|| std::is_same_v<TIt, typename std::basic_string_view<char_type>::const_iterator>
+						|| std::is_same_v<TIt, typename std::vector<char_type>::iterator>
+						|| std::is_same_v<TIt, typename std::vector<char_type>::const_iterator>;
+				}
+				else {
+					return false;
+				}
+			}
+		}
+
+		/// <summary>
+		/// Returns pointer to the character which is referenced by contiguous iterator (should not be the end).
+		/// </summary>
+		template <typename TIt>
+		auto ToPointer(const TIt& it) noexcept
+		{
+			if constexpr (std::is_pointer_v<TIt>) {
+				return it;
+			}
+			else {
+				return &*it;
+			}
+		}
+
+		/// <summary>
+		/// Returns the number of ASCII characters at the beginning of range (checks several characters at a time).
+		/// </summary>
+		template <typename TChar>
+		size_t CountAsciiPrefix(const TChar* begin, const TChar* end) noexcept
+		{
+			const TChar* it = begin;
+			if constexpr (sizeof(TChar) == sizeof(char))
+			{
+#if defined(BITSERIALIZER_HAS_SSE2)
+				for (; end - it >= 16; it += 16)
+				{
+					const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));
+					if (_mm_movemask_epi8(chunk) != 0) {
+						break;
+					}
+				}
+#endif
+				for (; end - it >= 8; it += 8)
+				{
+					uint64_t chunk;
+					std::memcpy(&chunk, it, sizeof(chunk));
+					if ((chunk & 0x8080808080808080ull) != 0) {
+						break;
+					}
+				}
+			}
+			else if constexpr (sizeof(TChar) == sizeof(char16_t))
+			{
+#if defined(BITSERIALIZER_HAS_SSE2)
+				const __m128i nonAsciiMask = _mm_set1_epi16(static_cast<short>(0xFF80));
+				for (; end - it >= 8; it += 8)
+				{
+					const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));
+					const __m128i isAscii = _mm_cmpeq_epi16(_mm_and_si128(chunk, nonAsciiMask), _mm_setzero_si128());
+					if (_mm_movemask_epi8(isAscii) != 0xFFFF) {
+						break;
+					}
+				}
+#endif
+				for (; end - it >= 4; it += 4)
+				{
+					uint64_t chunk;
+					std::memcpy(&chunk, it, sizeof(chunk));
+					if ((chunk & 0xFF80FF80FF80FF80ull) != 0) {
+						break;
+					}
+				}
+			}
+
+			using unsigned_type = std::make_unsigned_t<TChar>;
+			// ReSharper disable once CppPossiblyErroneousEmptyStatements
+			for (; it != end && static_cast<unsigned_type>(*it) < 0x80; ++it);
+			return static_cast<size_t>(it - begin);
+		}
+
+		/// <summary>
+		/// Skips valid UTF-8 sequences and returns pointer to the first invalid one, its size is returned via `out_invalidSize`.
+		/// The size is zero when the range ends with valid or incomplete sequence (it can be continued in the next chunk of data).
+		/// </summary>
+		template <typename TChar>
+		const TChar* FindInvalidUtf8(const TChar* it, const TChar* end, size_t& out_invalidSize) noexcept
+		{
+			static_assert(sizeof(TChar) == sizeof(char), "Input range should represents sequence of 8-bit characters");
+
+			out_invalidSize = 0;
+			while (it != end)
+			{
+				const auto lead = static_cast<uint8_t>(*it);
+				if (lead < 0x80)
+				{
+					it += CountAsciiPrefix(it, end);
+					continue;
+				}
+
+				// Ranges of the second byte are limited for prohibit overlong sequences, surrogates and code points above 0x10FFFF
+				size_t tails;
+				uint8_t minSecond = 0x80, maxSecond = 0xBF;
+				if (lead >= 0xC2 && lead <= 0xDF) { tails = 1; }
+				else if (lead >= 0xE0 && lead <= 0xEF)
+				{
+					tails = 2;
+					if (lead == 0xE0) { minSecond = 0xA0; }
+					else if (lead == 0xED) { maxSecond = 0x9F; }
+				}
+				else if (lead >= 0xF0 && lead <= 0xF4)
+				{
+					tails = 3;
+					if (lead == 0xF0) { minSecond = 0x90; }
+					else if (lead == 0xF4) { maxSecond = 0x8F; }
+				}
+				else
+				{
+					out_invalidSize = 1;
+					return it;
+				}
+
+				size_t i = 1;
+				for (; i <= tails && it + i != end; ++i)
+				{
+					const auto tail = static_cast<uint8_t>(it[i]);
+					if (tail < (i == 1 ? minSecond : 0x80) || tail > (i == 1 ? maxSecond : 0xBF))
+					{
+						out_invalidSize = i;
+						return it;
+					}
+				}
+				if (i <= tails)
+				{
+					// Incomplete sequence at the end of range
+					return it;
+				}
+				it += tails + 1;
+			}
+			return it;
+		}
+
+		/// <summary>
+		/// Returns the number of characters at the beginning of range which are encoded in UTF-16 by single code unit
+		/// (not surrogates for UTF-16 input and characters below 0x10000 for UTF-32 input).
+		/// </summary>
+		template <typename TChar>
+		size_t CountSingleUnitUtf16Prefix(const TChar* begin, const TChar* end) noexcept
+		{
+			const TChar* it = begin;
+			if constexpr (sizeof(TChar) == sizeof(char16_t))
+			{
+#if defined(BITSERIALIZER_HAS_SSE2)
+				const __m128i surrogateMask = _mm_set1_epi16(static_cast<short>(0xF800));
+				const __m128i surrogateBase = _mm_set1_epi16(static_cast<short>(Unicode::HighSurrogatesStart));
+				for (; end - it >= 8; it += 8)
+				{
+					const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));
+					if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(chunk, surrogateMask), surrogateBase)) != 0) {
+						break;
+					}
+				}
+#endif
+				// ReSharper disable once CppPossiblyErroneousEmptyStatements
+				for (; it != end && (static_cast<uint16_t>(*it) & 0xF800) != Unicode::HighSurrogatesStart; ++it);
+			}
+			else
+			{
+				// ReSharper disable once CppPossiblyErroneousEmptyStatements
+				for (; it != end && static_cast<uint32_t>(*it) < 0x10000; ++it);
+			}
+			return static_cast<size_t>(it - begin);
+		}
+
+		/// <summary>
+		/// Appends code units to the string with conversion to the output character type (which can be wider or narrower).
+		/// </summary>
+		template <typename TInChar, typename TOutChar, typename TAllocator>
+		void AppendCodeUnits(std::basic_string<TOutChar, std::char_traits<TOutChar>, TAllocator>& outStr, const TInChar* in, size_t count)
+		{
+			if constexpr (sizeof(TInChar) == sizeof(TOutChar)) {
+				outStr.append(reinterpret_cast<const TOutChar*>(in), count);
+			}
+			else
+			{
+				const size_t outPos = outStr.size();
+				outStr.resize(outPos + count);
+				TOutChar* out = outStr.data() + outPos;
+				for (size_t i = 0; i < count; ++i) {
+					out[i] = static_cast<TOutChar>(in[i]);
+				}
+			}
+		}
+
+		/// <summary>
+		/// Copies UTF-16 contiguous range 'as is', except the trailing first part of surrogate pair.
+		/// Returns iterator to the last not copied character.
+		/// </summary>
+		template<typename TInIt, typename TOutChar, typename TAllocator>
+		TInIt CopyUtf16(TInIt in, const TInIt end, std::basic_string<TOutChar, std::char_traits<TOutChar>, TAllocator>& outStr)
+		{
+			if (in == end) {
+				return in;
+			}
+
+			const auto* inPtr = ToPointer(in);
+			auto count = static_cast<size_t>(std::distance(in, end));
+			const auto lastSym = static_cast<uint16_t>(inPtr[count - 1]);
+			if (lastSym >= Unicode::HighSurrogatesStart && lastSym <= Unicode::HighSurrogatesEnd) {
+				--count;
+			}
+			AppendCodeUnits(outStr, inPtr, count);
+			std::advance(in, count);
+			return in;
+		}
 	}
 
 	class Utf8
@@ -116,6 +368,20 @@ namespace BitSerializer::Convert
 			while (in != end)
 			{
 				uint32_t sym = static_cast<unsigned char>(*in);
+				if constexpr (Detail::IsContiguousIterator<TInIt>())
+				{
+					// Widen the whole block of ASCII characters
+					if (sym < 0x80)
+					{
+						const auto* inPtr = Detail::ToPointer(in);
+						const size_t count = Detail::CountAsciiPrefix(inPtr, inPtr + std::distance(in, end));
+						Detail::AppendCodeUnits(outStr, inPtr, count);
+						std::advance(in, count);
+						startTailPos = in;
+						continue;
+					}
+				}
+
 				if ((sym & 0b10000000) == 0) { tails = 1; }
 				else if ((sym & 0b11100000) == 0b11000000) { tails = 2; sym &= 0b00011111; }
 				else if ((sym & 0b11110000) == 0b11100000) { tails = 3; sym &= 0b00001111; }
@@ -213,6 +479,20 @@ namespace BitSerializer::Convert
 			while (in != end)
 			{
 				uint32_t sym = *in;
+				if constexpr (Detail::IsContiguousIterator<TInIt>())
+				{
+					// Narrow the whole block of ASCII characters
+					if (sym < 0x80)
+					{
+						const auto* inPtr = Detail::ToPointer(in);
+						const size_t count = Detail::CountAsciiPrefix(inPtr, inPtr + std::distance(in, end));
+						Detail::AppendCodeUnits(outStr, inPtr, count);
+						std::advance(in, count);
+						startTailPos = in;
+						continue;
+					}
+				}
+
 				++in;
 				if (sym < 0x80)
 				{
@@ -309,11 +589,28 @@ namespace BitSerializer::Convert
 			{
 				return Utf8::Encode(in, end, outStr, encodePolicy, errorMark);
 			}
+			else if constexpr (sizeof(TOutChar) == sizeof(char16_t) && Detail::IsContiguousIterator<TInIt>())
+			{
+				return Detail::CopyUtf16(in, end, outStr);
+			}
 			else
 			{
 				TInIt startTailPos = in;
 				while (in != end)
 				{
+					if constexpr (sizeof(TOutChar) == sizeof(char32_t) && Detail::IsContiguousIterator<TInIt>())
+					{
+						// Widen the whole block of characters which are not surrogates
+						const auto* inPtr = Detail::ToPointer(in);
+						if (const size_t count = Detail::CountSingleUnitUtf16Prefix(inPtr, inPtr + std::distance(in, end)))
+						{
+							Detail::AppendCodeUnits(outStr, inPtr, count);
+							std::advance(in, count);
+							startTailPos = in;
+							continue;
+						}
+					}
+
 					TOutChar sym = *in;
 					++in;
 
@@ -378,6 +675,10 @@ namespace BitSerializer::Convert
 			{
 				return Utf8::Decode(in, end, outStr, encodePolicy, errorMark);
 			}
+			else if constexpr (sizeof(TInCharType) == sizeof(char16_t) && Detail::IsContiguousIterator<TInIt>())
+			{
+				return Detail::CopyUtf16(in, end, outStr);
+			}
 			else if constexpr (sizeof(TInCharType) == sizeof(char16_t))
 			{
 				TInIt startTailPos = in;
@@ -397,6 +698,18 @@ namespace BitSerializer::Convert
 			{
 				while (in != end)
 				{
+					if constexpr (Detail::IsContiguousIterator<TInIt>())
+					{
+						// Narrow the whole block of characters which do not need surrogate pairs
+						const auto* inPtr = Detail::ToPointer(in);
+						if (const size_t count = Detail::CountSingleUnitUtf16Prefix(inPtr, inPtr + std::distance(in, end)))
+						{
+							Detail::AppendCodeUnits(outStr, inPtr, count);
+							std::advance(in, count);
+							continue;
+						}
+					}
+
 					uint32_t sym = *in;
 					++in;
 					if (sym < 0x10000)
@@ -457,7 +770,29 @@ namespace BitSerializer::Convert
 			static_assert(sizeof(decltype(*in)) == sizeof(char_type), "Input stream should represents sequence of 16-bit characters");
 			static_assert(sizeof(TOutChar) == sizeof(char) || sizeof(TOutChar) == sizeof(char16_t) || sizeof(TOutChar) == sizeof(char32_t), "Output string should have 8, 16 or 32-bit characters");
 
-			return Utf16Le::Decode(U16BeConstIterator<TInIt>(in), U16BeConstIterator<TInIt>(end), outStr, encodePolicy, errorMark);
+			if constexpr (sizeof(TOutChar) == sizeof(char16_t) && Detail::IsContiguousIterator<TInIt>())
+			{
+				// Copy the whole block and swap the byte order in place
+				if (in == end) {
+					return in;
+				}
+				const size_t startOutPos = outStr.size();
+				Detail::AppendCodeUnits(outStr, Detail::ToPointer(in), static_cast<size_t>(std::distance(in, end)));
+				std::for_each(outStr.begin() + startOutPos, outStr.end(), [](TOutChar& sym) {
+					sym = static_cast<TOutChar>(sym >> 8) | static_cast<TOutChar>(sym << 8);
+				});
+				// Do not copy only first part of surrogate pair
+				if (const auto lastSym = static_cast<uint16_t>(outStr.back());
+					lastSym >= Unicode::HighSurrogatesStart && lastSym <= Unicode::HighSurrogatesEnd)
+				{
+					outStr.pop_back();
+					return std::prev(end);
+				}
+				return end;
+			}
+			else {
+				return Utf16Le::Decode(U16BeConstIterator<TInIt>(in), U16BeConstIterator<TInIt>(end), outStr, encodePolicy, errorMark);
+			}
 		}
 
 		/// <summary>
@@ -498,7 +833,16 @@ namespace BitSerializer::Convert
 		{
 			static_assert(sizeof(decltype(*in)) == sizeof(char_type), "Input stream should represents sequence of 32-bit characters");
 
-			if constexpr (sizeof(TOutChar) == sizeof(char_type))
+			if constexpr (sizeof(TOutChar) == sizeof(char_type) && Detail::IsContiguousIterator<TInIt>())
+			{
+				if (in != end)
+				{
+					const auto count = static_cast<size_t>(std::distance(in, end));
+					Detail::AppendCodeUnits(outStr, Detail::ToPointer(in), count);
+					std::advance(in, count);
+				}
+			}
+			else if constexpr (sizeof(TOutChar) == sizeof(char_type))
 			{
 				for (; in != end; ++in) {
 					outStr.push_back(static_cast<TOutChar>(*in));
@@ -526,7 +870,16 @@ namespace BitSerializer::Convert
 			static_assert(sizeof(TOutChar) == sizeof(char32_t), "Output string must be 32-bit characters (e.g. std::u32string)");
 
 			using TInCharType = decltype(*in);
-			if constexpr (sizeof(TInCharType) == sizeof(char_type))
+			if constexpr (sizeof(TInCharType) == sizeof(char_type) && Detail::IsContiguousIterator<TInIt>())
+			{
+				if (in != end)
+				{
+					const auto count = static_cast<size_t>(std::distance(in, end));
+					Detail::AppendCodeUnits(outStr, Detail::ToPointer(in), count);
+					std::advance(in, count);
+				}
+			}
+			else if constexpr (sizeof(TInCharType) == sizeof(char_type))
 			{
 				for (; in != end; ++in) {
 					outStr.push_back(static_cast<TOutChar>(*in));
@@ -585,7 +938,20 @@ namespace BitSerializer::Convert
 			static_assert(sizeof(decltype(*in)) == sizeof(char_type), "Input stream should represents sequence of 32-bit characters");
 			static_assert(sizeof(TOutChar) == sizeof(char) || sizeof(TOutChar) == sizeof(char16_t) || sizeof(TOutChar) == sizeof(char32_t), "Output string should have 8, 16 or 32-bit characters");
 
-			return Utf32Le::Decode(U32BeConstIterator<TInIt>(in), U32BeConstIterator<TInIt>(end), outStr, encodePolicy, errorMark);
+			if constexpr (sizeof(TOutChar) == sizeof(char32_t) && Detail::IsContiguousIterator<TInIt>())
+			{
+				// Copy the whole block and swap the byte order in place
+				const size_t startOutPos = outStr.size();
+				in = Utf32Le::Decode(in, end, outStr, encodePolicy, errorMark);
+				std::for_each(outStr.begin() + startOutPos, outStr.end(), [](TOutChar& sym) {
+					const auto value = static_cast<uint32_t>(sym);
+					sym = static_cast<TOutChar>((value >> 24) | ((value << 8) & 0x00FF0000) | ((value >> 8) & 0x0000FF00) | (value << 24));
+				});
+				return in;
+			}
+			else {
+				return Utf32Le::Decode(U32BeConstIterator<TInIt>(in), U32BeConstIterator<TInIt>(end), outStr, encodePolicy, errorMark);
+			}
 		}
 
 		/// <summary>
@@ -777,13 +1143,15 @@ namespace BitSerializer::Convert
 
 	/// <summary>
 	/// Allows to read streams in various UTF encodings with automatic detection.
+	/// The stream is read by chunks, which size is specified by template argument (by default) or passed to the constructor.
 	/// </summary>
-	template <typename TTargetUtfType, size_t ChunkSize = 256>
+	template <typename TTargetUtfType, size_t ChunkSize = 64 * 1024>
 	class CEncodedStreamReader
 	{
 	public:
 		using utf_type = TTargetUtfType;
 		using target_char_type = typename TTargetUtfType::char_type;
+		using target_string_view_type = std::basic_string_view<target_char_type>;
 		static constexpr size_t chunk_size = ChunkSize;
 
 		CEncodedStreamReader(const CEncodedStreamReader&) = delete;
@@ -793,10 +1161,23 @@ namespace BitSerializer::Convert
 		~CEncodedStreamReader() = default;
 
 		CEncodedStreamReader(std::istream& inputStream, EncodeErrorPolicy encodeErrorPolicy = EncodeErrorPolicy::WriteErrorMark,
+			const target_char_type* errorMark = Detail::GetDefaultErrorMark<target_char_type>())
+			: CEncodedStreamReader(inputStream, ChunkSize, encodeErrorPolicy, errorMark)
+		{ }
+
+		/// <summary>
+		/// Creates the reader with chunk size which is specified at runtime (is rounded up to the multiple of 4).
+		/// </summary>
+		CEncodedStreamReader(std::istream& inputStream, size_t chunkSize, EncodeErrorPolicy encodeErrorPolicy = EncodeErrorPolicy::WriteErrorMark,
 			const target_char_type* errorMark = Detail::GetDefaultErrorMark<target_char_type>())
 			: mInputStream(inputStream)
 			, mEncodeErrorPolicy(encodeErrorPolicy)
 			, mErrorMark(errorMark)
+			, mChunkSize(chunkSize ? (chunkSize + 3) & ~static_cast<size_t>(3) : ChunkSize)
+			, mEncodedBuffer(std::make_unique<char[]>(mChunkSize))
+			, mEndBufferPtr(mEncodedBuffer.get() + mChunkSize)
+			, mStartDataPtr(mEncodedBuffer.get())
+			, mEndDataPtr(mEncodedBuffer.get())
 		{
 			static_assert((ChunkSize % 4) == 0, "Chunk size size must be a multiple of 4");
 			static_assert(std::is_same_v<TTargetUtfType, Utf8> || std::is_same_v<TTargetUtfType, Utf16Le> || std::is_same_v<TTargetUtfType, Utf32Le>, 
@@ -823,14 +1204,80 @@ namespace BitSerializer::Convert
 				return false;
 			}
 
+			return DecodeBufferedData(outStr);
+		}
+
+		/// <summary>
+		/// Reads the next block of text without copying it to the caller's string.
+		/// When the source is in the target encoding (UTF-8) and has no invalid sequences, the view points directly to the read buffer,
+		/// otherwise to the internal decoded buffer. The view is valid until the next read.
+		/// </summary>
+		bool ReadBlock(target_string_view_type& out_block)
+		{
+			if (IsEnd() || (!ReadNextEncodedChunk() && mStartDataPtr == mEndDataPtr))
+			{
+				out_block = {};
+				return false;
+			}
+
+			if constexpr (std::is_same_v<TTargetUtfType, Utf8>)
+			{
+				if (mUtfType == UtfType::Utf8)
+				{
+					size_t invalidSize;
+					const char* validEndPtr = Detail::FindInvalidUtf8<char>(mStartDataPtr, mEndDataPtr, invalidSize);
+					if (invalidSize == 0 && validEndPtr != mStartDataPtr)
+					{
+						// Incomplete sequence at the end (if any) is left in the buffer until the next chunk is read
+						out_block = target_string_view_type(mStartDataPtr, static_cast<size_t>(validEndPtr - mStartDataPtr));
+						mStartDataPtr += out_block.size();
+						return true;
+					}
+				}
+			}
+
+			mDecodedBlock.clear();
+			const bool result = DecodeBufferedData(mDecodedBlock);
+			out_block = mDecodedBlock;
+			return result;
+		}
+
+		[[nodiscard]] size_t GetChunkSize() const noexcept {
+			return mChunkSize;
+		}
+
+		[[nodiscard]] bool IsEnd() const {
+			return mStartDataPtr == mEndDataPtr && mInputStream.eof();
+		}
+
+		[[nodiscard]] UtfType GetSourceUtfType() const noexcept {
+			return mUtfType;
+		}
+
+	private:
+		template<typename TAllocator>
+		bool DecodeBufferedData(std::basic_string<target_char_type, std::char_traits<target_char_type>, TAllocator>& outStr)
+		{
 			const auto prevOutSize = outStr.size();
 			switch (mUtfType)
 			{
 			case UtfType::Utf8:
 				if constexpr (std::is_same_v<TTargetUtfType, Utf8>)
 				{
-					outStr.append(mStartDataPtr, mEndDataPtr);
-					mStartDataPtr = mEndDataPtr = mEncodedBuffer;
+					// Copy valid sequences as is, the incomplete sequence at the end is left for the next chunk
+					while (mStartDataPtr != mEndDataPtr)
+					{
+						size_t invalidSize;
+						const char* validEndPtr = Detail::FindInvalidUtf8<char>(mStartDataPtr, mEndDataPtr, invalidSize);
+						const auto validSize = static_cast<size_t>(validEndPtr - mStartDataPtr);
+						outStr.append(mStartDataPtr, validSize);
+						mStartDataPtr += validSize;
+						if (invalidSize == 0) {
+							break;
+						}
+						Detail::HandleEncodingError(outStr, mEncodeErrorPolicy, mErrorMark);
+						mStartDataPtr += invalidSize;
+					}
 				}
 				else
 				{
@@ -862,21 +1309,12 @@ namespace BitSerializer::Convert
 			if (mInputStream.eof() && mStartDataPtr != mEndDataPtr)
 			{
 				Detail::HandleEncodingError(outStr, mEncodeErrorPolicy, mErrorMark);
-				mStartDataPtr = mEndDataPtr = mEncodedBuffer;
+				mStartDataPtr = mEndDataPtr = mEncodedBuffer.get();
 			}
 
 			return prevOutSize != outStr.size();
 		}
 
-		[[nodiscard]] bool IsEnd() const {
-			return mStartDataPtr == mEndDataPtr && mInputStream.eof();
-		}
-
-		[[nodiscard]] UtfType GetSourceUtfType() const noexcept {
-			return mUtfType;
-		}
-
-	private:
 		template <typename T>
 		T* GetAlignedEndDataPtr() noexcept {
 			return reinterpret_cast<T*>(mEndDataPtr - ((mEndDataPtr - mStartDataPtr) % sizeof(T)));
@@ -884,33 +1322,36 @@ namespace BitSerializer::Convert
 
 		bool ReadNextEncodedChunk()
 		{
+			char* encodedBuffer = mEncodedBuffer.get();
 			if (mStartDataPtr == mEndBufferPtr)
 			{
-				mStartDataPtr = mEndDataPtr = mEncodedBuffer;
+				mStartDataPtr = mEndDataPtr = encodedBuffer;
 			}
-			else if (mStartDataPtr != mEncodedBuffer)
+			else if (mStartDataPtr != encodedBuffer)
 			{
 				// Squeeze buffer
-				std::memcpy(mEncodedBuffer, mStartDataPtr, mEndDataPtr - mStartDataPtr);
-				mEndDataPtr -= mStartDataPtr - mEncodedBuffer;
-				mStartDataPtr = mEncodedBuffer;
+				std::memmove(encodedBuffer, mStartDataPtr, mEndDataPtr - mStartDataPtr);
+				mEndDataPtr -= mStartDataPtr - encodedBuffer;
+				mStartDataPtr = encodedBuffer;
 			}
 
 			// Read next chunk
 			mInputStream.read(mEndDataPtr, static_cast<std::streamsize>(mEndBufferPtr - mEndDataPtr));
 			const auto lastReadSize = mInputStream.gcount();
 			mEndDataPtr += lastReadSize;
-			assert(mStartDataPtr >= mEncodedBuffer && mStartDataPtr <= mEndDataPtr);
+			assert(mStartDataPtr >= encodedBuffer && mStartDataPtr <= mEndDataPtr);
 			return lastReadSize != 0;
 		}
 
-		UtfType mUtfType;
+		UtfType mUtfType = UtfType::Utf8;
 		std::istream& mInputStream;
 		EncodeErrorPolicy mEncodeErrorPolicy;
 		const target_char_type* mErrorMark;
-		char mEncodedBuffer[ChunkSize];
-		char* const mEndBufferPtr = mEncodedBuffer + ChunkSize;
-		char* mStartDataPtr = mEncodedBuffer;
-		char* mEndDataPtr = mEncodedBuffer;
+		const size_t mChunkSize;
+		std::unique_ptr<char[]> mEncodedBuffer;
+		char* const mEndBufferPtr;
+		char* mStartDataPtr;
+		char* mEndDataPtr;
+		std::basic_string<target_char_type> mDecodedBlock;
 	};
 }
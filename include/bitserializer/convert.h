@@ -41,6 +41,26 @@ namespace BitSerializer::Convert
 		}
 	}
 
+	/// <summary>
+	/// Converts value to string and appends it to the end of output string (any UTF type), without creating temporary strings.
+	/// Useful for building strings which contain several values (e.g. numbers with separators).
+	/// </summary>
+	/// <param name="value">The input value.</param>
+	/// <param name="out">The output string.</param>
+	/// <exception cref="std::out_of_range">Thrown when overflow target value.</exception>
+	/// <exception cref="std::invalid_argument">Thrown when input value has wrong format.</exception>
+	template <typename TIn, typename TSym, typename TAllocator>
+	void AppendTo(TIn&& value, std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& out)
+	{
+		using namespace Detail;
+		if constexpr (is_convertible_to_string_view_v<TIn>) {
+			To(ToStringView(value), out);
+		}
+		else {
+			To(std::forward<TIn>(value), out);
+		}
+	}
+
 	/// <summary>
 	/// Converts value to std::string, just syntax sugar of To<std::string>() function.
 	/// </summary>
@@ -3,11 +3,13 @@
 * This file is part of BitSerializer library, licensed under the MIT license.  *
 *******************************************************************************/
 #pragma once
+#include <algorithm>
 #include <cassert>
 #include <optional>
 #include <type_traits>
 #include <utility>
 #include <variant>
+#include <vector>
 #include "bitserializer/serialization_detail/archive_base.h"
 #include "bitserializer/serialization_detail/errors_handling.h"
 
@@ -44,6 +46,8 @@ protected:
 // Forward declarations
 template <SerializeMode TMode>
 class JsonObjectScope;
+template <SerializeMode TMode>
+class JsonRootScope;
 
 /// <summary>
 /// Base class of JSON scope
@@ -53,6 +57,10 @@ class JsonScopeBase : public JsonArchiveTraits
 {
 public:
 	using key_type_view = std::basic_string_view<key_type::value_type>;
+	/// <summary>
+	/// The archive which is used for loading values from captured raw fragments.
+	/// </summary>
+	using raw_fragment_archive_type = TArchiveBase<JsonArchiveTraits, JsonRootScope<SerializeMode::Load>, JsonRootScope<SerializeMode::Save>>;
 
 	explicit JsonScopeBase(web::json::value* node, JsonScopeBase* parent = nullptr, key_type_view parentKey = {})
 		: mNode(node)
@@ -132,6 +140,31 @@ protected:
 		return true;
 	}
 
+	/// <summary>
+	/// Renders the JSON value to the raw fragment (UTF-8 without formatting).
+	/// </summary>
+	static void RenderRawFragment(const web::json::value& jsonValue, std::string& fragment)
+	{
+#ifdef _UTF16_STRINGS
+		fragment = utility::conversions::to_utf8string(jsonValue.serialize());
+#else
+		fragment = jsonValue.serialize();
+#endif
+	}
+
+	/// <summary>
+	/// Parses the raw fragment (CppRestSdk has no way for writing the encoded JSON as is, so the fragment is inserted as parsed value).
+	/// </summary>
+	static web::json::value ParseRawFragment(std::string_view fragment)
+	{
+		std::error_code error;
+		auto jsonValue = web::json::value::parse(utility::conversions::to_string_t(std::string(fragment)), error);
+		if (error) {
+			throw ParsingException("Invalid raw JSON fragment: " + error.category().message(error.value()));
+		}
+		return jsonValue;
+	}
+
 	static void HandleMismatchedTypesPolicy(MismatchedTypesPolicy mismatchedTypesPolicy)
 	{
 		if (mismatchedTypesPolicy == MismatchedTypesPolicy::ThrowError)
@@ -223,6 +256,25 @@ public:
 		}
 	}
 
+	/// <summary>
+	/// Loads the next item as raw fragment of JSON (UTF-8 without formatting).
+	/// </summary>
+	bool LoadRawFragment(std::string& fragment)
+	{
+		static_assert(TMode == SerializeMode::Load);
+		RenderRawFragment(LoadNextItem(), fragment);
+		return true;
+	}
+
+	/// <summary>
+	/// Saves the raw fragment of already encoded JSON.
+	/// </summary>
+	void SaveRawFragment(std::string_view fragment)
+	{
+		static_assert(TMode == SerializeMode::Save);
+		SaveJsonValue(ParseRawFragment(fragment));
+	}
+
 	std::optional<JsonObjectScope<TMode>> OpenObjectScope()
 	{
 		if constexpr (TMode == SerializeMode::Load)
@@ -326,6 +378,20 @@ public:
 		assert(mNode->is_object());
 	}
 
+	JsonObjectScope(JsonObjectScope&&) = default;
+	JsonObjectScope& operator=(JsonObjectScope&&) = default;
+
+	~JsonObjectScope()
+	{
+		if constexpr (TMode == SerializeMode::Save)
+		{
+			// The object is built at once when the scope is closed, as inserting fields one by one into the sorted storage has quadratic complexity
+			if (!mFields.empty()) {
+				*mNode = web::json::value::object(std::move(mFields));
+			}
+		}
+	}
+
 	[[nodiscard]] key_const_iterator cbegin() const {
 		return key_const_iterator(mNode->as_object().cbegin());
 	}
@@ -376,6 +442,29 @@ public:
 		}
 	}
 
+	/// <summary>
+	/// Loads the value with the specified key as raw fragment of JSON (UTF-8 without formatting).
+	/// </summary>
+	bool LoadRawFragment(const key_type& key, std::string& fragment)
+	{
+		static_assert(TMode == SerializeMode::Load);
+		auto* jsonValue = LoadJsonValue(key);
+		if (jsonValue == nullptr) {
+			return false;
+		}
+		RenderRawFragment(*jsonValue, fragment);
+		return true;
+	}
+
+	/// <summary>
+	/// Saves the raw fragment of already encoded JSON with the specified key.
+	/// </summary>
+	void SaveRawFragment(const key_type& key, std::string_view fragment)
+	{
+		static_assert(TMode == SerializeMode::Save);
+		SaveJsonValue(key, ParseRawFragment(fragment));
+	}
+
 	std::optional<JsonObjectScope<TMode>> OpenObjectScope(const key_type& key)
 	{
 		if constexpr (TMode == SerializeMode::Load)
@@ -414,18 +503,23 @@ public:
 protected:
 	web::json::value* LoadJsonValue(const key_type& key) const
 	{
+		// Uses binary search (fields of JSON object are kept sorted by CppRestSdk)
 		auto& jObject = mNode->as_object();
-		auto it = std::find_if(jObject.begin(), jObject.end(), [&key](const auto& p) { return p.first == key; });
+		auto it = jObject.find(key);
 		return it == jObject.end() ? nullptr : &it->second;
 	}
 
-	web::json::value& SaveJsonValue(const key_type& key, web::json::value&& jsonValue) const
+	web::json::value& SaveJsonValue(const key_type& key, web::json::value&& jsonValue)
 	{
 		// Checks that object was not saved previously under the same key
-		assert(mNode->as_object().find(key) == mNode->as_object().end());
+		assert(std::none_of(mFields.cbegin(), mFields.cend(), [&key](const auto& field) { return field.first == key; }));
 
-		return (*mNode)[key] = std::move(jsonValue);
+		// The reference stays valid until the next field is added (nested scopes are closed before that)
+		return mFields.emplace_back(key, std::move(jsonValue)).second;
 	}
+
+private:
+	std::vector<std::pair<utility::string_t, web::json::value>> mFields;
 };
 
 /// <summary>
@@ -524,6 +618,25 @@ public:
 		}
 	}
 
+	/// <summary>
+	/// Loads the root value as raw fragment of JSON (UTF-8 without formatting).
+	/// </summary>
+	bool LoadRawFragment(std::string& fragment)
+	{
+		static_assert(TMode == SerializeMode::Load);
+		RenderRawFragment(mRootJson, fragment);
+		return true;
+	}
+
+	/// <summary>
+	/// Saves the raw fragment of already encoded JSON as root value.
+	/// </summary>
+	void SaveRawFragment(std::string_view fragment)
+	{
+		static_assert(TMode == SerializeMode::Save);
+		mRootJson = ParseRawFragment(fragment);
+	}
+
 	std::optional<JsonObjectScope<TMode>> OpenObjectScope()
 	{
 		if constexpr (TMode == SerializeMode::Load)	{
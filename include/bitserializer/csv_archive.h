@@ -31,6 +31,17 @@ protected:
 	~CsvArchiveTraits() = default;
 };
 
+/// <summary>
+/// Rows which were written independently from the main output (used for parallel saving).
+/// </summary>
+struct CsvRowsFragment
+{
+	std::string header;
+	std::string rows;
+	size_t rowsCount = 0;
+	size_t valuesCount = 0;
+};
+
 class ICsvWriter
 {
 public:
@@ -39,6 +50,7 @@ public:
 	virtual void SetEstimatedSize(size_t size) = 0;
 	virtual void WriteValue(const std::string_view& key, const std::string& value) = 0;
 	virtual void NextLine() = 0;
+	virtual void WriteFragment(const CsvRowsFragment& fragment) = 0;
 	[[nodiscard]] virtual size_t GetCurrentIndex() const noexcept = 0;
 };
 
@@ -83,7 +95,7 @@ public:
 	template <typename TKey, typename T, std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
 	bool SerializeValue(TKey&& key, T& value)
 	{
-		mCsvWriter->WriteValue(std::forward<TKey>(key), Convert::ToString(value));
+		mCsvWriter->WriteValue(BitSerializer::Detail::GetKeyView(key), Convert::ToString(value));
 		return true;
 	}
 
@@ -92,11 +104,11 @@ public:
 	{
 		if constexpr (std::is_same_v<TSym, char>)
 		{
-			mCsvWriter->WriteValue(std::forward<TKey>(key), value);
+			mCsvWriter->WriteValue(BitSerializer::Detail::GetKeyView(key), value);
 		}
 		else
 		{
-			mCsvWriter->WriteValue(std::forward<TKey>(key), Convert::ToString(value));
+			mCsvWriter->WriteValue(BitSerializer::Detail::GetKeyView(key), Convert::ToString(value));
 		}
 		return true;
 	}
@@ -104,7 +116,7 @@ public:
 	template <typename TKey>
 	bool SerializeValue(TKey&& key, std::nullptr_t&)
 	{
-		mCsvWriter->WriteValue(std::forward<TKey>(key), "");
+		mCsvWriter->WriteValue(BitSerializer::Detail::GetKeyView(key), "");
 		return true;
 	}
 
@@ -136,8 +148,35 @@ public:
 		return std::make_optional<CCsvWriteObjectScope>(mCsvWriter, GetContext());
 	}
 
+	/// <summary>
+	/// Returns `true` when rows can be written via shards (used for parallel saving).
+	/// </summary>
+	[[nodiscard]] bool CanCreateShards() const noexcept
+	{
+		return !mShardWriter && mCsvWriter->GetCurrentIndex() == 0;
+	}
+
+	/// <summary>
+	/// Creates an independent scope which writes rows to its own fragment (used for parallel saving).
+	/// </summary>
+	[[nodiscard]] CsvWriteArrayScope CreateShard(SerializationContext& serializationContext, size_t itemsNum) const;
+
+	/// <summary>
+	/// Returns rows which were written to the shard.
+	/// </summary>
+	[[nodiscard]] CsvRowsFragment FinalizeShard();
+
+	/// <summary>
+	/// Appends rows which were written to the shard.
+	/// </summary>
+	void MergeShard(CsvRowsFragment&& fragment)
+	{
+		mCsvWriter->WriteFragment(fragment);
+	}
+
 private:
 	ICsvWriter* mCsvWriter;
+	std::unique_ptr<ICsvWriter> mShardWriter;
 };
 
 
@@ -198,10 +237,19 @@ public:
 		return mCsvReader->GetHeaders().size();
 	}
 
+	/// <summary>
+	/// Loads the value with the specified key as view of the internal buffer, it is valid until reading the next value.
+	/// </summary>
+	template <typename TKey>
+	bool LoadStringView(TKey&& key, std::string_view& value)
+	{
+		return mCsvReader->ReadValue(BitSerializer::Detail::GetKeyView(key), value);
+	}
+
 	template <typename TKey, typename TSym, typename TStrAllocator>
 	bool SerializeValue(TKey&& key, std::basic_string<TSym, std::char_traits<TSym>, TStrAllocator>& value)
 	{
-		if (std::string_view strValue; mCsvReader->ReadValue(key, strValue))
+		if (std::string_view strValue; mCsvReader->ReadValue(BitSerializer::Detail::GetKeyView(key), strValue))
 		{
 			if constexpr (std::is_same_v<TSym, char>)
 			{
@@ -223,7 +271,7 @@ public:
 	template <typename TKey, typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
 	bool SerializeValue(TKey&& key, T& value)
 	{
-		if (std::string_view strValue; mCsvReader->ReadValue(key, strValue))
+		if (std::string_view strValue; mCsvReader->ReadValue(BitSerializer::Detail::GetKeyView(key), strValue))
 		{
 			if (strValue.empty())
 			{
@@ -241,7 +289,7 @@ public:
 				if (GetOptions().overflowNumberPolicy == OverflowNumberPolicy::ThrowError)
 				{
 					throw SerializationException(SerializationErrorCode::Overflow,
-						std::string("The size of target field '") + key + "' is not sufficient to deserialize number: " + std::string(strValue) +
+						std::string("The size of target field '") + std::string(BitSerializer::Detail::GetKeyView(key)) + "' is not sufficient to deserialize number: " + std::string(strValue) +
 						", line: " + Convert::ToString(mCsvReader->GetCurrentIndex()));
 				}
 			}
@@ -250,7 +298,7 @@ public:
 				if (GetOptions().mismatchedTypesPolicy == MismatchedTypesPolicy::ThrowError)
 				{
 					throw SerializationException(SerializationErrorCode::MismatchedTypes,
-						std::string("The type of target field '") + key + "' does not match the value being loaded: " + std::string(strValue) +
+						std::string("The type of target field '") + std::string(BitSerializer::Detail::GetKeyView(key)) + "' does not match the value being loaded: " + std::string(strValue) +
 						", line: " + Convert::ToString(mCsvReader->GetCurrentIndex()));
 				}
 			}
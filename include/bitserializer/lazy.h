@@ -0,0 +1,268 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "bit_serializer.h"
+
+namespace BitSerializer
+{
+	/// <summary>
+	/// Wrapper for the value which is loaded on demand.
+	/// When the archive supports raw fragments (e.g. RapidJSON), loading captures the encoded subtree instead of deserializing it,
+	/// the value is loaded on the first access (thread-safe, at most once). The captured fragment is written back as is on save,
+	/// unless the value was accessed for modification. Other archives load and save the value as usual.
+	/// </summary>
+	/// <example><code>
+	/// struct TEnvelope {
+	///     std::string route;
+	///     Lazy&lt;TPayload&gt; payload;  // Forwarded without deserializing, when is not accessed
+	/// };
+	/// </code></example>
+	template <typename T>
+	class Lazy
+	{
+	public:
+		using value_type = T;
+
+		Lazy() = default;
+
+		Lazy(T value)
+			: mValue(std::move(value))
+		{ }
+
+		Lazy(const Lazy& rhs)
+		{
+			CopyFrom(rhs);
+		}
+
+		Lazy(Lazy&& rhs) noexcept(std::is_nothrow_move_constructible_v<T>)
+			: mFragment(std::move(rhs.mFragment))
+			, mValue(std::move(rhs.mValue))
+			, mIsPending(rhs.mIsPending.load(std::memory_order_relaxed))
+		{
+			rhs.mIsPending.store(false, std::memory_order_relaxed);
+		}
+
+		Lazy& operator=(const Lazy& rhs)
+		{
+			if (this != &rhs) {
+				CopyFrom(rhs);
+			}
+			return *this;
+		}
+
+		Lazy& operator=(Lazy&& rhs) noexcept(std::is_nothrow_move_assignable_v<T>)
+		{
+			if (this != &rhs)
+			{
+				mFragment = std::move(rhs.mFragment);
+				mValue = std::move(rhs.mValue);
+				mIsPending.store(rhs.mIsPending.load(std::memory_order_relaxed), std::memory_order_relaxed);
+				rhs.mIsPending.store(false, std::memory_order_relaxed);
+			}
+			return *this;
+		}
+
+		Lazy& operator=(T value)
+		{
+			mFragment.reset();
+			mValue = std::move(value);
+			mIsPending.store(false, std::memory_order_relaxed);
+			return *this;
+		}
+
+		/// <summary>
+		/// Returns the value, it is loaded from the captured fragment on the first access (thread-safe, at most once).
+		/// </summary>
+		[[nodiscard]] const T& Get() const
+		{
+			Materialize();
+			return mValue;
+		}
+
+		/// <summary>
+		/// Returns the value for modification, the captured fragment is discarded (the value will be serialized on save).
+		/// </summary>
+		[[nodiscard]] T& Get()
+		{
+			Materialize();
+			mFragment.reset();
+			return mValue;
+		}
+
+		const T& operator*() const	{ return Get(); }
+		T& operator*()				{ return Get(); }
+		const T* operator->() const	{ return &Get(); }
+		T* operator->()				{ return &Get(); }
+
+		/// <summary>
+		/// Returns `false` when the value is still not loaded from the captured fragment.
+		/// </summary>
+		[[nodiscard]] bool IsLoaded() const noexcept
+		{
+			return !mIsPending.load(std::memory_order_acquire);
+		}
+
+		/// <summary>
+		/// Returns `true` when the value holds the raw fragment which was captured on load (and was not accessed for modification).
+		/// </summary>
+		[[nodiscard]] bool HasFragment() const noexcept
+		{
+			return mFragment != nullptr;
+		}
+
+		/// <summary>
+		/// Returns the captured raw fragment (UTF-8 encoded), should be called only when `HasFragment()` returns `true`.
+		/// </summary>
+		[[nodiscard]] const std::string& GetFragment() const noexcept
+		{
+			assert(mFragment);
+			return mFragment->text;
+		}
+
+		template <class TArchive, typename TKey, class TValue>
+		friend bool Serialize(TArchive& archive, TKey&& key, Lazy<TValue>& value);
+
+		template <class TArchive, class TValue>
+		friend bool Serialize(TArchive& archive, Lazy<TValue>& value);
+
+	private:
+		using loader_type = void (*)(const std::string&, T&, const SerializationOptions&);
+
+		struct Fragment
+		{
+			Fragment(std::string text, ArchiveType archiveType, loader_type loader, const SerializationOptions& options)
+				: text(std::move(text))
+				, archiveType(archiveType)
+				, loader(loader)
+				, options(options)
+			{ }
+
+			std::string text;
+			ArchiveType archiveType;
+			loader_type loader;
+			SerializationOptions options;
+			std::once_flag loadFlag;
+		};
+
+		template <typename TArchive>
+		static void LoadFragment(const std::string& text, T& value, const SerializationOptions& options)
+		{
+			BitSerializer::LoadObject<TArchive>(value, text, options);
+		}
+
+		template <typename TArchive>
+		void CaptureFragment(TArchive& archive, std::string&& text)
+		{
+			mFragment = std::make_unique<Fragment>(std::move(text), TArchive::archive_type,
+				&LoadFragment<typename TArchive::raw_fragment_archive_type>, archive.GetOptions());
+			mIsPending.store(true, std::memory_order_release);
+		}
+
+		[[nodiscard]] bool CanSaveFragment(ArchiveType archiveType) const noexcept
+		{
+			return mFragment != nullptr && mFragment->archiveType == archiveType;
+		}
+
+		void Materialize() const
+		{
+			if (mIsPending.load(std::memory_order_acquire))
+			{
+				std::call_once(mFragment->loadFlag, [this]()
+				{
+					// The value is reset for the case of retry after the failed loading
+					mValue = T();
+					mFragment->loader(mFragment->text, mValue, mFragment->options);
+					mIsPending.store(false, std::memory_order_release);
+				});
+			}
+		}
+
+		void CopyFrom(const Lazy& rhs)
+		{
+			// The value of not loaded yet source is not touched, as it can be loading in another thread
+			const bool isPending = rhs.mIsPending.load(std::memory_order_acquire);
+			mFragment = rhs.mFragment
+				? std::make_unique<Fragment>(rhs.mFragment->text, rhs.mFragment->archiveType, rhs.mFragment->loader, rhs.mFragment->options)
+				: nullptr;
+			mValue = isPending ? T() : rhs.mValue;
+			mIsPending.store(isPending, std::memory_order_relaxed);
+		}
+
+		std::unique_ptr<Fragment> mFragment;
+		mutable T mValue{};
+		mutable std::atomic<bool> mIsPending = false;
+	};
+
+	/// <summary>
+	/// Serializes Lazy value with key.
+	/// </summary>
+	template <class TArchive, typename TKey, class TValue>
+	bool Serialize(TArchive& archive, TKey&& key, Lazy<TValue>& value)
+	{
+		if constexpr (can_serialize_raw_fragment_with_key_v<TArchive, TKey>)
+		{
+			if constexpr (TArchive::IsLoading())
+			{
+				std::string fragment;
+				if (!archive.LoadRawFragment(std::forward<TKey>(key), fragment)) {
+					return false;
+				}
+				value.CaptureFragment(archive, std::move(fragment));
+				return true;
+			}
+			else if (value.CanSaveFragment(TArchive::archive_type))
+			{
+				archive.SaveRawFragment(std::forward<TKey>(key), value.mFragment->text);
+				return true;
+			}
+		}
+
+		if constexpr (TArchive::IsLoading()) {
+			value = TValue();
+		}
+		else {
+			value.Materialize();
+		}
+		return Serialize(archive, std::forward<TKey>(key), value.mValue);
+	}
+
+	/// <summary>
+	/// Serializes Lazy value without key.
+	/// </summary>
+	template <class TArchive, class TValue>
+	bool Serialize(TArchive& archive, Lazy<TValue>& value)
+	{
+		if constexpr (can_serialize_raw_fragment_v<TArchive>)
+		{
+			if constexpr (TArchive::IsLoading())
+			{
+				std::string fragment;
+				if (!archive.LoadRawFragment(fragment)) {
+					return false;
+				}
+				value.CaptureFragment(archive, std::move(fragment));
+				return true;
+			}
+			else if (value.CanSaveFragment(TArchive::archive_type))
+			{
+				archive.SaveRawFragment(value.mFragment->text);
+				return true;
+			}
+		}
+
+		if constexpr (TArchive::IsLoading()) {
+			value = TValue();
+		}
+		else {
+			value.Materialize();
+		}
+		return Serialize(archive, value.mValue);
+	}
+}
@@ -6,10 +6,13 @@
 #include <cassert>
 #include <optional>
 #include <sstream>
+#include <string_view>
 #include <type_traits>
 #include <variant>
 #include "bitserializer/serialization_detail/archive_base.h"
 #include "bitserializer/serialization_detail/errors_handling.h"
+#include "bitserializer/xml_detail/xml_pull_reader.h"
+#include "bitserializer/xml_detail/xml_stream_writer.h"
 
 // External dependency (PugiXml)
 #include "pugixml.hpp"
@@ -50,12 +53,33 @@ namespace PugiXmlExtensions
 		return node.append_child(key);
 	}
 
-	inline pugi::xml_node GetChild(pugi::xml_node& node, const PugiXmlArchiveTraits::key_type& key) {
-		return node.child(key.c_str());
+	/// <summary>
+	/// Compares the name of node with the key, the length of key is known, so it is not scanned by strlen().
+	/// </summary>
+	inline bool IsEqualName(const pugi::char_t* name, std::basic_string_view<pugi::char_t> key) noexcept
+	{
+		for (const auto ch : key)
+		{
+			// The terminating null of shorter name does not match to any symbol of the key
+			if (*name != ch)
+				return false;
+			++name;
+		}
+		return *name == 0;
 	}
 
-	inline pugi::xml_node GetChild(pugi::xml_node& node, const pugi::char_t* key) {
-		return node.child(key);
+	/// <summary>
+	/// Finds the child node by name, unlike pugi::xml_node::child() the key may be not null-terminated.
+	/// </summary>
+	inline pugi::xml_node FindChild(const pugi::xml_node& node, std::basic_string_view<pugi::char_t> key) noexcept
+	{
+		for (auto child = node.first_child(); child; child = child.next_sibling())
+		{
+			if (IsEqualName(child.name(), key)) {
+				return child;
+			}
+		}
+		return {};
 	}
 
 	inline pugi::xml_attribute AppendAttribute(pugi::xml_node& node, const PugiXmlArchiveTraits::key_type& key) {
@@ -77,17 +101,47 @@ namespace PugiXmlExtensions
 	template <typename T>
 	bool LoadValue(const pugi::xml_node& node, T& value, const SerializationOptions& serializationOptions)
 	{
-		try
+		// Empty node is treated as Null
+		const auto strValue = node.text().as_string(nullptr);
+		if (!strValue) {
+			return false;
+		}
+
+		bool isOverflow;
+		if constexpr ((std::is_integral_v<T> && !std::is_same_v<T, bool>) || std::is_floating_point_v<T>)
+		{
+			// Parses a number directly from the text of node (without intermediate conversions and exceptions)
+			const std::basic_string_view<pugi::char_t> strView(strValue);
+			std::errc ec;
+			if constexpr (std::is_floating_point_v<T>) {
+				ec = Convert::Detail::TryParseFloat(strView, value);
+			}
+			else {
+				ec = Convert::Detail::TryParseInteger(strView, value);
+			}
+			if (ec == std::errc()) {
+				return true;
+			}
+			isOverflow = ec == std::errc::result_out_of_range;
+		}
+		else
 		{
-			// Empty node is treated as Null
-			if (const auto strValue = node.text().as_string(nullptr))
+			try
 			{
 				value = Convert::To<T>(strValue);
 				return true;
 			}
-			return false;
+			catch (const std::out_of_range&)
+			{
+				isOverflow = true;
+			}
+			catch (...)
+			{
+				isOverflow = false;
+			}
 		}
-		catch (const std::out_of_range&)
+
+		if (isOverflow)
 		{
 			if (serializationOptions.overflowNumberPolicy == OverflowNumberPolicy::ThrowError)
 			{
@@ -95,13 +149,10 @@ namespace PugiXmlExtensions
 					std::string("The size of target field is not sufficient to deserialize number: ") + node.text().as_string());
 			}
 		}
-		catch (...)
+		else if (serializationOptions.mismatchedTypesPolicy == MismatchedTypesPolicy::ThrowError)
 		{
-			if (serializationOptions.mismatchedTypesPolicy == MismatchedTypesPolicy::ThrowError)
-			{
-				throw SerializationException(SerializationErrorCode::MismatchedTypes,
-					std::string("The type of target field does not match the value being loaded: ") + node.text().as_string());
-			}
+			throw SerializationException(SerializationErrorCode::MismatchedTypes,
+				std::string("The type of target field does not match the value being loaded: ") + node.text().as_string());
 		}
 		return false;
 	}
@@ -188,6 +239,17 @@ public:
 		return std::distance(mNode.begin(), mNode.end());
 	}
 
+	/// <summary>
+	/// Creates an independent scope for loading items starting from the specified index (used for parallel loading).
+	/// </summary>
+	[[nodiscard]] PugiXmlArrayScope CreateShard(size_t startIndex, SerializationContext& serializationContext) const
+	{
+		static_assert(TMode == SerializeMode::Load);
+		PugiXmlArrayScope shardScope(mNode, serializationContext);
+		std::advance(shardScope.mValueIt, startIndex);
+		return shardScope;
+	}
+
 	/// <summary>
 	/// Returns `true` when all no more values to load.
 	/// </summary>
@@ -415,6 +477,7 @@ public:
 	explicit PugiXmlObjectScope(const pugi::xml_node& node, SerializationContext& serializationContext)
 		: TArchiveScope<TMode>(serializationContext)
 		, mNode(node)
+		, mNextChild(node.first_child())
 	{
 		assert(mNode.type() == pugi::node_element);
 	}
@@ -446,7 +509,7 @@ public:
 	{
 		if constexpr (TMode == SerializeMode::Load)
 		{
-			auto child = PugiXmlExtensions::GetChild(mNode, std::forward<TKey>(key));
+			auto child = FindChild(key);
 			if (child.empty())
 				return false;
 			return PugiXmlExtensions::LoadValue(child, value, this->GetOptions());
@@ -466,7 +529,7 @@ public:
 	{
 		if constexpr (TMode == SerializeMode::Load)
 		{
-			auto child = PugiXmlExtensions::GetChild(mNode, std::forward<TKey>(key));
+			auto child = FindChild(key);
 			return child.first_child().type() == pugi::node_element ? std::make_optional<PugiXmlObjectScope<TMode>>(child, TArchiveScope<TMode>::GetContext()) : std::nullopt;
 		}
 		else
@@ -481,7 +544,7 @@ public:
 	{
 		if constexpr (TMode == SerializeMode::Load)
 		{
-			auto node = PugiXmlExtensions::GetChild(mNode, std::forward<TKey>(key));
+			auto node = FindChild(key);
 			return node.first_child().type() == pugi::node_element ? std::make_optional<PugiXmlArrayScope<TMode>>(node, TArchiveScope<TMode>::GetContext()) : std::nullopt;
 		}
 		else
@@ -497,7 +560,24 @@ public:
 	}
 
 protected:
+	/// <summary>
+	/// Finds the child node by key. As fields are usually loaded in the same order as they were saved,
+	/// the sibling of previously found node is checked first, before searching from the beginning.
+	/// </summary>
+	template <typename TKey>
+	pugi::xml_node FindChild(const TKey& key)
+	{
+		static_assert(TMode == SerializeMode::Load);
+		const auto keyView = BitSerializer::Detail::GetKeyView(key);
+		auto child = PugiXmlExtensions::IsEqualName(mNextChild.name(), keyView) ? mNextChild : PugiXmlExtensions::FindChild(mNode, keyView);
+		if (!child.empty()) {
+			mNextChild = child.next_sibling();
+		}
+		return child;
+	}
+
 	pugi::xml_node mNode;
+	pugi::xml_node mNextChild;
 };
 
 
@@ -513,7 +593,7 @@ public:
 		, mOutput(nullptr)
 	{
 		static_assert(TMode == SerializeMode::Load, "BitSerializer. This data type can be used only in 'Load' mode.");
-		const auto result = mRootXml.load_buffer(inputStr.data(), inputStr.size(), pugi::parse_default, pugi::encoding_auto);
+		const auto result = mRootXml.load_buffer(inputStr.data(), inputStr.size(), ToPugiParseOptions(serializationContext.GetOptions().parseProfile), pugi::encoding_auto);
 		if (!result)
 			throw ParsingException(result.description(), 0, result.offset);
 	}
@@ -530,7 +610,7 @@ public:
 		, mOutput(nullptr)
 	{
 		static_assert(TMode == SerializeMode::Load, "BitSerializer. This data type can be used only in 'Load' mode.");
-		const auto result = mRootXml.load(inputStream);
+		const auto result = mRootXml.load(inputStream, ToPugiParseOptions(serializationContext.GetOptions().parseProfile));
 		if (!result)
 			throw ParsingException(result.description(), 0, result.offset);
 	}
@@ -553,7 +633,7 @@ public:
 	{
 		if constexpr (TMode == SerializeMode::Load)
 		{
-			auto childNode = mRootXml.first_child();
+			auto childNode = mRootXml.document_element();
 			return childNode.type() == pugi::node_element ? std::make_optional<PugiXmlArrayScope<TMode>>(childNode, TArchiveScope<TMode>::GetContext()) : std::nullopt;
 		}
 		else
@@ -568,7 +648,7 @@ public:
 	{
 		if constexpr (TMode == SerializeMode::Load)
 		{
-			auto node = PugiXmlExtensions::GetChild(mRootXml, std::forward<TKey>(key));
+			auto node = PugiXmlExtensions::FindChild(mRootXml, BitSerializer::Detail::GetKeyView(key));
 			return node.type() == pugi::node_element ? std::make_optional<PugiXmlArrayScope<TMode>>(node, TArchiveScope<TMode>::GetContext()) : std::nullopt;
 		}
 		else
@@ -582,7 +662,7 @@ public:
 	{
 		if constexpr (TMode == SerializeMode::Load)
 		{
-			auto node = mRootXml.first_child();
+			auto node = mRootXml.document_element();
 			return node.type() == pugi::node_element ? std::make_optional<PugiXmlObjectScope<TMode>>(node, TArchiveScope<TMode>::GetContext()) : std::nullopt;
 		}
 		else
@@ -596,7 +676,7 @@ public:
 	std::optional<PugiXmlObjectScope<TMode>> OpenObjectScope(TKey&& key)
 	{
 		if constexpr (TMode == SerializeMode::Load) {
-			auto child = PugiXmlExtensions::GetChild(mRootXml, std::forward<TKey>(key));
+			auto child = PugiXmlExtensions::FindChild(mRootXml, BitSerializer::Detail::GetKeyView(key));
 			return child.type() == pugi::node_element ? std::make_optional<PugiXmlObjectScope<TMode>>(child, TArchiveScope<TMode>::GetContext()) : std::nullopt;
 		}
 		else
@@ -638,6 +718,20 @@ public:
 	}
 
 private:
+	static unsigned int ToPugiParseOptions(const ParseProfile parseProfile)
+	{
+		switch (parseProfile)
+		{
+		case ParseProfile::Minimal:
+			// Documents which were saved by this archive don't contain anything except elements, attributes and escaped characters
+			return pugi::parse_minimal | pugi::parse_escapes;
+		case ParseProfile::Strict:
+			return pugi::parse_default | pugi::parse_declaration | pugi::parse_doctype;
+		default:
+			return pugi::parse_default;
+		}
+	}
+
 	static pugi::xml_encoding ToPugiUtfType(const Convert::UtfType utfType)
 	{
 		switch (utfType)
@@ -683,4 +777,21 @@ using XmlArchive = TArchiveBase<
 	Detail::PugiXmlRootScope<SerializeMode::Load>,
 	Detail::PugiXmlRootScope<SerializeMode::Save>>;
 
+/// <summary>
+/// XML archive which works without building the document in memory: saves directly to the output string or stream
+/// and loads by the built-in pull parser, which reads the input element by element (large root arrays are loaded with constant memory).
+/// Supports load/save from:
+/// - <c>std::string</c>: UTF-8
+/// - <c>std::istream</c> and <c>std::ostream</c>: UTF-8, UTF-16LE, UTF-16BE, UTF-32LE, UTF-32BE
+/// </summary>
+/// <remarks>
+/// Keys are UTF-8 strings regardless of 'PUGIXML_WCHAR_MODE', the pull parser does not depend on the PugiXml.
+/// Attributes of each element must be serialized before its child elements.
+/// Elements are expected in the same order as they are serialized, otherwise skipped elements are buffered until they are requested.
+/// </remarks>
+using XmlStreamingArchive = TArchiveBase<
+	Xml::Detail::XmlStreamingArchiveTraits,
+	Xml::Detail::XmlPullRootScope,
+	Xml::Detail::XmlWriteRootScope>;
+
 }
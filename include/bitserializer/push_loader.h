@@ -0,0 +1,337 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "bit_serializer.h"
+
+namespace BitSerializer
+{
+	namespace Detail
+	{
+		/// <summary>
+		/// Splits the root JSON array into items, which are fed by chunks (incomplete item is carried over to the next chunk).
+		/// </summary>
+		class JsonArrayItemsSplitter
+		{
+		public:
+			/// <summary>
+			/// Appends the chunk and calls `onItem(std::string_view)` for each completed item of the root array.
+			/// </summary>
+			template <typename TCallback>
+			void Feed(std::string_view chunk, TCallback&& onItem)
+			{
+				mBuffer.append(chunk);
+				size_t pos = mScanPos;
+				for (; pos < mBuffer.size(); ++pos)
+				{
+					const char ch = mBuffer[pos];
+					switch (mState)
+					{
+					case State::BeforeArray:
+						if (ch == '[') {
+							mState = State::BeforeFirstItem;
+						}
+						else if (!IsWhitespace(ch) && !IsBomByte(ch, mBufferOffset + pos)) {
+							throw ParsingException("Expected the root array in JSON", 0, mBufferOffset + pos);
+						}
+						break;
+
+					case State::BeforeFirstItem:
+					case State::BeforeItem:
+						if (IsWhitespace(ch)) {
+							break;
+						}
+						if (ch == ']' && mState == State::BeforeFirstItem) {
+							mState = State::AfterArray;
+							break;
+						}
+						if (ch == ',' || ch == ']' || ch == '}') {
+							throw ParsingException(std::string("Unexpected symbol '") + ch + "' in the root array", 0, mBufferOffset + pos);
+						}
+						mItemStart = pos;
+						mState = State::InItem;
+						--pos;	// The first symbol of item is processed in the next iteration
+						break;
+
+					case State::InItem:
+						if (ScanItemSymbol(ch, pos))
+						{
+							onItem(TrimRight(std::string_view(mBuffer.data() + mItemStart, pos - mItemStart)));
+							mState = ch == ',' ? State::BeforeItem : State::AfterArray;
+						}
+						break;
+
+					case State::AfterArray:
+						if (!IsWhitespace(ch)) {
+							throw ParsingException("Unexpected data after the root array", 0, mBufferOffset + pos);
+						}
+						break;
+					}
+				}
+
+				// Remove processed data, except the beginning of incomplete item
+				const size_t consumedSize = mState == State::InItem ? mItemStart : pos;
+				mBuffer.erase(0, consumedSize);
+				mBufferOffset += consumedSize;
+				mItemStart = 0;
+				mScanPos = pos - consumedSize;
+			}
+
+			/// <summary>
+			/// Checks that the root array was completed.
+			/// </summary>
+			void Finish() const
+			{
+				if (mState != State::AfterArray) {
+					throw ParsingException("Unexpected end of JSON, the root array is not completed", 0, mBufferOffset + mBuffer.size());
+				}
+			}
+
+		private:
+			enum class State
+			{
+				BeforeArray,
+				BeforeFirstItem,
+				BeforeItem,
+				InItem,
+				AfterArray
+			};
+
+			/// <summary>
+			/// Processes the symbol of item, returns `true` when it is a separator after the item.
+			/// </summary>
+			bool ScanItemSymbol(char ch, size_t pos)
+			{
+				if (mIsInString)
+				{
+					if (mIsEscaped) {
+						mIsEscaped = false;
+					}
+					else if (ch == '\\') {
+						mIsEscaped = true;
+					}
+					else if (ch == '"') {
+						mIsInString = false;
+					}
+					return false;
+				}
+
+				switch (ch)
+				{
+				case '"':
+					mIsInString = true;
+					return false;
+				case '{':
+				case '[':
+					++mDepth;
+					return false;
+				case '}':
+				case ']':
+					if (mDepth == 0)
+					{
+						if (ch == '}') {
+							throw ParsingException("Unexpected symbol '}' in the root array", 0, mBufferOffset + pos);
+						}
+						return true;
+					}
+					--mDepth;
+					return false;
+				case ',':
+					return mDepth == 0;
+				default:
+					return false;
+				}
+			}
+
+			static bool IsWhitespace(char ch) noexcept {
+				return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+			}
+
+			static bool IsBomByte(char ch, size_t offset) noexcept
+			{
+				return offset < sizeof Convert::Utf8::bom && ch == Convert::Utf8::bom[offset];
+			}
+
+			static std::string_view TrimRight(std::string_view str) noexcept
+			{
+				while (!str.empty() && IsWhitespace(str.back())) {
+					str.remove_suffix(1);
+				}
+				return str;
+			}
+
+			std::string mBuffer;
+			size_t mBufferOffset = 0;
+			size_t mScanPos = 0;
+			size_t mItemStart = 0;
+			size_t mDepth = 0;
+			State mState = State::BeforeArray;
+			bool mIsInString = false;
+			bool mIsEscaped = false;
+		};
+
+		/// <summary>
+		/// Splits the CSV into rows, which are fed by chunks (incomplete row is carried over to the next chunk).
+		/// </summary>
+		class CsvRowsSplitter
+		{
+		public:
+			/// <summary>
+			/// Appends the chunk and calls `onRows(const std::string&amp;)` with the header and all completed rows.
+			/// </summary>
+			template <typename TCallback>
+			void Feed(std::string_view chunk, TCallback&& onRows)
+			{
+				mBuffer.append(chunk);
+				size_t rowsEnd = 0;
+				for (size_t pos = mScanPos; pos < mBuffer.size(); ++pos)
+				{
+					const char ch = mBuffer[pos];
+					if (ch == '"') {
+						mIsInQuotes = !mIsInQuotes;
+					}
+					else if (ch == '\n' && !mIsInQuotes)
+					{
+						if (mHeader.empty()) {
+							mHeader.assign(mBuffer, 0, pos + 1);
+							mBuffer.erase(0, pos + 1);
+							pos = static_cast<size_t>(-1);
+						}
+						else {
+							rowsEnd = pos + 1;
+						}
+					}
+				}
+
+				mScanPos = mBuffer.size();
+				if (rowsEnd != 0)
+				{
+					EmitRows(rowsEnd, onRows);
+					mScanPos -= rowsEnd;
+				}
+			}
+
+			/// <summary>
+			/// Processes the last row (which may be without line ending).
+			/// </summary>
+			template <typename TCallback>
+			void Finish(TCallback&& onRows)
+			{
+				if (mIsInQuotes) {
+					throw ParsingException("Unexpected end of CSV, the quoted value is not completed");
+				}
+				if (mHeader.empty())
+				{
+					if (mBuffer.empty()) {
+						throw ParsingException("Input string is empty, expected at least a header line");
+					}
+					mHeader.swap(mBuffer);
+					mHeader.push_back('\n');
+				}
+				else if (!mBuffer.empty()) {
+					EmitRows(mBuffer.size(), onRows);
+				}
+				mScanPos = 0;
+			}
+
+		private:
+			template <typename TCallback>
+			void EmitRows(size_t rowsEnd, TCallback&& onRows)
+			{
+				mRowsText.assign(mHeader);
+				mRowsText.append(mBuffer, 0, rowsEnd);
+				mBuffer.erase(0, rowsEnd);
+				onRows(mRowsText);
+			}
+
+			std::string mBuffer;
+			std::string mHeader;
+			std::string mRowsText;
+			size_t mScanPos = 0;
+			bool mIsInQuotes = false;
+		};
+	}
+
+	/// <summary>
+	/// Push-style loader for data which arrives by chunks (e.g. from socket or pipe).
+	/// Each completed item of the root array (for JSON) or each row (for CSV) is loaded and passed to the callback,
+	/// the incomplete data is carried over to the next chunk.
+	/// </summary>
+	/// <example><code>
+	/// PushLoader&lt;JsonArchive, TMessage&gt; loader([](TMessage&amp;&amp; message) { ... });
+	/// loader.Feed(chunk1);
+	/// loader.Feed(chunk2);
+	/// loader.Finish();
+	/// </code></example>
+	template <typename TArchive, typename T>
+	class PushLoader
+	{
+		static_assert(TArchive::archive_type == ArchiveType::Json || TArchive::archive_type == ArchiveType::Csv,
+			"BitSerializer. The push loader supports only JSON and CSV archives.");
+
+	public:
+		using callback_type = std::function<void(T&&)>;
+
+		explicit PushLoader(callback_type callback, const SerializationOptions& serializationOptions = DefaultOptions)
+			: mCallback(std::move(callback))
+			, mSession(serializationOptions)
+		{ }
+
+		/// <summary>
+		/// Feeds the next chunk of UTF-8 encoded data.
+		/// </summary>
+		void Feed(std::string_view chunk)
+		{
+			if constexpr (TArchive::archive_type == ArchiveType::Json) {
+				mSplitter.Feed(chunk, [this](std::string_view itemText) { LoadItem(itemText); });
+			}
+			else {
+				mSplitter.Feed(chunk, [this](const std::string& rowsText) { LoadRows(rowsText); });
+			}
+		}
+
+		/// <summary>
+		/// Should be called at the end of input, throws `ParsingException` when the data is not completed.
+		/// </summary>
+		void Finish()
+		{
+			if constexpr (TArchive::archive_type == ArchiveType::Json) {
+				mSplitter.Finish();
+			}
+			else {
+				mSplitter.Finish([this](const std::string& rowsText) { LoadRows(rowsText); });
+			}
+		}
+
+	private:
+		void LoadItem(std::string_view itemText)
+		{
+			mItemText.assign(itemText);
+			T item{};
+			mSession.LoadObject(item, mItemText);
+			mCallback(std::move(item));
+		}
+
+		void LoadRows(const std::string& rowsText)
+		{
+			mRows.clear();
+			mSession.LoadObject(mRows, rowsText);
+			for (auto& row : mRows) {
+				mCallback(std::move(row));
+			}
+		}
+
+		using splitter_type = std::conditional_t<TArchive::archive_type == ArchiveType::Json, Detail::JsonArrayItemsSplitter, Detail::CsvRowsSplitter>;
+
+		callback_type mCallback;
+		SerializerSession<TArchive> mSession;
+		splitter_type mSplitter;
+		std::string mItemText;
+		std::vector<T> mRows;
+	};
+}
@@ -3,10 +3,14 @@
 * This file is part of BitSerializer library, licensed under the MIT license.  *
 *******************************************************************************/
 #pragma once
+#include <algorithm>
 #include <cassert>
+#include <memory>
 #include <optional>
+#include <string>
 #include <type_traits>
 #include <variant>
+#include <vector>
 #include "bitserializer/serialization_detail/archive_base.h"
 #include "bitserializer/serialization_detail/errors_handling.h"
 
@@ -43,6 +47,98 @@ protected:
 // Forward declarations
 template <SerializeMode TMode, class TEncoding, class TAllocator>
 class RapidJsonObjectScope;
+template <SerializeMode TMode, class TEncoding>
+class RapidJsonRootScope;
+
+/// <summary>
+/// Key of the wrapper object of raw fragment, the wrapper is recognized by the address of this key (not by its text),
+/// so it can't be confused with objects which are serialized from user's data.
+/// </summary>
+inline constexpr char RawFragmentKey[] = "$rawJson";
+
+/// <summary>
+/// SAX handler which forwards events to the writer, except wrappers of raw fragments (already encoded JSON), which are written as is.
+/// The wrapper is an object with single member with the `RawFragmentKey` (referenced without copying), its value is the fragment.
+/// </summary>
+template <class TWriter>
+class RawFragmentsHandler
+{
+public:
+	using Ch = typename TWriter::Ch;
+
+	explicit RawFragmentsHandler(TWriter& writer) noexcept
+		: mWriter(writer)
+	{ }
+
+	bool Null() { return mWriter.Null(); }
+	bool Bool(bool value) { return mWriter.Bool(value); }
+	bool Int(int value) { return mWriter.Int(value); }
+	bool Uint(unsigned value) { return mWriter.Uint(value); }
+	bool Int64(int64_t value) { return mWriter.Int64(value); }
+	bool Uint64(uint64_t value) { return mWriter.Uint64(value); }
+	bool Double(double value) { return mWriter.Double(value); }
+	bool RawNumber(const Ch* str, rapidjson::SizeType length, bool copy) { return mWriter.RawNumber(str, length, copy); }
+	bool StartArray() { return mWriter.StartArray(); }
+	bool EndArray(rapidjson::SizeType elementCount) { return mWriter.EndArray(elementCount); }
+
+	bool StartObject()
+	{
+		// The start of object is written when it is known that it's not a wrapper of raw fragment (on the first key or on the end)
+		mIsObjectStartPending = true;
+		return true;
+	}
+
+	bool Key(const Ch* str, rapidjson::SizeType length, bool copy)
+	{
+		if (mIsObjectStartPending)
+		{
+			mIsObjectStartPending = false;
+			if (static_cast<const void*>(str) == static_cast<const void*>(RawFragmentKey))
+			{
+				mIsRawFragmentExpected = true;
+				return true;
+			}
+			if (!mWriter.StartObject()) {
+				return false;
+			}
+		}
+		return mWriter.Key(str, length, copy);
+	}
+
+	bool String(const Ch* str, rapidjson::SizeType length, bool copy)
+	{
+		if (mIsRawFragmentExpected)
+		{
+			mIsRawFragmentExpected = false;
+			mIsWrapperEndExpected = true;
+			return mWriter.RawValue(str, length, rapidjson::kObjectType);
+		}
+		return mWriter.String(str, length, copy);
+	}
+
+	bool EndObject(rapidjson::SizeType memberCount)
+	{
+		if (mIsWrapperEndExpected)
+		{
+			mIsWrapperEndExpected = false;
+			return true;
+		}
+		if (mIsObjectStartPending)
+		{
+			mIsObjectStartPending = false;
+			if (!mWriter.StartObject()) {
+				return false;
+			}
+		}
+		return mWriter.EndObject(memberCount);
+	}
+
+private:
+	TWriter& mWriter;
+	bool mIsObjectStartPending = false;
+	bool mIsRawFragmentExpected = false;
+	bool mIsWrapperEndExpected = false;
+};
 
 /// <summary>
 /// Base class of JSON scope
@@ -54,6 +150,11 @@ class RapidJsonScopeBase : public RapidJsonArchiveTraits<TEncoding>
 public:
 	using RapidJsonNode = rapidjson::GenericValue<TEncoding>;
 	using key_type_view = std::basic_string_view<typename TEncoding::Ch>;
+	/// <summary>
+	/// The archive which is used for loading values from captured raw fragments.
+	/// </summary>
+	using raw_fragment_archive_type = TArchiveBase<RapidJsonArchiveTraits<TEncoding>,
+		RapidJsonRootScope<SerializeMode::Load, TEncoding>, RapidJsonRootScope<SerializeMode::Save, TEncoding>>;
 
 	RapidJsonScopeBase(RapidJsonNode* node, RapidJsonScopeBase<TEncoding>* parent = nullptr, key_type_view parentKey = {})
 		: mNode(node)
@@ -134,6 +235,18 @@ protected:
 		return true;
 	}
 
+	bool LoadValue(const RapidJsonNode& jsonValue, std::string_view& value, const SerializationOptions& serializationOptions)
+	{
+		if (!jsonValue.IsString())
+		{
+			HandleMismatchedTypesPolicy(serializationOptions.mismatchedTypesPolicy);
+			return false;
+		}
+
+		value = std::string_view(jsonValue.GetString(), jsonValue.GetStringLength());
+		return true;
+	}
+
 	template <typename TSym, typename TAllocator, typename TRapidAllocator>
 	RapidJsonNode MakeRapidJsonNodeFromString(const std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value, TRapidAllocator& allocator)
 	{
@@ -146,6 +259,42 @@ protected:
 		}
 	}
 
+	/// <summary>
+	/// Renders the JSON node to the raw fragment (UTF-8 without formatting).
+	/// </summary>
+	static void RenderRawFragment(const RapidJsonNode& jsonValue, std::string& fragment)
+	{
+		using StringBuffer = rapidjson::GenericStringBuffer<rapidjson::UTF8<>>;
+		StringBuffer buffer;
+		rapidjson::Writer<StringBuffer, TEncoding, rapidjson::UTF8<>> writer(buffer);
+		jsonValue.Accept(writer);
+		fragment.assign(buffer.GetString(), buffer.GetSize());
+	}
+
+	/// <summary>
+	/// Makes the wrapper of raw fragment, which is written as is by `AcceptWithRawFragments()` (the fragment is referenced without copying).
+	/// </summary>
+	template <typename TRapidAllocator>
+	static RapidJsonNode MakeRawFragmentNode(std::string_view fragment, TRapidAllocator& allocator)
+	{
+		static_assert(std::is_same_v<typename TEncoding::Ch, char>, "BitSerializer. Raw fragments are supported only for UTF-8 encoded DOM.");
+		assert(!fragment.empty());
+		RapidJsonNode wrapper(rapidjson::kObjectType);
+		RapidJsonNode fragmentNode(rapidjson::StringRef(fragment.data(), fragment.size()));
+		wrapper.AddMember(rapidjson::StringRef(RawFragmentKey, sizeof RawFragmentKey - 1), fragmentNode, allocator);
+		return wrapper;
+	}
+
+	/// <summary>
+	/// Passes the JSON node to the writer, raw fragments are written as is.
+	/// </summary>
+	template <class TWriter>
+	static void AcceptWithRawFragments(const RapidJsonNode& jsonValue, TWriter& writer)
+	{
+		RawFragmentsHandler<TWriter> handler(writer);
+		jsonValue.Accept(handler);
+	}
+
 	static void HandleMismatchedTypesPolicy(MismatchedTypesPolicy mismatchedTypesPolicy)
 	{
 		if (mismatchedTypesPolicy == MismatchedTypesPolicy::ThrowError)
@@ -172,12 +321,15 @@ public:
 	using RapidJsonNode = rapidjson::GenericValue<TEncoding>;
 	using iterator = typename RapidJsonNode::ValueIterator;
 	using key_type_view = std::basic_string_view<typename TEncoding::Ch>;
+	using shard_fragment_type = std::basic_string<typename TEncoding::Ch>;
 
-	RapidJsonArrayScope(RapidJsonNode* node, TAllocator& allocator, SerializationContext& serializationContext, RapidJsonScopeBase<TEncoding>* parent = nullptr, key_type_view parentKey = {})
+	RapidJsonArrayScope(RapidJsonNode* node, TAllocator& allocator, SerializationContext& serializationContext, RapidJsonScopeBase<TEncoding>* parent = nullptr,
+		key_type_view parentKey = {}, std::vector<shard_fragment_type>* shardFragments = nullptr)
 		: TArchiveScope<TMode>(serializationContext)
 		, RapidJsonScopeBase<TEncoding>(node, parent, parentKey)
 		, mAllocator(allocator)
 		, mValueIt(this->mNode->GetArray().Begin())
+		, mShardFragments(shardFragments)
 	{
 		assert(this->mNode->IsArray());
 	}
@@ -186,7 +338,79 @@ public:
 	/// Returns the estimated number of items to load (for reserving the size of containers).
 	/// </summary>
 	[[nodiscard]] size_t GetEstimatedSize() const {
-		return this->mNode->Capacity();
+		return this->mNode->Size();
+	}
+
+	/// <summary>
+	/// Creates an independent scope for loading items starting from the specified index (used for parallel loading).
+	/// </summary>
+	[[nodiscard]] RapidJsonArrayScope CreateShard(size_t startIndex, SerializationContext& serializationContext) const
+	{
+		static_assert(TMode == SerializeMode::Load);
+		RapidJsonArrayScope shardScope(this->mNode, mAllocator, serializationContext, this->mParent, this->mParentKey);
+		shardScope.mValueIt += static_cast<std::ptrdiff_t>(startIndex);
+		return shardScope;
+	}
+
+	/// <summary>
+	/// Returns `true` when items can be saved via shards (used for parallel saving, supported only for root array).
+	/// </summary>
+	[[nodiscard]] bool CanCreateShards() const noexcept
+	{
+		return mShardFragments != nullptr && this->mNode->Empty();
+	}
+
+	/// <summary>
+	/// Creates an independent scope which saves the specified number of items to its own document (used for parallel saving).
+	/// </summary>
+	[[nodiscard]] RapidJsonArrayScope CreateShard(SerializationContext& serializationContext, size_t itemsNum) const
+	{
+		static_assert(TMode == SerializeMode::Save);
+		auto shardDocument = std::make_unique<rapidjson::GenericDocument<TEncoding, TAllocator>>();
+		shardDocument->SetArray().Reserve(static_cast<rapidjson::SizeType>(itemsNum), shardDocument->GetAllocator());
+		RapidJsonArrayScope shardScope(shardDocument.get(), shardDocument->GetAllocator(), serializationContext, this->mParent, this->mParentKey);
+		shardScope.mShardDocument = std::move(shardDocument);
+		return shardScope;
+	}
+
+	/// <summary>
+	/// Renders items which were saved to the shard (without enclosing brackets).
+	/// </summary>
+	[[nodiscard]] shard_fragment_type FinalizeShard()
+	{
+		static_assert(TMode == SerializeMode::Save);
+		assert(mShardDocument);
+
+		using StringBuffer = rapidjson::GenericStringBuffer<TEncoding>;
+		StringBuffer buffer;
+		const auto& formatOptions = this->GetOptions().formatOptions;
+		if (formatOptions.enableFormat)
+		{
+			rapidjson::PrettyWriter<StringBuffer, TEncoding, TEncoding> writer(buffer);
+			writer.SetIndent(formatOptions.paddingChar, formatOptions.paddingCharNum);
+			this->AcceptWithRawFragments(*mShardDocument, writer);
+		}
+		else
+		{
+			rapidjson::Writer<StringBuffer, TEncoding, TEncoding> writer(buffer);
+			this->AcceptWithRawFragments(*mShardDocument, writer);
+		}
+
+		// Cut the opening bracket and the closing bracket (with preceding line break in the formatted output)
+		const std::basic_string_view<typename TEncoding::Ch> renderedArray(buffer.GetString(), buffer.GetSize());
+		const size_t suffixSize = formatOptions.enableFormat ? 2 : 1;
+		assert(renderedArray.size() > suffixSize);
+		return shard_fragment_type(renderedArray.substr(1, renderedArray.size() - 1 - suffixSize));
+	}
+
+	/// <summary>
+	/// Appends items which were saved to the shard.
+	/// </summary>
+	void MergeShard(shard_fragment_type&& shardFragment)
+	{
+		static_assert(TMode == SerializeMode::Save);
+		assert(mShardFragments);
+		mShardFragments->emplace_back(std::move(shardFragment));
 	}
 
 	/// <summary>
@@ -239,6 +463,36 @@ public:
 		}
 	}
 
+	/// <summary>
+	/// Loads the next item as view of the string in the DOM (only for UTF-8 encoded DOM), it is valid while the document is alive.
+	/// </summary>
+	template <typename TSym = typename TEncoding::Ch, std::enable_if_t<std::is_same_v<TSym, char>, int> = 0>
+	bool LoadStringView(std::string_view& value)
+	{
+		static_assert(TMode == SerializeMode::Load);
+		return this->LoadValue(LoadNextItem(), value, this->GetOptions());
+	}
+
+	/// <summary>
+	/// Loads the next item as raw fragment of JSON (UTF-8 without formatting).
+	/// </summary>
+	bool LoadRawFragment(std::string& fragment)
+	{
+		static_assert(TMode == SerializeMode::Load);
+		this->RenderRawFragment(LoadNextItem(), fragment);
+		return true;
+	}
+
+	/// <summary>
+	/// Saves the raw fragment of already encoded JSON, it is written to the output as is.
+	/// The fragment is not copied, so it should be alive until the end of serialization.
+	/// </summary>
+	void SaveRawFragment(std::string_view fragment)
+	{
+		static_assert(TMode == SerializeMode::Save);
+		SaveJsonValue(this->MakeRawFragmentNode(fragment, mAllocator));
+	}
+
 	std::optional<RapidJsonObjectScope<TMode, TEncoding, TAllocator>> OpenObjectScope()
 	{
 		if constexpr (TMode == SerializeMode::Load)
@@ -305,6 +559,8 @@ protected:
 
 	TAllocator& mAllocator;
 	iterator mValueIt;
+	std::vector<shard_fragment_type>* mShardFragments;
+	std::unique_ptr<rapidjson::GenericDocument<TEncoding, TAllocator>> mShardDocument;
 };
 
 /// <summary>
@@ -354,7 +610,6 @@ public:
 	using RapidJsonNode = rapidjson::GenericValue<TEncoding>;
 	using key_type = typename RapidJsonArchiveTraits<TEncoding>::key_type;
 	using key_type_view = std::basic_string_view<typename TEncoding::Ch>;
-	using key_raw_ptr = const typename TEncoding::Ch*;
 
 	RapidJsonObjectScope(RapidJsonNode* node, TAllocator& allocator, SerializationContext& serializationContext, RapidJsonScopeBase<TEncoding>* parent = nullptr, key_type_view parentKey = {})
 		: TArchiveScope<TMode>(serializationContext)
@@ -386,11 +641,12 @@ public:
 		}
 		else {
 			if constexpr (std::is_arithmetic_v<T>) {
-				return SaveJsonValue(std::forward<TKey>(key), RapidJsonNode(value));
+				SaveJsonValue(std::forward<TKey>(key), RapidJsonNode(value));
 			}
 			else {
-				return SaveJsonValue(std::forward<TKey>(key), RapidJsonNode());
+				SaveJsonValue(std::forward<TKey>(key), RapidJsonNode());
 			}
+			return true;
 		}
 	}
 
@@ -403,10 +659,48 @@ public:
 			return jsonValue == nullptr ? false : this->LoadValue(*jsonValue, value, this->GetOptions());
 		}
 		else {
-			return SaveJsonValue(std::forward<TKey>(key), RapidJsonScopeBase<TEncoding>::MakeRapidJsonNodeFromString(value, mAllocator));
+			SaveJsonValue(std::forward<TKey>(key), RapidJsonScopeBase<TEncoding>::MakeRapidJsonNodeFromString(value, mAllocator));
+			return true;
 		}
 	}
 
+	/// <summary>
+	/// Loads the value with the specified key as view of the string in the DOM (only for UTF-8 encoded DOM), it is valid while the document is alive.
+	/// </summary>
+	template <typename TKey, typename TSym = typename TEncoding::Ch, std::enable_if_t<std::is_same_v<TSym, char>, int> = 0>
+	bool LoadStringView(TKey&& key, std::string_view& value)
+	{
+		static_assert(TMode == SerializeMode::Load);
+		auto* jsonValue = this->LoadJsonValue(std::forward<TKey>(key));
+		return jsonValue == nullptr ? false : this->LoadValue(*jsonValue, value, this->GetOptions());
+	}
+
+	/// <summary>
+	/// Loads the value with the specified key as raw fragment of JSON (UTF-8 without formatting).
+	/// </summary>
+	template <typename TKey>
+	bool LoadRawFragment(TKey&& key, std::string& fragment)
+	{
+		static_assert(TMode == SerializeMode::Load);
+		auto* jsonValue = this->LoadJsonValue(std::forward<TKey>(key));
+		if (jsonValue == nullptr) {
+			return false;
+		}
+		this->RenderRawFragment(*jsonValue, fragment);
+		return true;
+	}
+
+	/// <summary>
+	/// Saves the raw fragment of already encoded JSON with the specified key, it is written to the output as is.
+	/// The fragment is not copied, so it should be alive until the end of serialization.
+	/// </summary>
+	template <typename TKey>
+	void SaveRawFragment(TKey&& key, std::string_view fragment)
+	{
+		static_assert(TMode == SerializeMode::Save);
+		SaveJsonValue(std::forward<TKey>(key), this->MakeRawFragmentNode(fragment, mAllocator));
+	}
+
 	template <typename TKey>
 	std::optional<RapidJsonObjectScope<TMode, TEncoding, TAllocator>> OpenObjectScope(TKey&& key)
 	{
@@ -414,14 +708,13 @@ public:
 		{
 			auto* jsonValue = LoadJsonValue(std::forward<TKey>(key));
 			if (jsonValue != nullptr && jsonValue->IsObject())
-				return std::make_optional<RapidJsonObjectScope<TMode, TEncoding, TAllocator>>(jsonValue, mAllocator, this->GetContext(), this, key);
+				return std::make_optional<RapidJsonObjectScope<TMode, TEncoding, TAllocator>>(jsonValue, mAllocator, this->GetContext(), this, BitSerializer::Detail::GetKeyView(key));
 			return std::nullopt;
 		}
 		else
 		{
-			SaveJsonValue(std::forward<TKey>(key), RapidJsonNode(rapidjson::kObjectType));
-			auto& insertedMember = FindMember(std::forward<TKey>(key))->value;
-			return std::make_optional<RapidJsonObjectScope<TMode, TEncoding, TAllocator>>(&insertedMember, mAllocator, this->GetContext(), this, key);
+			auto& insertedMember = SaveJsonValue(std::forward<TKey>(key), RapidJsonNode(rapidjson::kObjectType));
+			return std::make_optional<RapidJsonObjectScope<TMode, TEncoding, TAllocator>>(&insertedMember, mAllocator, this->GetContext(), this, BitSerializer::Detail::GetKeyView(key));
 		}
 	}
 
@@ -432,59 +725,51 @@ public:
 		{
 			auto* jsonValue = LoadJsonValue(std::forward<TKey>(key));
 			if (jsonValue != nullptr && jsonValue->IsArray())
-				return std::make_optional<RapidJsonArrayScope<TMode, TEncoding, TAllocator>>(jsonValue, mAllocator, this->GetContext(), this, key);
+				return std::make_optional<RapidJsonArrayScope<TMode, TEncoding, TAllocator>>(jsonValue, mAllocator, this->GetContext(), this, BitSerializer::Detail::GetKeyView(key));
 			return std::nullopt;
 		}
 		else
 		{
 			auto rapidJsonArray = RapidJsonNode(rapidjson::kArrayType);
 			rapidJsonArray.Reserve(static_cast<rapidjson::SizeType>(arraySize), mAllocator);
-			SaveJsonValue(std::forward<TKey>(key), std::move(rapidJsonArray));
-			auto& insertedMember = FindMember(std::forward<TKey>(key))->value;
-			return std::make_optional<RapidJsonArrayScope<TMode, TEncoding, TAllocator>>(&insertedMember, mAllocator, this->GetContext(), this, key);
+			auto& insertedMember = SaveJsonValue(std::forward<TKey>(key), std::move(rapidJsonArray));
+			return std::make_optional<RapidJsonArrayScope<TMode, TEncoding, TAllocator>>(&insertedMember, mAllocator, this->GetContext(), this, BitSerializer::Detail::GetKeyView(key));
 		}
 	}
 
 protected:
-	typename RapidJsonNode::MemberIterator FindMember(const key_type& key) const {
-		return this->mNode->GetObject().FindMember(key.c_str());
-	}
-
-	typename RapidJsonNode::MemberIterator FindMember(key_raw_ptr key) const {
-		return this->mNode->GetObject().FindMember(key);
-	}
-
-	RapidJsonNode* LoadJsonValue(const key_type& key) const
+	typename RapidJsonNode::MemberIterator FindMember(key_type_view key) const
 	{
-		const auto jObject = this->mNode->GetObject();
-		auto it = jObject.FindMember(key.c_str());
-		return it == jObject.MemberEnd() ? nullptr : &it->value;
+		// Passing the key with known length avoids scanning it, RapidJson compares the length of strings first
+		const RapidJsonNode jsonKey(rapidjson::StringRef(key.data(), key.size()));
+		return this->mNode->FindMember(jsonKey);
 	}
 
-	RapidJsonNode* LoadJsonValue(key_raw_ptr key) const
+	template <typename TKey>
+	RapidJsonNode* LoadJsonValue(TKey&& key) const
 	{
-		const auto jObject = this->mNode->GetObject();
-		const auto it = jObject.FindMember(key);
-		return it == jObject.MemberEnd() ? nullptr : &it->value;
+		const auto it = FindMember(BitSerializer::Detail::GetKeyView(key));
+		return it == this->mNode->MemberEnd() ? nullptr : &it->value;
 	}
 
-	bool SaveJsonValue(const key_type& key, RapidJsonNode&& jsonValue) const
-	{
-		// Checks that object was not saved previously under the same key
-		assert(this->mNode->GetObject().FindMember(key.c_str()) == this->mNode->GetObject().MemberEnd());
-
-		auto jsonKey = RapidJsonNode(key.data(), static_cast<rapidjson::SizeType>(key.size()), mAllocator);
-		this->mNode->AddMember(jsonKey.Move(), jsonValue.Move(), mAllocator);
-		return true;
-	}
-
-	bool SaveJsonValue(key_raw_ptr key, RapidJsonNode&& jsonValue) const
+	template <typename TKey>
+	RapidJsonNode& SaveJsonValue(TKey&& key, RapidJsonNode&& jsonValue) const
 	{
+		const auto keyView = BitSerializer::Detail::GetKeyView(key);
 		// Checks that object was not saved previously under the same key
-		assert(this->mNode->GetObject().FindMember(key) == this->mNode->GetObject().MemberEnd());
+		assert(FindMember(keyView) == this->mNode->MemberEnd());
 
-		this->mNode->AddMember(RapidJsonNode(typename RapidJsonNode::StringRefType(key)), jsonValue.Move(), mAllocator);
-		return true;
+		if constexpr (std::is_same_v<std::decay_t<TKey>, key_type>)
+		{
+			auto jsonKey = RapidJsonNode(keyView.data(), static_cast<rapidjson::SizeType>(keyView.size()), mAllocator);
+			this->mNode->AddMember(jsonKey.Move(), jsonValue.Move(), mAllocator);
+		}
+		else
+		{
+			// String literals and raw pointers to C-strings are stored without copying
+			this->mNode->AddMember(RapidJsonNode(rapidjson::StringRef(keyView.data(), keyView.size())), jsonValue.Move(), mAllocator);
+		}
+		return (this->mNode->MemberEnd() - 1)->value;
 	}
 
 	TAllocator& mAllocator;
@@ -541,6 +826,19 @@ public:
 		static_assert(TMode == SerializeMode::Save, "BitSerializer. This data type can be used only in 'Save' mode.");
 	}
 
+	RapidJsonRootScope(const RapidJsonRootScope&) = delete;
+	RapidJsonRootScope& operator=(const RapidJsonRootScope&) = delete;
+
+	~RapidJsonRootScope()
+	{
+		if (mSessionAllocator)
+		{
+			// The next document of the session will fit into the single block of memory
+			auto& sessionMemory = this->GetContext().GetSessionResources()->template Get<SessionAllocatorMemory>();
+			sessionMemory.requiredSize = std::max(sessionMemory.requiredSize, mSessionAllocator->Capacity() + SessionChunkHeaderReserve);
+		}
+	}
+
 	template <typename T, std::enable_if_t<std::is_arithmetic_v<T> || std::is_null_pointer_v<T>, int> = 0>
 	bool SerializeValue(T& value)
 	{
@@ -591,6 +889,36 @@ public:
 		}
 	}
 
+	/// <summary>
+	/// Loads the root value as view of the string in the DOM (only for UTF-8 encoded DOM), it is valid while the document is alive.
+	/// </summary>
+	template <typename TSym = typename TEncoding::Ch, std::enable_if_t<std::is_same_v<TSym, char>, int> = 0>
+	bool LoadStringView(std::string_view& value)
+	{
+		static_assert(TMode == SerializeMode::Load);
+		return this->LoadValue(mRootJson, value, this->GetOptions());
+	}
+
+	/// <summary>
+	/// Loads the root value as raw fragment of JSON (UTF-8 without formatting).
+	/// </summary>
+	bool LoadRawFragment(std::string& fragment)
+	{
+		static_assert(TMode == SerializeMode::Load);
+		this->RenderRawFragment(mRootJson, fragment);
+		return true;
+	}
+
+	/// <summary>
+	/// Saves the raw fragment of already encoded JSON as root value, it is written to the output as is.
+	/// The fragment is not copied, so it should be alive until the end of serialization.
+	/// </summary>
+	void SaveRawFragment(std::string_view fragment)
+	{
+		static_assert(TMode == SerializeMode::Save);
+		mRootJson.CopyFrom(this->MakeRawFragmentNode(fragment, mRootJson.GetAllocator()), mRootJson.GetAllocator());
+	}
+
 	std::optional<RapidJsonArrayScope<TMode, TEncoding, allocator_type>> OpenArrayScope(size_t arraySize)
 	{
 		if constexpr (TMode == SerializeMode::Load)
@@ -602,7 +930,8 @@ public:
 		else
 		{
 			mRootJson.SetArray().Reserve(static_cast<rapidjson::SizeType>(arraySize), mRootJson.GetAllocator());
-			return std::make_optional<RapidJsonArrayScope<TMode, TEncoding, allocator_type>>(&mRootJson, mRootJson.GetAllocator(), this->GetContext());
+			return std::make_optional<RapidJsonArrayScope<TMode, TEncoding, allocator_type>>(&mRootJson, mRootJson.GetAllocator(), this->GetContext(),
+				nullptr, std::basic_string_view<char_type>(), &mShardFragments);
 		}
 	}
 
@@ -634,16 +963,20 @@ public:
 				{
 					using StringBuffer = rapidjson::GenericStringBuffer<rapidjson::UTF8<>>;
 					StringBuffer buffer;
-					if (options.formatOptions.enableFormat)
+					if (!mShardFragments.empty())
+					{
+						WriteShardFragments<rapidjson::UTF8<>>(buffer);
+					}
+					else if (options.formatOptions.enableFormat)
 					{
 						rapidjson::PrettyWriter<StringBuffer, TEncoding, rapidjson::UTF8<>> writer(buffer);
 						writer.SetIndent(options.formatOptions.paddingChar, options.formatOptions.paddingCharNum);
-						mRootJson.Accept(writer);
+						this->AcceptWithRawFragments(mRootJson, writer);
 					}
 					else
 					{
 						rapidjson::Writer<StringBuffer, TEncoding, rapidjson::UTF8<>> writer(buffer);
-						mRootJson.Accept(writer);
+						this->AcceptWithRawFragments(mRootJson, writer);
 					}
 					*arg = buffer.GetString();
 				}
@@ -652,16 +985,20 @@ public:
 					rapidjson::OStreamWrapper osw(*arg);
 					using AutoOutputStream = rapidjson::AutoUTFOutputStream<uint32_t, rapidjson::OStreamWrapper>;
 					AutoOutputStream eos(osw, ToRapidUtfType(options.streamOptions.encoding), options.streamOptions.writeBom);
-					if (options.formatOptions.enableFormat)
+					if (!mShardFragments.empty())
+					{
+						WriteShardFragments<rapidjson::AutoUTF<uint32_t>>(eos);
+					}
+					else if (options.formatOptions.enableFormat)
 					{
 						rapidjson::PrettyWriter<AutoOutputStream, TEncoding, rapidjson::AutoUTF<uint32_t>> writer(eos);
 						writer.SetIndent(options.formatOptions.paddingChar, options.formatOptions.paddingCharNum);
-						mRootJson.Accept(writer);
+						this->AcceptWithRawFragments(mRootJson, writer);
 					}
 					else
 					{
 						rapidjson::Writer<AutoOutputStream, TEncoding, rapidjson::AutoUTF<uint32_t>> writer(eos);
-						mRootJson.Accept(writer);
+						this->AcceptWithRawFragments(mRootJson, writer);
 					}
 				}
 			}, mOutput);
@@ -670,6 +1007,31 @@ public:
 	}
 
 private:
+	/// <summary>
+	/// Writes the root array which was saved in parallel (fragments were rendered by shards).
+	/// </summary>
+	template <class TTargetEncoding, class TOutputStream>
+	void WriteShardFragments(TOutputStream& outputStream) const
+	{
+		const auto& formatOptions = this->GetOptions().formatOptions;
+		outputStream.Put('[');
+		for (size_t i = 0; i < mShardFragments.size(); ++i)
+		{
+			if (i != 0) {
+				outputStream.Put(',');
+			}
+			rapidjson::GenericStringStream<TEncoding> fragmentStream(mShardFragments[i].c_str());
+			while (fragmentStream.Peek() != '\0') {
+				rapidjson::Transcoder<TEncoding, TTargetEncoding>::Transcode(fragmentStream, outputStream);
+			}
+		}
+		if (formatOptions.enableFormat) {
+			outputStream.Put('\n');
+		}
+		outputStream.Put(']');
+		outputStream.Flush();
+	}
+
 	static rapidjson::UTFType ToRapidUtfType(const Convert::UtfType utfType)
 	{
 		switch (utfType)
@@ -692,8 +1054,38 @@ private:
 		}
 	}
 
-	RapidJsonDocument mRootJson;
+	/// <summary>
+	/// Memory for the DOM allocator, which is kept in the serializer session and grows up to the size of the largest document.
+	/// </summary>
+	struct SessionAllocatorMemory
+	{
+		std::vector<char> buffer;
+		size_t requiredSize = 0;
+	};
+
+	static constexpr size_t SessionChunkHeaderReserve = 64;
+
+	static std::optional<allocator_type> CreateSessionAllocator(SessionResources* sessionResources)
+	{
+		if (sessionResources == nullptr) {
+			return std::nullopt;
+		}
+
+		auto& sessionMemory = sessionResources->Get<SessionAllocatorMemory>();
+		if (sessionMemory.buffer.size() < sessionMemory.requiredSize) {
+			sessionMemory.buffer.resize(sessionMemory.requiredSize);
+		}
+		if (sessionMemory.buffer.empty()) {
+			return std::optional<allocator_type>(std::in_place);
+		}
+		return std::optional<allocator_type>(std::in_place, sessionMemory.buffer.data(), sessionMemory.buffer.size());
+	}
+
+	// The allocator must be declared before the document, which uses it
+	std::optional<allocator_type> mSessionAllocator = CreateSessionAllocator(this->GetContext().GetSessionResources());
+	RapidJsonDocument mRootJson{ mSessionAllocator ? &*mSessionAllocator : nullptr };
 	std::variant<decltype(nullptr), std::string*, std::ostream*> mOutput;
+	std::vector<std::basic_string<char_type>> mShardFragments;
 };
 
 }
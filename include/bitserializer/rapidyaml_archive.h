@@ -3,10 +3,15 @@
 * This file is part of BitSerializer library, licensed under the MIT license.  *
 *******************************************************************************/
 #pragma once
+#include <algorithm>
 #include <cassert>
+#include <charconv>
+#include <memory>
 #include <type_traits>
 #include <optional>
+#include <string>
 #include <variant>
+#include <vector>
 #include "bitserializer/serialization_detail/errors_handling.h"
 #include "bitserializer/serialization_detail/archive_base.h"
 
@@ -38,6 +43,95 @@ namespace BitSerializer::Yaml::RapidYaml {
 			~RapidYamlArchiveTraits() = default;
 		};
 
+		/// <summary>
+		/// Thread-local pool of trees, which are reused with their node and arena storage between serialization calls.
+		/// </summary>
+		class RapidYamlTreePool
+		{
+		public:
+			/// <summary>
+			/// Takes the tree from the serializer session (when it exists) or from the thread-local pool.
+			/// </summary>
+			static std::unique_ptr<ryml::Tree> Acquire(SessionResources* sessionResources)
+			{
+				if (sessionResources != nullptr)
+				{
+					if (auto& sessionTree = sessionResources->Get<SessionTree>().tree) {
+						return std::move(sessionTree);
+					}
+					return std::make_unique<ryml::Tree>();
+				}
+
+				auto& pool = GetPool();
+				if (pool.empty()) {
+					return std::make_unique<ryml::Tree>();
+				}
+				auto tree = std::move(pool.back());
+				pool.pop_back();
+				return tree;
+			}
+
+			static void Release(std::unique_ptr<ryml::Tree> tree, SessionResources* sessionResources) noexcept
+			{
+				if (tree && sessionResources != nullptr)
+				{
+					// The session keeps its tree regardless of size, as its lifetime is controlled by the caller
+					tree->clear();
+					tree->clear_arena();
+					sessionResources->Get<SessionTree>().tree = std::move(tree);
+					return;
+				}
+
+				// Trees of large documents are not kept for avoiding the retention of memory
+				auto& pool = GetPool();
+				if (tree && pool.size() < MaxPoolSize && tree->capacity() <= MaxPooledNodes && tree->arena_capacity() <= MaxPooledArenaSize)
+				{
+					tree->clear();
+					tree->clear_arena();
+					pool.push_back(std::move(tree));
+				}
+			}
+
+			/// <summary>
+			/// Reserves nodes for the specified number of children, the capacity is grown geometrically for nested arrays.
+			/// </summary>
+			static void ReserveNodes(ryml::Tree& tree, size_t childrenNum)
+			{
+				if (const size_t requiredCapacity = tree.size() + childrenNum; requiredCapacity > tree.capacity()) {
+					tree.reserve(std::max(requiredCapacity, tree.capacity() * 2));
+				}
+			}
+
+			/// <summary>
+			/// Estimates the number of nodes in the YAML by the number of lines (like the base library).
+			/// </summary>
+			static size_t EstimateNodesNumber(std::string_view yaml) noexcept
+			{
+				return std::max<size_t>(static_cast<size_t>(std::count(yaml.cbegin(), yaml.cend(), '\n')) + 1, 16);
+			}
+
+		private:
+			struct SessionTree
+			{
+				std::unique_ptr<ryml::Tree> tree;
+			};
+
+			static constexpr size_t MaxPoolSize = 4;
+			static constexpr size_t MaxPooledNodes = 64 * 1024;
+			static constexpr size_t MaxPooledArenaSize = 1024 * 1024;
+
+			static std::vector<std::unique_ptr<ryml::Tree>>& GetPool()
+			{
+				// The storage is reserved in advance, so releasing a tree never allocates
+				thread_local std::vector<std::unique_ptr<ryml::Tree>> pool = []() {
+					std::vector<std::unique_ptr<ryml::Tree>> trees;
+					trees.reserve(MaxPoolSize);
+					return trees;
+				}();
+				return pool;
+			}
+		};
+
 		// Forward declarations
 		template <SerializeMode TMode>
 		class RapidYamlObjectScope;
@@ -92,6 +186,12 @@ namespace BitSerializer::Yaml::RapidYaml {
 				const auto str = std::string_view(yamlValue.val().data(), yamlValue.val().size());
 				try
 				{
+					if constexpr (std::is_floating_point_v<T>)
+					{
+						if (LoadFloatingPoint(str, value)) {
+							return true;
+						}
+					}
 					if constexpr (!std::is_null_pointer_v<T>)
 					{
 						value = Convert::To<T>(str);
@@ -143,7 +243,7 @@ namespace BitSerializer::Yaml::RapidYaml {
 				if constexpr (std::is_null_pointer_v<T>) {
 					yamlValue << nullValue;
 				} else if constexpr (std::is_floating_point_v<T>) {
-					yamlValue << c4::fmt::real(value, std::numeric_limits<T>::max_digits10, c4::RealFormat_e::FTOA_SCIENT);
+					SaveFloatingPoint(yamlValue, value);
 				} else if constexpr (std::is_same_v<T, char>) {
 					// Need to extend size of type for prevent save as character
 					yamlValue << static_cast<int16_t>(value);
@@ -161,6 +261,39 @@ namespace BitSerializer::Yaml::RapidYaml {
 					yamlValue << Convert::To<std::string>(value);
 			}
 
+			/// <summary>
+			/// Saves floating point number in the shortest form which guarantees the round-trip (e.g. `0.5` instead of `5.00000000000000000e-01`).
+			/// </summary>
+			template <typename T>
+			static void SaveFloatingPoint(RapidYamlNode& yamlValue, T value)
+			{
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+				char buffer[64];
+				const auto result = std::to_chars(buffer, buffer + sizeof buffer, value);
+				yamlValue << c4::csubstr(buffer, static_cast<size_t>(result.ptr - buffer));
+#else
+				yamlValue << c4::fmt::real(value, std::numeric_limits<T>::max_digits10, c4::RealFormat_e::FTOA_SCIENT);
+#endif
+			}
+
+			/// <summary>
+			/// Fast parsing of floating point number, returns `false` when the format is not supported (will be parsed by common converter).
+			/// </summary>
+			template <typename T>
+			static bool LoadFloatingPoint([[maybe_unused]] std::string_view str, [[maybe_unused]] T& value)
+			{
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+				const char* end = str.data() + str.size();
+				const auto result = std::from_chars(str.data(), end, value);
+				if (result.ec == std::errc::result_out_of_range) {
+					throw std::out_of_range("Argument out of range");
+				}
+				return result.ec == std::errc() && result.ptr == end;
+#else
+				return false;
+#endif
+			}
+
 			static bool IsNullYamlValue(c4::csubstr str)
 			{
 				return str.data() == nullptr ||
@@ -184,11 +317,14 @@ namespace BitSerializer::Yaml::RapidYaml {
 		class RapidYamlArrayScope final : public TArchiveScope<TMode>, public RapidYamlScopeBase
 		{
 		public:
-			RapidYamlArrayScope(const RapidYamlNode& node, SerializationContext& serializationContext, size_t size, RapidYamlScopeBase* parent = nullptr, key_type_view parentKey = {})
+			RapidYamlArrayScope(const RapidYamlNode& node, SerializationContext& serializationContext, size_t size, RapidYamlScopeBase* parent = nullptr, key_type_view parentKey = {},
+				std::vector<std::string>* shardFragments = nullptr)
 				: TArchiveScope<TMode>(serializationContext)
 				, RapidYamlScopeBase(node, parent, parentKey)
 				, mSize(size)
 				, mIndex(0)
+				, mNextItem(TMode == SerializeMode::Load ? mNode.first_child() : RapidYamlNode())
+				, mShardFragments(shardFragments)
 			{
 				assert(mNode.is_seq());
 			}
@@ -201,6 +337,65 @@ namespace BitSerializer::Yaml::RapidYaml {
 				return mSize;
 			}
 
+			/// <summary>
+			/// Creates an independent scope for loading items starting from the specified index (used for parallel loading).
+			/// </summary>
+			[[nodiscard]]
+			RapidYamlArrayScope CreateShard(size_t startIndex, SerializationContext& serializationContext) const
+			{
+				static_assert(TMode == SerializeMode::Load);
+				RapidYamlArrayScope shardScope(mNode, serializationContext, mSize, mParent, mParentKey);
+				shardScope.mIndex = startIndex;
+				shardScope.mNextItem = startIndex < mSize ? shardScope.mNode.child(startIndex) : RapidYamlNode();
+				return shardScope;
+			}
+
+			/// <summary>
+			/// Returns `true` when items can be saved via shards (used for parallel saving, supported only for root array).
+			/// </summary>
+			[[nodiscard]]
+			bool CanCreateShards() const noexcept
+			{
+				return mShardFragments != nullptr && mIndex == 0;
+			}
+
+			/// <summary>
+			/// Creates an independent scope which saves the specified number of items to its own tree (used for parallel saving).
+			/// </summary>
+			[[nodiscard]]
+			RapidYamlArrayScope CreateShard(SerializationContext& serializationContext, size_t itemsNum) const
+			{
+				static_assert(TMode == SerializeMode::Save);
+				auto shardTree = std::make_unique<ryml::Tree>();
+				RapidYamlTreePool::ReserveNodes(*shardTree, itemsNum);
+				RapidYamlNode shardRootNode = shardTree->rootref();
+				shardRootNode |= ryml::SEQ;
+				RapidYamlArrayScope shardScope(shardRootNode, serializationContext, itemsNum, mParent, mParentKey);
+				shardScope.mShardTree = std::move(shardTree);
+				return shardScope;
+			}
+
+			/// <summary>
+			/// Emits items which were saved to the shard.
+			/// </summary>
+			[[nodiscard]]
+			std::string FinalizeShard()
+			{
+				static_assert(TMode == SerializeMode::Save);
+				assert(mShardTree);
+				return ryml::emitrs<std::string>(*mShardTree);
+			}
+
+			/// <summary>
+			/// Appends items which were saved to the shard.
+			/// </summary>
+			void MergeShard(std::string&& shardFragment)
+			{
+				static_assert(TMode == SerializeMode::Save);
+				assert(mShardFragments);
+				mShardFragments->emplace_back(std::move(shardFragment));
+			}
+
 			/// <summary>
 			/// Returns `true` when all no more values to load.
 			/// </summary>
@@ -286,6 +481,7 @@ namespace BitSerializer::Yaml::RapidYaml {
 				else
 				{
 					assert(mIndex < GetEstimatedSize());
+					RapidYamlTreePool::ReserveNodes(*mNode.tree(), arraySize + 1);
 					auto yamlValue = mNode.append_child();
 					yamlValue |= ryml::SEQ;
 					mIndex++;
@@ -299,13 +495,20 @@ namespace BitSerializer::Yaml::RapidYaml {
 				static_assert(TMode == SerializeMode::Load);
 				if (mIndex < mSize)
 				{
-					return mNode[mIndex++];
+					// Iterate over siblings, as access to child by index requires walking from the first child
+					auto yamlValue = mNextItem;
+					mNextItem = mNextItem.next_sibling();
+					++mIndex;
+					return yamlValue;
 				}
 				throw SerializationException(SerializationErrorCode::OutOfRange, "No more items to load");
 			}
 
 			size_t mSize;
 			size_t mIndex;
+			RapidYamlNode mNextItem;
+			std::vector<std::string>* mShardFragments;
+			std::unique_ptr<ryml::Tree> mShardTree;
 		};
 
 		/// <summary>
@@ -390,14 +593,15 @@ namespace BitSerializer::Yaml::RapidYaml {
 			{
 				if constexpr (TMode == SerializeMode::Load)
 				{
-					const auto yamlValue = mNode.find_child(c4::to_csubstr(key));
+					const auto yamlValue = mNode.find_child(ToKeySubstr(key));
 					return yamlValue.valid() ? LoadValue(yamlValue, value, this->GetOptions()) : false;
 				}
 				else
 				{
-					assert(!mNode.find_child(c4::to_csubstr(key)).valid());
+					const auto keySubstr = ToKeySubstr(key);
+					assert(!mNode.find_child(keySubstr).valid());
 					auto yamlValue = mNode.append_child();
-					yamlValue << ryml::key(key);
+					yamlValue << ryml::key(keySubstr);
 					SaveValue(yamlValue, value);
 					return true;
 				}
@@ -412,18 +616,19 @@ namespace BitSerializer::Yaml::RapidYaml {
 			{
 				if constexpr (TMode == SerializeMode::Load)
 				{
-					const auto yamlValue = mNode.find_child(c4::to_csubstr(key));
+					const auto yamlValue = mNode.find_child(ToKeySubstr(key));
 					if (yamlValue.valid())
-						return yamlValue.is_map() ? std::make_optional<RapidYamlObjectScope<TMode>>(yamlValue, TArchiveScope<TMode>::GetContext(), this, key) : std::nullopt;
+						return yamlValue.is_map() ? std::make_optional<RapidYamlObjectScope<TMode>>(yamlValue, TArchiveScope<TMode>::GetContext(), this, BitSerializer::Detail::GetKeyView(key)) : std::nullopt;
 					return std::nullopt;
 				}
 				else
 				{
-					assert(!mNode.find_child(c4::to_csubstr(key)).valid());
+					const auto keySubstr = ToKeySubstr(key);
+					assert(!mNode.find_child(keySubstr).valid());
 					auto yamlValue = mNode.append_child();
-					yamlValue << c4::yml::key(key);
+					yamlValue << c4::yml::key(keySubstr);
 					yamlValue |= ryml::MAP;
-					return std::make_optional<RapidYamlObjectScope<TMode>>(yamlValue, TArchiveScope<TMode>::GetContext(), this, key);
+					return std::make_optional<RapidYamlObjectScope<TMode>>(yamlValue, TArchiveScope<TMode>::GetContext(), this, BitSerializer::Detail::GetKeyView(key));
 				}
 			}
 
@@ -437,20 +642,33 @@ namespace BitSerializer::Yaml::RapidYaml {
 			{
 				if constexpr (TMode == SerializeMode::Load)
 				{
-					const auto yamlValue = mNode.find_child(c4::to_csubstr(key));
+					const auto yamlValue = mNode.find_child(ToKeySubstr(key));
 					if (yamlValue.valid())
-						return yamlValue.is_seq() ? std::make_optional<RapidYamlArrayScope<TMode>>(yamlValue, TArchiveScope<TMode>::GetContext(), yamlValue.num_children(), this, key) : std::nullopt;
+						return yamlValue.is_seq() ? std::make_optional<RapidYamlArrayScope<TMode>>(yamlValue, TArchiveScope<TMode>::GetContext(), yamlValue.num_children(), this, BitSerializer::Detail::GetKeyView(key)) : std::nullopt;
 					return std::nullopt;
 				}
 				else
 				{
-					assert(!mNode.find_child(c4::to_csubstr(key)).valid());
+					const auto keySubstr = ToKeySubstr(key);
+					assert(!mNode.find_child(keySubstr).valid());
+					RapidYamlTreePool::ReserveNodes(*mNode.tree(), arraySize + 1);
 					auto yamlValue = mNode.append_child();
-					yamlValue << c4::yml::key(key);
+					yamlValue << c4::yml::key(keySubstr);
 					yamlValue |= ryml::SEQ;
-					return std::make_optional<RapidYamlArrayScope<TMode>>(yamlValue, TArchiveScope<TMode>::GetContext(), arraySize, this, key);
+					return std::make_optional<RapidYamlArrayScope<TMode>>(yamlValue, TArchiveScope<TMode>::GetContext(), arraySize, this, BitSerializer::Detail::GetKeyView(key));
 				}
 			}
+
+		private:
+			/// <summary>
+			/// Makes the substring from the key (the length of string literals is known at compile time).
+			/// </summary>
+			template <typename TKey>
+			static c4::csubstr ToKeySubstr(const TKey& key) noexcept
+			{
+				const auto keyView = BitSerializer::Detail::GetKeyView(key);
+				return { keyView.data(), keyView.size() };
+			}
 		};
 
 		/// <summary>
@@ -463,6 +681,13 @@ namespace BitSerializer::Yaml::RapidYaml {
 		public:
 			RapidYamlRootScope(const RapidYamlRootScope&) = delete;
 			RapidYamlRootScope& operator=(const RapidYamlRootScope&) = delete;
+			RapidYamlRootScope(RapidYamlRootScope&&) = delete;
+			RapidYamlRootScope& operator=(RapidYamlRootScope&&) = delete;
+
+			~RapidYamlRootScope()
+			{
+				RapidYamlTreePool::Release(std::move(mTreeHolder), this->GetContext().GetSessionResources());
+			}
 
 			RapidYamlRootScope(const char* inputStr, SerializationContext& serializationContext)
 				: TArchiveScope<TMode>(serializationContext)
@@ -502,9 +727,7 @@ namespace BitSerializer::Yaml::RapidYaml {
 					throw SerializationException(SerializationErrorCode::UnsupportedEncoding, "The archive does not support encoding: " + Convert::ToString(utfType));
 				}
 
-				// ToDo: base library does not support std::stream (check in new versions)
-				const std::string inputStr(std::istreambuf_iterator<char>(inputStream), {});
-				Parse<c4::yml::Parser>(inputStr);
+				ParseStream<c4::yml::Parser>(inputStream);
 			}
 
 			RapidYamlRootScope(std::ostream& outputStream, SerializationContext& serializationContext)
@@ -543,8 +766,10 @@ namespace BitSerializer::Yaml::RapidYaml {
 				}
 				else
 				{
+					RapidYamlTreePool::ReserveNodes(mTree, arraySize);
 					mRootNode |= ryml::SEQ;
-					return std::make_optional<RapidYamlArrayScope<TMode>>(mRootNode, TArchiveScope<TMode>::GetContext(), arraySize);
+					return std::make_optional<RapidYamlArrayScope<TMode>>(mRootNode, TArchiveScope<TMode>::GetContext(), arraySize,
+						nullptr, key_type_view(), &mShardFragments);
 				}
 			}
 
@@ -559,15 +784,34 @@ namespace BitSerializer::Yaml::RapidYaml {
 					{
 						using T = std::decay_t<decltype(arg)>;
 						auto& options = TArchiveScope<TMode>::GetOptions();
-						if constexpr (std::is_same_v<T, std::string*>) {
-							*arg = ryml::emitrs<std::string>(mTree);
+						if constexpr (std::is_same_v<T, std::string*>)
+						{
+							if (mShardFragments.empty()) {
+								*arg = ryml::emitrs<std::string>(mTree);
+							}
+							else
+							{
+								// The root array was saved in parallel, items of each shard are emitted at the same level as in the root array
+								arg->clear();
+								for (const auto& shardFragment : mShardFragments) {
+									arg->append(shardFragment);
+								}
+							}
 						}
 						else if constexpr (std::is_same_v<T, std::ostream*>)
 						{
 							if (options.streamOptions.writeBom) {
 								arg->write(Convert::Utf8::bom, sizeof Convert::Utf8::bom);
 							}
-							*arg << mTree;
+							if (mShardFragments.empty()) {
+								*arg << mTree;
+							}
+							else
+							{
+								for (const auto& shardFragment : mShardFragments) {
+									arg->write(shardFragment.data(), static_cast<std::streamsize>(shardFragment.size()));
+								}
+							}
 						}
 					}, mOutput);
 					mOutput = nullptr;
@@ -575,14 +819,62 @@ namespace BitSerializer::Yaml::RapidYaml {
 			}
 
 		private:
-			RapidYamlRootScope(RapidYamlRootScope&&) = default;
-			RapidYamlRootScope& operator=(RapidYamlRootScope&&) = default;
-
 			template <typename T>
 			void Parse(std::string_view inputStr)
 			{
+				mTree.reserve(RapidYamlTreePool::EstimateNodesNumber(inputStr));
+				mTree.reserve_arena(inputStr.size());
+				T parser(ryml::Callbacks(nullptr, nullptr, nullptr, &RapidYamlRootScope::ErrorCallback));
+				parser.parse_in_arena({}, c4::csubstr(inputStr.data(), inputStr.size()), &mTree);
+				mRootNode = mTree.rootref();
+			}
+
+			/// <summary>
+			/// Reads the stream by large blocks directly to the arena of tree and parses it in place (without intermediate copies).
+			/// </summary>
+			template <typename T>
+			void ParseStream(std::istream& inputStream)
+			{
+				static constexpr size_t BlockSize = 64 * 1024;
+
+				// Reserve the arena for the rest of stream, when it is seekable
+				size_t blockSize = BlockSize;
+				if (const auto startPos = inputStream.tellg(); startPos != std::streampos(-1))
+				{
+					if (inputStream.seekg(0, std::ios_base::end))
+					{
+						if (const auto endPos = inputStream.tellg(); endPos > startPos) {
+							blockSize = static_cast<size_t>(endPos - startPos);
+						}
+					}
+					inputStream.clear();
+					inputStream.seekg(startPos);
+				}
+				mTree.reserve_arena(blockSize);
+
+				// Allocated blocks are contiguous (the arena is relocated as a whole when it grows)
+				char* dataPtr = nullptr;
+				size_t dataSize = 0;
+				while (true)
+				{
+					const c4::substr block = mTree.alloc_arena(blockSize);
+					dataPtr = block.str - dataSize;
+					inputStream.read(block.str, static_cast<std::streamsize>(block.len));
+					dataSize += static_cast<size_t>(inputStream.gcount());
+
+					// Next blocks are needed only when the size of stream is unknown (or it is larger than expected)
+					if (!inputStream || inputStream.peek() == std::char_traits<char>::eof()) {
+						break;
+					}
+					blockSize = BlockSize;
+				}
+				if (inputStream.bad()) {
+					throw SerializationException(SerializationErrorCode::InputOutputError, "Error reading the input stream");
+				}
+
+				mTree.reserve(RapidYamlTreePool::EstimateNodesNumber(std::string_view(dataPtr, dataSize)));
 				T parser(ryml::Callbacks(nullptr, nullptr, nullptr, &RapidYamlRootScope::ErrorCallback));
-				mTree = parser.parse_in_arena({}, c4::csubstr(inputStr.data(), inputStr.size()));
+				parser.parse_in_place({}, c4::substr(dataPtr, dataSize), &mTree);
 				mRootNode = mTree.rootref();
 			}
 
@@ -591,9 +883,11 @@ namespace BitSerializer::Yaml::RapidYaml {
 				throw ParsingException({ msg, msg + length }, location.line);
 			}
 
-			ryml::Tree mTree;
+			std::unique_ptr<ryml::Tree> mTreeHolder = RapidYamlTreePool::Acquire(this->GetContext().GetSessionResources());
+			ryml::Tree& mTree = *mTreeHolder;
 			RapidYamlNode mRootNode = mTree.rootref();
 			std::variant<std::nullptr_t, std::string*, std::ostream*> mOutput;
+			std::vector<std::string> mShardFragments;
 		};
 	}
 
@@ -0,0 +1,118 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "bitserializer/serialization_detail/serialization_base_types.h"
+
+namespace BitSerializer
+{
+	/// <summary>
+	/// Already encoded JSON value (UTF-8), which is spliced into the output document without parsing (the archive should support raw fragments).
+	/// Use `RawJson` for owning the text and `RawJsonView` for referencing it (the text should be alive until the end of serialization).
+	/// </summary>
+	/// <example><code>
+	/// struct TResponse {
+	///     int status;
+	///     RawJsonView data;  // Pre-serialized cached fragment
+	/// };
+	/// </code></example>
+	template <typename TStorage>
+	class BasicRawJson
+	{
+		static_assert(std::is_same_v<TStorage, std::string> || std::is_same_v<TStorage, std::string_view>,
+			"BitSerializer. The raw JSON can be stored only in std::string or std::string_view.");
+
+	public:
+		using storage_type = TStorage;
+
+		BasicRawJson() = default;
+
+		explicit BasicRawJson(TStorage json)
+			: mJson(std::move(json))
+		{ }
+
+		[[nodiscard]] const TStorage& Get() const noexcept { return mJson; }
+		[[nodiscard]] std::string_view View() const noexcept { return mJson; }
+		[[nodiscard]] bool IsEmpty() const noexcept { return mJson.empty(); }
+
+		bool operator==(const BasicRawJson& rhs) const noexcept { return mJson == rhs.mJson; }
+		bool operator!=(const BasicRawJson& rhs) const noexcept { return mJson != rhs.mJson; }
+
+	private:
+		TStorage mJson;
+	};
+
+	using RawJson = BasicRawJson<std::string>;
+	using RawJsonView = BasicRawJson<std::string_view>;
+
+	namespace Detail
+	{
+		template <typename TArchive, typename TStorage>
+		constexpr void CheckRawJsonSupport()
+		{
+			static_assert(TArchive::archive_type == ArchiveType::Json,
+				"BitSerializer. The raw JSON can be serialized only by JSON archives.");
+			static_assert(!TArchive::IsLoading() || std::is_same_v<TStorage, std::string>,
+				"BitSerializer. The RawJsonView can't be loaded, as it doesn't own the text (use RawJson).");
+		}
+
+		/// <summary>
+		/// The empty raw JSON is saved as null.
+		/// </summary>
+		template <typename TStorage>
+		std::string_view GetRawJsonToSave(const BasicRawJson<TStorage>& value) noexcept
+		{
+			return value.IsEmpty() ? std::string_view("null") : value.View();
+		}
+	}
+
+	/// <summary>
+	/// Serializes raw JSON with key.
+	/// </summary>
+	template <class TArchive, typename TKey, typename TStorage>
+	bool Serialize(TArchive& archive, TKey&& key, BasicRawJson<TStorage>& value)
+	{
+		Detail::CheckRawJsonSupport<TArchive, TStorage>();
+		static_assert(can_serialize_raw_fragment_with_key_v<TArchive, TKey>, "BitSerializer. The archive doesn't support raw JSON values.");
+
+		if constexpr (TArchive::IsLoading())
+		{
+			std::string json;
+			if (!archive.LoadRawFragment(std::forward<TKey>(key), json)) {
+				return false;
+			}
+			value = BasicRawJson<TStorage>(std::move(json));
+		}
+		else {
+			archive.SaveRawFragment(std::forward<TKey>(key), Detail::GetRawJsonToSave(value));
+		}
+		return true;
+	}
+
+	/// <summary>
+	/// Serializes raw JSON without key.
+	/// </summary>
+	template <class TArchive, typename TStorage>
+	bool Serialize(TArchive& archive, BasicRawJson<TStorage>& value)
+	{
+		Detail::CheckRawJsonSupport<TArchive, TStorage>();
+		static_assert(can_serialize_raw_fragment_v<TArchive>, "BitSerializer. The archive doesn't support raw JSON values.");
+
+		if constexpr (TArchive::IsLoading())
+		{
+			std::string json;
+			if (!archive.LoadRawFragment(json)) {
+				return false;
+			}
+			value = BasicRawJson<TStorage>(std::move(json));
+		}
+		else {
+			archive.SaveRawFragment(Detail::GetRawJsonToSave(value));
+		}
+		return true;
+	}
+}
@@ -5,6 +5,8 @@
 #pragma once
 #include <tuple>
 #include <limits>
+#include <string>
+#include <string_view>
 #include "serialization_context.h"
 #include "bitserializer/conversion_detail/convert_enum.h"
 
@@ -88,6 +90,31 @@ public:
 
 namespace Detail
 {
+	/// <summary>
+	/// Returns the view of the key (string literal, pointer to C-string, std::basic_string or std::basic_string_view).
+	/// The size of arrays (e.g. string literals) is known at compile time, it limits the search of the null terminator.
+	/// </summary>
+	template <typename TKey>
+	constexpr auto GetKeyView(const TKey& key) noexcept
+	{
+		if constexpr (std::is_array_v<TKey>)
+		{
+			using TSym = std::remove_cv_t<std::remove_extent_t<TKey>>;
+			// The array can be a buffer which is not filled completely, so the key ends at the first null (if any)
+			constexpr size_t arraySize = std::extent_v<TKey>;
+			const TSym* nullPos = std::char_traits<TSym>::find(key, arraySize, TSym());
+			return std::basic_string_view<TSym>(key, nullPos ? static_cast<size_t>(nullPos - key) : arraySize);
+		}
+		else if constexpr (std::is_pointer_v<TKey>)
+		{
+			return std::basic_string_view<std::remove_cv_t<std::remove_pointer_t<TKey>>>(key);
+		}
+		else
+		{
+			return std::basic_string_view<typename TKey::value_type, typename TKey::traits_type>(key);
+		}
+	}
+
 	/// <summary>
 	/// Casts numbers according to policy.
 	/// </summary>
@@ -208,6 +208,138 @@ template <typename TArchive, typename TKey>
 constexpr bool can_serialize_array_with_key_v = can_serialize_array_with_key<TArchive, TKey>::value;
 
 
+/// <summary>
+/// Checks that the array scope can create shards - independent scopes for loading ranges of items in parallel.
+/// </summary>
+template <typename TArchive>
+struct can_create_shard
+{
+private:
+	template <typename TObj>
+	static std::enable_if_t<std::is_class_v<decltype(std::declval<const TObj&>().CreateShard(std::declval<size_t>(), std::declval<SerializationContext&>()))>, std::true_type> test(int);
+
+	template <typename>
+	static std::false_type test(...);
+
+public:
+	typedef decltype(test<TArchive>(0)) type;
+	enum { value = type::value };
+};
+
+template <typename TArchive>
+constexpr bool can_create_shard_v = can_create_shard<TArchive>::value;
+
+
+/// <summary>
+/// Checks that the array scope can save items via shards - independent scopes with own output, which are merged in original order.
+/// </summary>
+template <typename TArchive>
+struct can_save_by_shards
+{
+private:
+	template <typename TObj>
+	static std::enable_if_t<std::is_same_v<bool, decltype(std::declval<const TObj&>().CanCreateShards())>, std::true_type> test(int);
+
+	template <typename>
+	static std::false_type test(...);
+
+public:
+	typedef decltype(test<TArchive>(0)) type;
+	enum { value = type::value };
+};
+
+template <typename TArchive>
+constexpr bool can_save_by_shards_v = can_save_by_shards<TArchive>::value;
+
+
+/// <summary>
+/// Checks that the scope can load and save values as raw fragments of encoded document (without key).
+/// </summary>
+template <typename TArchive>
+struct can_serialize_raw_fragment
+{
+private:
+	template <typename TObj>
+	static std::enable_if_t<std::is_same_v<bool, decltype(std::declval<TObj>().LoadRawFragment(std::declval<std::string&>()))>, std::true_type> test(int);
+
+	template <typename>
+	static std::false_type test(...);
+
+public:
+	typedef decltype(test<TArchive>(0)) type;
+	enum { value = type::value };
+};
+
+template <typename TArchive>
+constexpr bool can_serialize_raw_fragment_v = can_serialize_raw_fragment<TArchive>::value;
+
+
+/// <summary>
+/// Checks that the scope can load and save values as raw fragments of encoded document (with key).
+/// </summary>
+template <typename TArchive, typename TKey>
+struct can_serialize_raw_fragment_with_key
+{
+private:
+	template <typename TObj>
+	static std::enable_if_t<std::is_same_v<bool, decltype(std::declval<TObj>().LoadRawFragment(std::declval<TKey>(), std::declval<std::string&>()))>, std::true_type> test(int);
+
+	template <typename>
+	static std::false_type test(...);
+
+public:
+	typedef decltype(test<TArchive>(0)) type;
+	enum { value = type::value };
+};
+
+template <typename TArchive, typename TKey>
+constexpr bool can_serialize_raw_fragment_with_key_v = can_serialize_raw_fragment_with_key<TArchive, TKey>::value;
+
+
+/// <summary>
+/// Checks that the scope can load string value as view to the internal buffer, without copying (without key).
+/// </summary>
+template <typename TArchive>
+struct can_load_string_view
+{
+private:
+	template <typename TObj>
+	static std::enable_if_t<std::is_same_v<bool, decltype(std::declval<TObj>().LoadStringView(std::declval<std::string_view&>()))>, std::true_type> test(int);
+
+	template <typename>
+	static std::false_type test(...);
+
+public:
+	typedef decltype(test<TArchive>(0)) type;
+	enum { value = type::value };
+};
+
+template <typename TArchive>
+constexpr bool can_load_string_view_v = can_load_string_view<TArchive>::value;
+
+
+/// <summary>
+/// Checks that the scope can load string value as view to the internal buffer, without copying (with key).
+/// </summary>
+template <typename TArchive, typename TKey>
+struct can_load_string_view_with_key
+{
+private:
+	template <typename TObj>
+	static std::enable_if_t<std::is_same_v<bool, decltype(std::declval<TObj>().LoadStringView(std::declval<TKey>(), std::declval<std::string_view&>()))>, std::true_type> test(int);
+
+	template <typename>
+	static std::false_type test(...);
+
+public:
+	typedef decltype(test<TArchive>(0)) type;
+	enum { value = type::value };
+};
+
+template <typename TArchive, typename TKey>
+constexpr bool can_load_string_view_with_key_v = can_load_string_view_with_key<TArchive, TKey>::value;
+
+
 //------------------------------------------------------------------------------
 
 /// <summary>
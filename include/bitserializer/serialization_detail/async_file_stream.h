@@ -0,0 +1,304 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <streambuf>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace BitSerializer::Detail
+{
+	/// <summary>
+	/// Input stream buffer which reads the file in a background thread, so reading of the next block overlaps with parsing of the current one.
+	/// Supports `tellg()` and seeking within the current block (enough for detecting the encoding by BOM).
+	/// </summary>
+	class AsyncFileReadBuffer final : public std::streambuf
+	{
+	public:
+		static constexpr size_t DefaultBlockSize = 1024 * 1024;
+
+		explicit AsyncFileReadBuffer(size_t blockSize = DefaultBlockSize, size_t blocksNum = 2)
+			: mBlockSize(blockSize)
+		{
+			for (size_t i = 0; i < blocksNum; ++i) {
+				mFreeBlocks.emplace_back(mBlockSize);
+			}
+		}
+
+		AsyncFileReadBuffer(const AsyncFileReadBuffer&) = delete;
+		AsyncFileReadBuffer& operator=(const AsyncFileReadBuffer&) = delete;
+
+		~AsyncFileReadBuffer() override
+		{
+			{
+				std::lock_guard lock(mMutex);
+				mIsStopping = true;
+			}
+			mCondition.notify_all();
+			if (mReaderThread.joinable()) {
+				mReaderThread.join();
+			}
+		}
+
+		/// <summary>
+		/// Opens the file and starts reading in the background thread.
+		/// </summary>
+		template <typename TPath>
+		bool Open(const TPath& path)
+		{
+			if (mFile.open(path, std::ios::in | std::ios::binary) == nullptr) {
+				return false;
+			}
+			mReaderThread = std::thread([this]() { ReaderLoop(); });
+			return true;
+		}
+
+	protected:
+		int_type underflow() override
+		{
+			if (gptr() < egptr()) {
+				return traits_type::to_int_type(*gptr());
+			}
+
+			std::unique_lock lock(mMutex);
+			mCondition.wait(lock, [this]() { return !mFilledBlocks.empty() || mIsEof; });
+			if (mFilledBlocks.empty()) {
+				// The current block is kept for able to seek back within it
+				return traits_type::eof();
+			}
+
+			// Return the current block to the reader thread
+			if (!mCurrentBlock.empty())
+			{
+				mBlockStartPos += static_cast<std::streamoff>(egptr() - eback());
+				mFreeBlocks.emplace_back(std::move(mCurrentBlock));
+			}
+			auto [block, size] = std::move(mFilledBlocks.front());
+			mFilledBlocks.pop_front();
+			lock.unlock();
+			mCondition.notify_all();
+
+			mCurrentBlock = std::move(block);
+			setg(mCurrentBlock.data(), mCurrentBlock.data(), mCurrentBlock.data() + size);
+			return traits_type::to_int_type(*gptr());
+		}
+
+		pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+		{
+			if (dir == std::ios_base::cur) {
+				return seekpos(mBlockStartPos + static_cast<off_type>(gptr() - eback()) + off, which);
+			}
+			if (dir == std::ios_base::beg) {
+				return seekpos(off, which);
+			}
+			return pos_type(off_type(-1));
+		}
+
+		pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+		{
+			if ((which & std::ios_base::in) == 0) {
+				return pos_type(off_type(-1));
+			}
+			if (eback() == nullptr && traits_type::eq_int_type(underflow(), traits_type::eof()) && pos != pos_type(0)) {
+				return pos_type(off_type(-1));
+			}
+
+			const off_type offset = off_type(pos) - mBlockStartPos;
+			if (offset < 0 || offset > egptr() - eback()) {
+				return pos_type(off_type(-1));
+			}
+			setg(eback(), eback() + offset, egptr());
+			return pos;
+		}
+
+	private:
+		void ReaderLoop()
+		{
+			while (true)
+			{
+				std::vector<char> block;
+				{
+					std::unique_lock lock(mMutex);
+					mCondition.wait(lock, [this]() { return mIsStopping || !mFreeBlocks.empty(); });
+					if (mIsStopping) {
+						return;
+					}
+					block = std::move(mFreeBlocks.front());
+					mFreeBlocks.pop_front();
+				}
+
+				const auto readSize = mFile.sgetn(block.data(), static_cast<std::streamsize>(mBlockSize));
+				{
+					std::lock_guard lock(mMutex);
+					if (readSize > 0) {
+						mFilledBlocks.emplace_back(std::move(block), static_cast<size_t>(readSize));
+					}
+					mIsEof = readSize < static_cast<std::streamsize>(mBlockSize);
+				}
+				mCondition.notify_all();
+				if (readSize < static_cast<std::streamsize>(mBlockSize)) {
+					return;
+				}
+			}
+		}
+
+		const size_t mBlockSize;
+		std::filebuf mFile;
+		std::thread mReaderThread;
+		std::mutex mMutex;
+		std::condition_variable mCondition;
+		std::deque<std::vector<char>> mFreeBlocks;
+		std::deque<std::pair<std::vector<char>, size_t>> mFilledBlocks;
+		std::vector<char> mCurrentBlock;
+		off_type mBlockStartPos = 0;
+		bool mIsEof = false;
+		bool mIsStopping = false;
+	};
+
+	/// <summary>
+	/// Output stream buffer which writes filled blocks to the file in a background thread, so encoding overlaps with writing.
+	/// </summary>
+	class AsyncFileWriteBuffer final : public std::streambuf
+	{
+	public:
+		static constexpr size_t DefaultBlockSize = 1024 * 1024;
+
+		explicit AsyncFileWriteBuffer(size_t blockSize = DefaultBlockSize, size_t blocksNum = 2)
+			: mBlockSize(blockSize)
+		{
+			for (size_t i = 0; i < blocksNum; ++i) {
+				mFreeBlocks.emplace_back(mBlockSize);
+			}
+		}
+
+		AsyncFileWriteBuffer(const AsyncFileWriteBuffer&) = delete;
+		AsyncFileWriteBuffer& operator=(const AsyncFileWriteBuffer&) = delete;
+
+		~AsyncFileWriteBuffer() override
+		{
+			if (mWriterThread.joinable())
+			{
+				sync();
+				{
+					std::lock_guard lock(mMutex);
+					mIsStopping = true;
+				}
+				mCondition.notify_all();
+				mWriterThread.join();
+			}
+		}
+
+		/// <summary>
+		/// Opens the file and starts the background writer thread.
+		/// </summary>
+		template <typename TPath>
+		bool Open(const TPath& path)
+		{
+			if (mFile.open(path, std::ios::out | std::ios::binary) == nullptr) {
+				return false;
+			}
+			mWriterThread = std::thread([this]() { WriterLoop(); });
+			return true;
+		}
+
+	protected:
+		int_type overflow(int_type ch) override
+		{
+			if (!SubmitCurrentBlock()) {
+				return traits_type::eof();
+			}
+			if (!traits_type::eq_int_type(ch, traits_type::eof()))
+			{
+				*pptr() = traits_type::to_char_type(ch);
+				pbump(1);
+				return ch;
+			}
+			return traits_type::not_eof(ch);
+		}
+
+		/// <summary>
+		/// Writes all pending blocks and flushes the file (waits for the writer thread).
+		/// </summary>
+		int sync() override
+		{
+			if (!SubmitCurrentBlock()) {
+				return -1;
+			}
+			std::unique_lock lock(mMutex);
+			mCondition.wait(lock, [this]() { return mFilledBlocks.empty() && !mIsWriting; });
+			return !mHasError && mFile.pubsync() == 0 ? 0 : -1;
+		}
+
+	private:
+		bool SubmitCurrentBlock()
+		{
+			std::unique_lock lock(mMutex);
+			if (!mCurrentBlock.empty())
+			{
+				if (const auto size = static_cast<size_t>(pptr() - pbase()); size != 0) {
+					mFilledBlocks.emplace_back(std::move(mCurrentBlock), size);
+					mCondition.notify_all();
+				}
+				else {
+					mFreeBlocks.emplace_back(std::move(mCurrentBlock));
+				}
+			}
+			mCondition.wait(lock, [this]() { return !mFreeBlocks.empty() || mHasError; });
+			if (mHasError)
+			{
+				setp(nullptr, nullptr);
+				return false;
+			}
+			mCurrentBlock = std::move(mFreeBlocks.front());
+			mFreeBlocks.pop_front();
+			setp(mCurrentBlock.data(), mCurrentBlock.data() + mCurrentBlock.size());
+			return true;
+		}
+
+		void WriterLoop()
+		{
+			while (true)
+			{
+				std::pair<std::vector<char>, size_t> filledBlock;
+				{
+					std::unique_lock lock(mMutex);
+					mCondition.wait(lock, [this]() { return mIsStopping || !mFilledBlocks.empty(); });
+					if (mFilledBlocks.empty()) {
+						return;
+					}
+					filledBlock = std::move(mFilledBlocks.front());
+					mFilledBlocks.pop_front();
+					mIsWriting = true;
+				}
+
+				auto& [block, size] = filledBlock;
+				const bool isWritten = mFile.sputn(block.data(), static_cast<std::streamsize>(size)) == static_cast<std::streamsize>(size);
+				{
+					std::lock_guard lock(mMutex);
+					mHasError = mHasError || !isWritten;
+					mFreeBlocks.emplace_back(std::move(block));
+					mIsWriting = false;
+				}
+				mCondition.notify_all();
+			}
+		}
+
+		const size_t mBlockSize;
+		std::filebuf mFile;
+		std::thread mWriterThread;
+		std::mutex mMutex;
+		std::condition_variable mCondition;
+		std::deque<std::vector<char>> mFreeBlocks;
+		std::deque<std::pair<std::vector<char>, size_t>> mFilledBlocks;
+		std::vector<char> mCurrentBlock;
+		bool mIsWriting = false;
+		bool mHasError = false;
+		bool mIsStopping = false;
+	};
+}
@@ -58,13 +58,23 @@ public:
 
 	/// <summary>
 	/// Adapts the attribute to target archive and move to base AttributeValue type.
+	/// The converted string literals are cached, so the base AttributeValue will hold a reference to the cached key.
 	/// </summary>
 	template<class TArchiveKey>
-	AttributeValue<TArchiveKey, TValue, Validators...> AdaptAndMoveToBaseAttributeValue()
+	auto AdaptAndMoveToBaseAttributeValue()
 	{
-		auto archiveCompatibleKey = Convert::To<TArchiveKey>(this->GetKey());
-		return BitSerializer::AttributeValue<TArchiveKey, TValue, Validators...>(
-			std::move(archiveCompatibleKey), this->GetValue(), std::move(this->mValidators));
+		if constexpr (Detail::is_cacheable_key_v<TAttrKey>)
+		{
+			const TArchiveKey& archiveCompatibleKey = Detail::GetAdaptedKey<TArchiveKey>(this->GetKey());
+			return BitSerializer::AttributeValue<const TArchiveKey&, TValue, Validators...>(
+				archiveCompatibleKey, this->GetValue(), std::move(this->mValidators));
+		}
+		else
+		{
+			auto archiveCompatibleKey = Convert::To<TArchiveKey>(this->GetKey());
+			return BitSerializer::AttributeValue<TArchiveKey, TValue, Validators...>(
+				std::move(archiveCompatibleKey), this->GetValue(), std::move(this->mValidators));
+		}
 	}
 };
 
@@ -0,0 +1,474 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "bitserializer/serialization_detail/errors_handling.h"
+#include "bitserializer/serialization_detail/serialization_options.h"
+
+// Support of compression algorithms is enabled by CMake when libraries are found (or can be defined manually)
+#if defined BITSERIALIZER_HAS_ZLIB
+#include <zlib.h>
+#endif
+#if defined BITSERIALIZER_HAS_ZSTD
+#include <zstd.h>
+#endif
+
+namespace BitSerializer::Detail
+{
+	/// <summary>
+	/// Detects the compression by magic bytes at the beginning of data (only gzip and zstd, as zlib has no real magic number).
+	/// </summary>
+	inline CompressionType DetectCompression(std::string_view data) noexcept
+	{
+		const auto* bytes = reinterpret_cast<const unsigned char*>(data.data());
+		if (data.size() >= 2 && bytes[0] == 0x1F && bytes[1] == 0x8B) {
+			return CompressionType::Gzip;
+		}
+		if (data.size() >= 4 && bytes[0] == 0x28 && bytes[1] == 0xB5 && bytes[2] == 0x2F && bytes[3] == 0xFD) {
+			return CompressionType::Zstd;
+		}
+		return CompressionType::None;
+	}
+
+	[[noreturn]] inline void ThrowUnsupportedCompression(CompressionType compression)
+	{
+		const char* name = compression == CompressionType::Zstd ? "zstd" : "zlib";
+		throw SerializationException(SerializationErrorCode::UnsupportedEncoding,
+			std::string("Compressed stream is not supported, BitSerializer was built without ") + name);
+	}
+
+	/// <summary>
+	/// Input stream buffer which decompresses data from the source stream by blocks.
+	/// Supports `tellg()` and seeking within the current block (enough for detecting the encoding by BOM).
+	/// </summary>
+	class DecompressionInputBuffer final : public std::streambuf
+	{
+	public:
+		static constexpr size_t BlockSize = 64 * 1024;
+
+		/// <summary>
+		/// Creates the buffer when data in the source stream is compressed, otherwise returns `nullptr`.
+		/// When the compression is not passed, it is detected by magic bytes.
+		/// </summary>
+		static std::unique_ptr<DecompressionInputBuffer> Create(std::streambuf& source, CompressionType compression = CompressionType::None)
+		{
+			if (compression != CompressionType::None) {
+				return std::make_unique<DecompressionInputBuffer>(source, compression, std::string_view());
+			}
+
+			// Fast check of the first byte without consuming it
+			const auto firstByte = source.sgetc();
+			if (firstByte != 0x1F && firstByte != 0x28) {
+				return nullptr;
+			}
+
+			char magic[4];
+			auto size = static_cast<size_t>(std::max<std::streamsize>(0, source.sgetn(magic, sizeof magic)));
+			compression = DetectCompression(std::string_view(magic, size));
+			if (compression == CompressionType::None)
+			{
+				// Put the magic bytes back, when it is not possible the rest of them is passed through the buffer
+				for (; size != 0 && source.sungetc() != traits_type::eof(); --size) {}
+				if (size == 0) {
+					return nullptr;
+				}
+			}
+			return std::make_unique<DecompressionInputBuffer>(source, compression, std::string_view(magic, size));
+		}
+
+		DecompressionInputBuffer(std::streambuf& source, CompressionType compression, std::string_view consumedData)
+			: mSource(source)
+			, mCompression(compression)
+			, mInBlock(std::max(BlockSize, consumedData.size()))
+			, mOutBlock(BlockSize)
+			, mInSize(consumedData.size())
+			, mIsFrameCompleted(compression == CompressionType::None)
+		{
+			std::memcpy(mInBlock.data(), consumedData.data(), consumedData.size());
+			switch (mCompression)
+			{
+			case CompressionType::None:
+				break;
+			case CompressionType::Gzip:
+			case CompressionType::Zlib:
+#if defined BITSERIALIZER_HAS_ZLIB
+				if (inflateInit2(&mZStream, mCompression == CompressionType::Gzip ? MAX_WBITS + 16 : MAX_WBITS) != Z_OK) {
+					throw SerializationException(SerializationErrorCode::InputOutputError, "Failed to initialize zlib decompression");
+				}
+				mIsZStreamInitialized = true;
+				break;
+#else
+				ThrowUnsupportedCompression(mCompression);
+#endif
+			case CompressionType::Zstd:
+#if defined BITSERIALIZER_HAS_ZSTD
+				mZstdContext = ZSTD_createDCtx();
+				if (mZstdContext == nullptr) {
+					throw SerializationException(SerializationErrorCode::InputOutputError, "Failed to initialize zstd decompression");
+				}
+				break;
+#else
+				ThrowUnsupportedCompression(mCompression);
+#endif
+			}
+		}
+
+		DecompressionInputBuffer(const DecompressionInputBuffer&) = delete;
+		DecompressionInputBuffer& operator=(const DecompressionInputBuffer&) = delete;
+
+		~DecompressionInputBuffer() override
+		{
+#if defined BITSERIALIZER_HAS_ZLIB
+			if (mIsZStreamInitialized) {
+				inflateEnd(&mZStream);
+			}
+#endif
+#if defined BITSERIALIZER_HAS_ZSTD
+			ZSTD_freeDCtx(mZstdContext);
+#endif
+		}
+
+		/// <summary>
+		/// Throws `ParsingException` when the compressed data was corrupted or truncated.
+		/// </summary>
+		void ThrowIfError() const
+		{
+			if (!mError.empty()) {
+				throw ParsingException(mError, 0, static_cast<size_t>(mBlockStartPos));
+			}
+		}
+
+	protected:
+		int_type underflow() override
+		{
+			if (gptr() < egptr()) {
+				return traits_type::to_int_type(*gptr());
+			}
+
+			// Fill the whole block, so that the beginning of data is available for detecting the encoding
+			size_t outSize = 0;
+			while (outSize < mOutBlock.size() && !mIsEnd && mError.empty())
+			{
+				if (mInPos == mInSize && !ReadInput())
+				{
+					if (!mIsFrameCompleted) {
+						mError = "Unexpected end of compressed data";
+					}
+					mIsEnd = true;
+					break;
+				}
+				outSize += Decode(mOutBlock.data() + outSize, mOutBlock.size() - outSize);
+			}
+			if (outSize == 0) {
+				// The current block is kept for able to seek back within it
+				return traits_type::eof();
+			}
+
+			mBlockStartPos += static_cast<off_type>(egptr() - eback());
+			setg(mOutBlock.data(), mOutBlock.data(), mOutBlock.data() + outSize);
+			return traits_type::to_int_type(*gptr());
+		}
+
+		pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+		{
+			if (dir == std::ios_base::cur) {
+				return seekpos(mBlockStartPos + static_cast<off_type>(gptr() - eback()) + off, which);
+			}
+			if (dir == std::ios_base::beg) {
+				return seekpos(off, which);
+			}
+			return pos_type(off_type(-1));
+		}
+
+		pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+		{
+			if ((which & std::ios_base::in) == 0) {
+				return pos_type(off_type(-1));
+			}
+			if (eback() == nullptr && traits_type::eq_int_type(underflow(), traits_type::eof()) && pos != pos_type(0)) {
+				return pos_type(off_type(-1));
+			}
+
+			const off_type offset = off_type(pos) - mBlockStartPos;
+			if (offset < 0 || offset > egptr() - eback()) {
+				return pos_type(off_type(-1));
+			}
+			setg(eback(), eback() + offset, egptr());
+			return pos;
+		}
+
+	private:
+		bool ReadInput()
+		{
+			mInPos = 0;
+			mInSize = static_cast<size_t>(std::max<std::streamsize>(0, mSource.sgetn(mInBlock.data(), static_cast<std::streamsize>(mInBlock.size()))));
+			return mInSize != 0;
+		}
+
+		/// <summary>
+		/// Decodes the next portion of input, returns the size of decoded data.
+		/// </summary>
+		size_t Decode(char* out, size_t outSize)
+		{
+			switch (mCompression)
+			{
+			case CompressionType::None:
+			{
+				const size_t size = std::min(outSize, mInSize - mInPos);
+				std::memcpy(out, mInBlock.data() + mInPos, size);
+				mInPos += size;
+				return size;
+			}
+#if defined BITSERIALIZER_HAS_ZLIB
+			case CompressionType::Gzip:
+			case CompressionType::Zlib:
+			{
+				// Concatenated gzip members are decoded as one stream (like `gzip -d` does)
+				if (mIsFrameCompleted)
+				{
+					inflateReset(&mZStream);
+					mIsFrameCompleted = false;
+				}
+				mZStream.next_in = reinterpret_cast<Bytef*>(mInBlock.data() + mInPos);
+				mZStream.avail_in = static_cast<uInt>(mInSize - mInPos);
+				mZStream.next_out = reinterpret_cast<Bytef*>(out);
+				mZStream.avail_out = static_cast<uInt>(outSize);
+				const int result = inflate(&mZStream, Z_NO_FLUSH);
+				mInPos = mInSize - mZStream.avail_in;
+				if (result == Z_STREAM_END)
+				{
+					mIsFrameCompleted = true;
+					mIsEnd = mCompression == CompressionType::Zlib;
+				}
+				else if (result != Z_OK && result != Z_BUF_ERROR) {
+					mError = std::string("Corrupted compressed data: ") + (mZStream.msg ? mZStream.msg : "unknown zlib error");
+				}
+				return outSize - mZStream.avail_out;
+			}
+#endif
+#if defined BITSERIALIZER_HAS_ZSTD
+			case CompressionType::Zstd:
+			{
+				ZSTD_inBuffer input{ mInBlock.data() + mInPos, mInSize - mInPos, 0 };
+				ZSTD_outBuffer output{ out, outSize, 0 };
+				const size_t result = ZSTD_decompressStream(mZstdContext, &output, &input);
+				mInPos += input.pos;
+				if (ZSTD_isError(result)) {
+					mError = std::string("Corrupted compressed data: ") + ZSTD_getErrorName(result);
+				}
+				else {
+					mIsFrameCompleted = result == 0;
+				}
+				return output.pos;
+			}
+#endif
+			default:
+				mError = "Unsupported compression";
+				return 0;
+			}
+		}
+
+		std::streambuf& mSource;
+		const CompressionType mCompression;
+		std::vector<char> mInBlock;
+		std::vector<char> mOutBlock;
+		size_t mInPos = 0;
+		size_t mInSize = 0;
+		off_type mBlockStartPos = 0;
+		bool mIsFrameCompleted;
+		bool mIsEnd = false;
+		std::string mError;
+#if defined BITSERIALIZER_HAS_ZLIB
+		z_stream mZStream{};
+		bool mIsZStreamInitialized = false;
+#endif
+#if defined BITSERIALIZER_HAS_ZSTD
+		ZSTD_DCtx* mZstdContext = nullptr;
+#endif
+	};
+
+	/// <summary>
+	/// Output stream buffer which compresses data by blocks and writes them to the target stream.
+	/// The `Finish()` must be called for writing the end of compressed stream.
+	/// </summary>
+	class CompressionOutputBuffer final : public std::streambuf
+	{
+	public:
+		static constexpr size_t BlockSize = 64 * 1024;
+
+		CompressionOutputBuffer(std::streambuf& target, CompressionType compression, int compressionLevel)
+			: mTarget(target)
+			, mCompression(compression)
+			, mInBlock(BlockSize)
+			, mOutBlock(BlockSize)
+		{
+			switch (mCompression)
+			{
+			case CompressionType::None:
+				break;
+			case CompressionType::Gzip:
+			case CompressionType::Zlib:
+#if defined BITSERIALIZER_HAS_ZLIB
+				if (deflateInit2(&mZStream, compressionLevel == 0 ? Z_DEFAULT_COMPRESSION : compressionLevel, Z_DEFLATED,
+					mCompression == CompressionType::Gzip ? MAX_WBITS + 16 : MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+				{
+					throw SerializationException(SerializationErrorCode::InvalidOptions, "Failed to initialize zlib compression, check the compression level");
+				}
+				mIsZStreamInitialized = true;
+				break;
+#else
+				ThrowUnsupportedCompression(mCompression);
+#endif
+			case CompressionType::Zstd:
+#if defined BITSERIALIZER_HAS_ZSTD
+				mZstdContext = ZSTD_createCCtx();
+				if (mZstdContext == nullptr || ZSTD_isError(ZSTD_CCtx_setParameter(mZstdContext, ZSTD_c_compressionLevel, compressionLevel))) {
+					throw SerializationException(SerializationErrorCode::InvalidOptions, "Failed to initialize zstd compression, check the compression level");
+				}
+				break;
+#else
+				ThrowUnsupportedCompression(mCompression);
+#endif
+			}
+			setp(mInBlock.data(), mInBlock.data() + mInBlock.size());
+		}
+
+		CompressionOutputBuffer(const CompressionOutputBuffer&) = delete;
+		CompressionOutputBuffer& operator=(const CompressionOutputBuffer&) = delete;
+
+		~CompressionOutputBuffer() override
+		{
+			if (!mIsFinished) {
+				Compress(Mode::Finish);
+			}
+#if defined BITSERIALIZER_HAS_ZLIB
+			if (mIsZStreamInitialized) {
+				deflateEnd(&mZStream);
+			}
+#endif
+#if defined BITSERIALIZER_HAS_ZSTD
+			ZSTD_freeCCtx(mZstdContext);
+#endif
+		}
+
+		/// <summary>
+		/// Compresses the rest of data and writes the end of compressed stream.
+		/// </summary>
+		void Finish()
+		{
+			mIsFinished = true;
+			if (!Compress(Mode::Finish) || mTarget.pubsync() != 0) {
+				throw SerializationException(SerializationErrorCode::InputOutputError, "Failed to write compressed data");
+			}
+		}
+
+	protected:
+		int_type overflow(int_type ch) override
+		{
+			if (mIsFinished || !Compress(Mode::Continue)) {
+				return traits_type::eof();
+			}
+			if (!traits_type::eq_int_type(ch, traits_type::eof()))
+			{
+				*pptr() = traits_type::to_char_type(ch);
+				pbump(1);
+				return ch;
+			}
+			return traits_type::not_eof(ch);
+		}
+
+		int sync() override
+		{
+			return !mIsFinished && Compress(Mode::Flush) && mTarget.pubsync() == 0 ? 0 : -1;
+		}
+
+	private:
+		enum class Mode
+		{
+			Continue,
+			Flush,
+			Finish
+		};
+
+		/// <summary>
+		/// Compresses the data in the put area and writes the result to the target stream.
+		/// </summary>
+		bool Compress(Mode mode)
+		{
+			const auto size = static_cast<size_t>(pptr() - pbase());
+			setp(mInBlock.data(), mInBlock.data() + mInBlock.size());
+			switch (mCompression)
+			{
+			case CompressionType::None:
+				return Write(mInBlock.data(), size);
+#if defined BITSERIALIZER_HAS_ZLIB
+			case CompressionType::Gzip:
+			case CompressionType::Zlib:
+			{
+				const int flush = mode == Mode::Finish ? Z_FINISH : (mode == Mode::Flush ? Z_SYNC_FLUSH : Z_NO_FLUSH);
+				mZStream.next_in = reinterpret_cast<Bytef*>(mInBlock.data());
+				mZStream.avail_in = static_cast<uInt>(size);
+				while (true)
+				{
+					mZStream.next_out = reinterpret_cast<Bytef*>(mOutBlock.data());
+					mZStream.avail_out = static_cast<uInt>(mOutBlock.size());
+					const int result = deflate(&mZStream, flush);
+					if (result == Z_STREAM_ERROR || !Write(mOutBlock.data(), mOutBlock.size() - mZStream.avail_out)) {
+						return false;
+					}
+					if (flush == Z_FINISH ? result == Z_STREAM_END : mZStream.avail_out != 0) {
+						return true;
+					}
+				}
+			}
+#endif
+#if defined BITSERIALIZER_HAS_ZSTD
+			case CompressionType::Zstd:
+			{
+				const ZSTD_EndDirective directive = mode == Mode::Finish ? ZSTD_e_end : (mode == Mode::Flush ? ZSTD_e_flush : ZSTD_e_continue);
+				ZSTD_inBuffer input{ mInBlock.data(), size, 0 };
+				while (true)
+				{
+					ZSTD_outBuffer output{ mOutBlock.data(), mOutBlock.size(), 0 };
+					const size_t remaining = ZSTD_compressStream2(mZstdContext, &output, &input, directive);
+					if (ZSTD_isError(remaining) || !Write(mOutBlock.data(), output.pos)) {
+						return false;
+					}
+					if (directive == ZSTD_e_continue ? input.pos == input.size : remaining == 0) {
+						return true;
+					}
+				}
+			}
+#endif
+			default:
+				return false;
+			}
+		}
+
+		bool Write(const char* data, size_t size)
+		{
+			return size == 0 || mTarget.sputn(data, static_cast<std::streamsize>(size)) == static_cast<std::streamsize>(size);
+		}
+
+		std::streambuf& mTarget;
+		const CompressionType mCompression;
+		std::vector<char> mInBlock;
+		std::vector<char> mOutBlock;
+		bool mIsFinished = false;
+#if defined BITSERIALIZER_HAS_ZLIB
+		z_stream mZStream{};
+		bool mIsZStreamInitialized = false;
+#endif
+#if defined BITSERIALIZER_HAS_ZSTD
+		ZSTD_CCtx* mZstdContext = nullptr;
+#endif
+	};
+}
@@ -3,9 +3,130 @@
 * This file is part of BitSerializer library, licensed under the MIT license.  *
 *******************************************************************************/
 #pragma once
+#include <algorithm>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <vector>
+#include "archive_traits.h"
+#include "serialization_context.h"
+#include "thread_pool.h"
 
 namespace BitSerializer::Detail
 {
+	/// <summary>
+	/// Checks that the container has random access iterators (required for parallel processing).
+	/// </summary>
+	template <typename TContainer>
+	constexpr bool is_random_access_container_v = std::is_base_of_v<std::random_access_iterator_tag,
+		typename std::iterator_traits<typename TContainer::iterator>::iterator_category>;
+
+	/// <summary>
+	/// Returns the number of shards for processing array in parallel (zero when array should be processed sequentially).
+	/// </summary>
+	inline size_t GetShardsNumber(const ParallelOptions& parallelOptions, size_t itemsNum)
+	{
+		if (itemsNum == 0 || itemsNum < parallelOptions.minArraySize || ThreadPool::IsWorkerThread()) {
+			return 0;
+		}
+
+		// The array is split into the number of shards that equals to the number of threads (including the calling thread)
+		const size_t threadsNum = parallelOptions.maxThreads == 0 ? ThreadPool::GetDefault().GetThreadsNumber() + 1 : parallelOptions.maxThreads;
+		const size_t shardsNum = std::min(threadsNum, itemsNum);
+		return shardsNum < 2 ? 0 : shardsNum;
+	}
+
+	/// <summary>
+	/// Loads items of large array in parallel (when it is enabled in the options and supported by archive).
+	/// The container is pre-sized and each thread loads its own range of items via the shard of array scope,
+	/// validation errors are collected in separate contexts and merged at the end.
+	/// Returns `false` when the array was not loaded (should be loaded sequentially).
+	/// </summary>
+	template<typename TArchive, typename TContainer>
+	bool LoadContainerInParallel(TArchive& arrayScope, TContainer& cont)
+	{
+		const auto& parallelOptions = arrayScope.GetOptions().parallelOptions;
+		if (!parallelOptions.enableParallelLoad) {
+			return false;
+		}
+
+		// Archives which support shards return the exact number of items
+		const size_t itemsNum = arrayScope.GetEstimatedSize();
+		const size_t shardsNum = GetShardsNumber(parallelOptions, itemsNum);
+		if (shardsNum == 0) {
+			return false;
+		}
+
+		cont.resize(itemsNum);
+		std::vector<SerializationContext> shardContexts;
+		shardContexts.reserve(shardsNum);
+		for (size_t i = 0; i < shardsNum; ++i) {
+			shardContexts.emplace_back(arrayScope.GetOptions());
+		}
+
+		ThreadPool::GetDefault().ParallelFor(shardsNum, [&arrayScope, &cont, &shardContexts, itemsNum, shardsNum](size_t shardIndex)
+		{
+			const size_t startIndex = itemsNum * shardIndex / shardsNum;
+			const size_t endIndex = itemsNum * (shardIndex + 1) / shardsNum;
+			auto shardScope = arrayScope.CreateShard(startIndex, shardContexts[shardIndex]);
+			for (size_t i = startIndex; i < endIndex; ++i)
+			{
+				Serialize(shardScope, cont[i]);
+			}
+		});
+
+		for (auto& shardContext : shardContexts) {
+			arrayScope.GetContext().MergeValidationErrors(shardContext);
+		}
+		return true;
+	}
+
+	/// <summary>
+	/// Saves items of large array in parallel (when it is enabled in the options and supported by archive).
+	/// Each thread saves its own range of items into the shard of array scope (with separate output),
+	/// then shards are merged into the array scope in original order.
+	/// Returns `false` when the array was not saved (should be saved sequentially).
+	/// </summary>
+	template<typename TArchive, typename TContainer>
+	bool SaveContainerInParallel(TArchive& arrayScope, TContainer& cont)
+	{
+		const auto& parallelOptions = arrayScope.GetOptions().parallelOptions;
+		if (!parallelOptions.enableParallelSave || !arrayScope.CanCreateShards()) {
+			return false;
+		}
+
+		const size_t itemsNum = cont.size();
+		const size_t shardsNum = GetShardsNumber(parallelOptions, itemsNum);
+		if (shardsNum == 0) {
+			return false;
+		}
+
+		using TShardOutput = decltype(arrayScope.CreateShard(std::declval<SerializationContext&>(), size_t()).FinalizeShard());
+		std::vector<std::optional<TShardOutput>> shardOutputs(shardsNum);
+		std::vector<SerializationContext> shardContexts;
+		shardContexts.reserve(shardsNum);
+		for (size_t i = 0; i < shardsNum; ++i) {
+			shardContexts.emplace_back(arrayScope.GetOptions());
+		}
+
+		ThreadPool::GetDefault().ParallelFor(shardsNum, [&arrayScope, &cont, &shardOutputs, &shardContexts, itemsNum, shardsNum](size_t shardIndex)
+		{
+			const size_t startIndex = itemsNum * shardIndex / shardsNum;
+			const size_t endIndex = itemsNum * (shardIndex + 1) / shardsNum;
+			auto shardScope = arrayScope.CreateShard(shardContexts[shardIndex], endIndex - startIndex);
+			for (size_t i = startIndex; i < endIndex; ++i)
+			{
+				Serialize(shardScope, cont[i]);
+			}
+			shardOutputs[shardIndex].emplace(shardScope.FinalizeShard());
+		});
+
+		for (auto& shardOutput : shardOutputs) {
+			arrayScope.MergeShard(std::move(*shardOutput));
+		}
+		return true;
+	}
+
 	/// <summary>
 	/// Generic function for serialization containers.
 	/// </summary>
@@ -14,6 +135,13 @@ namespace BitSerializer::Detail
 	{
 		if constexpr (TArchive::IsLoading())
 		{
+			if constexpr (can_create_shard_v<TArchive> && is_random_access_container_v<TContainer>)
+			{
+				if (LoadContainerInParallel(arrayScope, cont)) {
+					return;
+				}
+			}
+
 			// Resize container when is known approximate size
 			if (const auto estimatedSize = arrayScope.GetEstimatedSize(); estimatedSize != 0)
 			{
@@ -39,6 +167,13 @@ namespace BitSerializer::Detail
 		}
 		else
 		{
+			if constexpr (can_save_by_shards_v<TArchive> && is_random_access_container_v<TContainer>)
+			{
+				if (SaveContainerInParallel(arrayScope, cont)) {
+					return;
+				}
+			}
+
 			for (auto& value : cont)
 			{
 				Serialize(arrayScope, value);
@@ -3,12 +3,55 @@
 * This file is part of BitSerializer library, licensed under the MIT license.  *
 *******************************************************************************/
 #pragma once
+#include <string>
+#include <string_view>
 #include <tuple>
+#include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include "serialization_context.h"
 
 namespace BitSerializer {
 
+namespace Detail
+{
+	/// <summary>
+	/// Checks that the key is a constant array of characters (e.g. string literal) which can be cached by its address.
+	/// </summary>
+	template <class TKey>
+	constexpr bool is_cacheable_key_v = std::is_array_v<std::remove_reference_t<TKey>> && std::is_const_v<std::remove_extent_t<std::remove_reference_t<TKey>>>;
+
+	/// <summary>
+	/// Converts the constant array of characters (e.g. string literal) to the key type of archive.
+	/// The converted key is cached by the address of array, so the conversion is performed only once (per thread).
+	/// As local arrays can be placed at the same address in different calls, the cache is keyed by address and source text.
+	/// </summary>
+	template <class TArchiveKey, class TSym, size_t N>
+	const TArchiveKey& GetAdaptedKey(const TSym(&key)[N])
+	{
+		struct AdaptedKey
+		{
+			std::basic_string<TSym> sourceKey;
+			TArchiveKey archiveKey;
+		};
+
+		const TSym* nullPos = std::char_traits<TSym>::find(key, N, TSym());
+		const std::basic_string_view<TSym> sourceKey(key, nullPos ? static_cast<size_t>(nullPos - key) : N);
+
+		thread_local std::unordered_multimap<const TSym*, AdaptedKey> adaptedKeys;
+		const auto range = adaptedKeys.equal_range(key);
+		for (auto it = range.first; it != range.second; ++it)
+		{
+			if (it->second.sourceKey == sourceKey) {
+				return it->second.archiveKey;
+			}
+		}
+		// Existing entries are never overwritten, as references to them can be still in use
+		const auto it = adaptedKeys.emplace(key, AdaptedKey{ std::basic_string<TSym>(sourceKey), Convert::To<TArchiveKey>(sourceKey) });
+		return it->second.archiveKey;
+	}
+}
+
 /// <summary>
 /// The wrapper for key, value and set of validators.
 /// </summary>
@@ -85,13 +128,23 @@ public:
 
 	/// <summary>
 	/// Adapts the key to target archive and move to base KeyValue type.
+	/// The converted string literals are cached, so the base KeyValue will hold a reference to the cached key.
 	/// </summary>
 	template<class TArchiveKey>
-	KeyValue<TArchiveKey, TValue, Validators...> AdaptAndMoveToBaseKeyValue()
+	auto AdaptAndMoveToBaseKeyValue()
 	{
-		auto archiveCompatibleKey = Convert::To<TArchiveKey>(this->GetKey());
-		return BitSerializer::KeyValue<TArchiveKey, TValue, Validators...>(
-			std::move(archiveCompatibleKey), this->GetValue(), std::move(this->mValidators));
+		if constexpr (Detail::is_cacheable_key_v<TKey>)
+		{
+			const TArchiveKey& archiveCompatibleKey = Detail::GetAdaptedKey<TArchiveKey>(this->GetKey());
+			return BitSerializer::KeyValue<const TArchiveKey&, TValue, Validators...>(
+				archiveCompatibleKey, this->GetValue(), std::move(this->mValidators));
+		}
+		else
+		{
+			auto archiveCompatibleKey = Convert::To<TArchiveKey>(this->GetKey());
+			return BitSerializer::KeyValue<TArchiveKey, TValue, Validators...>(
+				std::move(archiveCompatibleKey), this->GetValue(), std::move(this->mValidators));
+		}
 	}
 };
 
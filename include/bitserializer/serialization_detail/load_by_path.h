@@ -0,0 +1,227 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include <charconv>
+#include <string>
+#include <string_view>
+#include "bitserializer/serialization_detail/serialization_base_types.h"
+
+namespace BitSerializer::Detail
+{
+	/// <summary>
+	/// Takes the next segment from the path in JSON Pointer style (RFC 6901), where "~1" and "~0" are unescaped to separator and "~".
+	/// </summary>
+	inline std::string TakePathSegment(std::string_view& path, char separator)
+	{
+		path.remove_prefix(1);
+		const size_t endPos = path.find(separator);
+		const std::string_view encodedSegment = path.substr(0, endPos);
+		path = endPos == std::string_view::npos ? std::string_view() : path.substr(endPos);
+
+		std::string segment;
+		segment.reserve(encodedSegment.size());
+		for (size_t i = 0; i < encodedSegment.size(); ++i)
+		{
+			if (encodedSegment[i] == '~' && i + 1 < encodedSegment.size() && (encodedSegment[i + 1] == '0' || encodedSegment[i + 1] == '1'))
+			{
+				segment.push_back(encodedSegment[++i] == '0' ? '~' : separator);
+				continue;
+			}
+			segment.push_back(encodedSegment[i]);
+		}
+		return segment;
+	}
+
+	/// <summary>
+	/// Checks at compile time that the value can be loaded without key (from the root or array scope).
+	/// </summary>
+	template <typename TScope, typename T>
+	constexpr bool CanLoadValue()
+	{
+		if constexpr (has_global_serialize_array_v<T>) {
+			return can_serialize_array_v<TScope>;
+		}
+		else if constexpr (has_serialize_method_v<T> || has_global_serialize_object_v<T>) {
+			return can_serialize_object_v<TScope>;
+		}
+		else if constexpr (std::is_enum_v<T>) {
+			return can_serialize_value_v<TScope, std::string>;
+		}
+		else {
+			return can_serialize_value_v<TScope, T>;
+		}
+	}
+
+	/// <summary>
+	/// Checks at compile time that the value can be loaded by key (from the object scope).
+	/// </summary>
+	template <typename TScope, typename TKey, typename T>
+	constexpr bool CanLoadValueWithKey()
+	{
+		if constexpr (has_global_serialize_array_v<T>) {
+			return can_serialize_array_with_key_v<TScope, TKey>;
+		}
+		else if constexpr (has_serialize_method_v<T> || has_global_serialize_object_v<T>) {
+			return can_serialize_object_with_key_v<TScope, TKey>;
+		}
+		else if constexpr (std::is_enum_v<T>) {
+			return can_serialize_value_with_key_v<TScope, std::string, TKey>;
+		}
+		else {
+			return can_serialize_value_with_key_v<TScope, T, TKey>;
+		}
+	}
+
+	template <typename TKey, typename TScope, typename T>
+	bool LoadArrayItemByPath(TScope& arrayScope, std::string_view path, char separator, T& target);
+
+	/// <summary>
+	/// Loads the value which is addressed by the rest of path in the object scope, other values are not loaded.
+	/// </summary>
+	template <typename TKey, typename TScope, typename T>
+	bool LoadObjectItemByPath(TScope& objectScope, std::string_view path, char separator, T& target)
+	{
+		const auto key = Convert::To<TKey>(TakePathSegment(path, separator));
+		if (path.empty())
+		{
+			if constexpr (CanLoadValueWithKey<TScope, TKey, T>()) {
+				return Serialize(objectScope, key, target);
+			}
+			return false;
+		}
+
+		if constexpr (can_serialize_object_with_key_v<TScope, TKey>)
+		{
+			if (auto childScope = objectScope.OpenObjectScope(key)) {
+				return LoadObjectItemByPath<TKey>(*childScope, path, separator, target);
+			}
+		}
+		if constexpr (can_serialize_array_with_key_v<TScope, TKey>)
+		{
+			if (auto childScope = objectScope.OpenArrayScope(key, 0)) {
+				return LoadArrayItemByPath<TKey>(*childScope, path, separator, target);
+			}
+		}
+		return false;
+	}
+
+	/// <summary>
+	/// Loads the next item of array scope (when the path is empty) or goes deeper into it as object or array.
+	/// </summary>
+	template <typename TKey, typename TScope, typename T>
+	bool LoadNextArrayItemByPath(TScope& arrayScope, std::string_view path, char separator, T& target, bool isNestedArray)
+	{
+		if (path.empty())
+		{
+			if constexpr (CanLoadValue<TScope, T>()) {
+				return Serialize(arrayScope, target);
+			}
+			return false;
+		}
+
+		if (!isNestedArray)
+		{
+			if constexpr (can_serialize_object_v<TScope>)
+			{
+				if (auto childScope = arrayScope.OpenObjectScope()) {
+					return LoadObjectItemByPath<TKey>(*childScope, path, separator, target);
+				}
+			}
+		}
+		else if constexpr (can_serialize_array_v<TScope>)
+		{
+			if (auto childScope = arrayScope.OpenArrayScope(0)) {
+				return LoadArrayItemByPath<TKey>(*childScope, path, separator, target);
+			}
+		}
+		return false;
+	}
+
+	/// <summary>
+	/// Loads the value which is addressed by the rest of path in the array scope.
+	/// Archives which support shards jump directly to the item, others skip preceding items without loading them.
+	/// </summary>
+	template <typename TKey, typename TScope, typename T>
+	bool LoadArrayItemByPath(TScope& arrayScope, std::string_view path, char separator, T& target)
+	{
+		const auto segment = TakePathSegment(path, separator);
+		size_t index = 0;
+		if (const auto [ptr, ec] = std::from_chars(segment.data(), segment.data() + segment.size(), index);
+			segment.empty() || ec != std::errc() || ptr != segment.data() + segment.size())
+		{
+			return false;
+		}
+
+		if constexpr (can_create_shard_v<TScope>)
+		{
+			if (index >= arrayScope.GetEstimatedSize()) {
+				return false;
+			}
+			// Opening the item consumes it, so the separate shard is needed for the second try as nested array
+			auto itemScope = arrayScope.CreateShard(index, arrayScope.GetContext());
+			if (LoadNextArrayItemByPath<TKey>(itemScope, path, separator, target, false)) {
+				return true;
+			}
+			if (!path.empty())
+			{
+				auto nestedArrayScope = arrayScope.CreateShard(index, arrayScope.GetContext());
+				return LoadNextArrayItemByPath<TKey>(nestedArrayScope, path, separator, target, true);
+			}
+			return false;
+		}
+		else
+		{
+			static_assert(can_serialize_object_v<TScope>, "BitSerializer. The archive doesn't support skipping items of array.");
+			for (size_t i = 0; i < index; ++i)
+			{
+				if (arrayScope.IsEnd()) {
+					return false;
+				}
+				arrayScope.OpenObjectScope();
+			}
+			return !arrayScope.IsEnd() && LoadNextArrayItemByPath<TKey>(arrayScope, path, separator, target, false);
+		}
+	}
+
+	/// <summary>
+	/// Loads only the value which is addressed by the path in JSON Pointer style (e.g. "/config/limits/0").
+	/// The empty path addresses the whole document. Returns `false` when the path is not found.
+	/// </summary>
+	template <typename TArchive, typename T>
+	bool LoadByPath(TArchive& archive, std::string_view path, T& target)
+	{
+		using key_type = typename TArchive::key_type;
+		constexpr char separator = TArchive::path_separator;
+		if (path.empty())
+		{
+			if constexpr (CanLoadValue<TArchive, T>()) {
+				return Serialize(archive, target);
+			}
+			return false;
+		}
+		if (path.front() != separator) {
+			throw SerializationException(SerializationErrorCode::InvalidOptions, "The path should start with '" + std::string(1, separator) + "': " + std::string(path));
+		}
+
+		if constexpr (can_serialize_object_v<TArchive>)
+		{
+			if (auto objectScope = archive.OpenObjectScope()) {
+				return LoadObjectItemByPath<key_type>(*objectScope, path, separator, target);
+			}
+		}
+		else if constexpr (can_serialize_object_with_key_v<TArchive, key_type>)
+		{
+			// The root object is named (e.g. XML), the first segment of path is the name of root element
+			return LoadObjectItemByPath<key_type>(archive, path, separator, target);
+		}
+		if constexpr (can_serialize_array_v<TArchive>)
+		{
+			if (auto arrayScope = archive.OpenArrayScope(0)) {
+				return LoadArrayItemByPath<key_type>(*arrayScope, path, separator, target);
+			}
+		}
+		return false;
+	}
+}
@@ -99,7 +99,7 @@ namespace BitSerializer
 	namespace Detail
 	{
 		template <class TValue, std::enable_if_t<std::is_enum_v<TValue>, int> = 0>
-		bool ConvertStringToEnumByPolicy(const std::string& str, TValue& out_value, MismatchedTypesPolicy policy)
+		bool ConvertStringToEnumByPolicy(std::string_view str, TValue& out_value, MismatchedTypesPolicy policy)
 		{
 			try
 			{
@@ -111,7 +111,7 @@ namespace BitSerializer
 				if (policy == MismatchedTypesPolicy::ThrowError)
 				{
 					throw SerializationException(SerializationErrorCode::MismatchedTypes,
-						"The string (" + str + ") cannot be converted to target enum");
+						"The string (" + std::string(str) + ") cannot be converted to target enum");
 				}
 			}
 			catch (...) {
@@ -124,7 +124,16 @@ namespace BitSerializer
 	template <class TArchive, typename TKey, class TValue, std::enable_if_t<std::is_enum_v<TValue>, int> = 0>
 	bool Serialize(TArchive& archive, TKey&& key, TValue& value)
 	{
-		if constexpr (TArchive::IsLoading())
+		if constexpr (TArchive::IsLoading() && can_load_string_view_with_key_v<TArchive, TKey>)
+		{
+			// Parse the name directly from the archive's buffer
+			std::string_view str;
+			if (archive.LoadStringView(std::forward<TKey>(key), str)) {
+				return Detail::ConvertStringToEnumByPolicy(str, value, archive.GetOptions().mismatchedTypesPolicy);
+			}
+			return false;
+		}
+		else if constexpr (TArchive::IsLoading())
 		{
 			std::string str;
 			if (Serialize(archive, std::forward<TKey>(key), str)) {
@@ -143,7 +152,16 @@ namespace BitSerializer
 	template <class TArchive, class TValue, std::enable_if_t<std::is_enum_v<TValue>, int> = 0>
 	bool Serialize(TArchive& archive, TValue& value)
 	{
-		if constexpr (TArchive::IsLoading())
+		if constexpr (TArchive::IsLoading() && can_load_string_view_v<TArchive>)
+		{
+			// Parse the name directly from the archive's buffer
+			std::string_view str;
+			if (archive.LoadStringView(str)) {
+				return Detail::ConvertStringToEnumByPolicy(str, value, archive.GetOptions().mismatchedTypesPolicy);
+			}
+			return false;
+		}
+		else if constexpr (TArchive::IsLoading())
 		{
 			std::string str;
 			if (Serialize(archive, str)) {
@@ -3,25 +3,74 @@
 * This file is part of BitSerializer library, licensed under the MIT license.  *
 *******************************************************************************/
 #pragma once
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
 #include "serialization_options.h"
 #include "errors_handling.h"
 
 namespace BitSerializer
 {
+	/// <summary>
+	/// Storage for resources which archives can reuse between serialization calls (DOM allocators, trees, buffers).
+	/// It is owned by the `SerializerSession` and is not thread-safe.
+	/// </summary>
+	class SessionResources
+	{
+	public:
+		/// <summary>
+		/// Returns the resource of specified type (it is created by default constructor at first request).
+		/// </summary>
+		template <typename T>
+		T& Get()
+		{
+			const void* typeId = GetTypeId<T>();
+			for (auto& [resourceTypeId, resource] : mResources)
+			{
+				if (resourceTypeId == typeId) {
+					return *static_cast<T*>(resource.get());
+				}
+			}
+			auto resource = std::make_shared<T>();
+			T& ref = *resource;
+			mResources.emplace_back(typeId, std::move(resource));
+			return ref;
+		}
+
+	private:
+		template <typename T>
+		static const void* GetTypeId() noexcept
+		{
+			static constexpr char id = 0;
+			return &id;
+		}
+
+		std::vector<std::pair<const void*, std::shared_ptr<void>>> mResources;
+	};
+
 	/// <summary>
 	/// Serialization context - stores all necessary information about current serialization session (options, validation errors).
 	/// </summary>
 	class SerializationContext
 	{
 	public:
-		explicit SerializationContext(const SerializationOptions& serializationOptions)
+		explicit SerializationContext(const SerializationOptions& serializationOptions, SessionResources* sessionResources = nullptr)
 			: mSerializationOptions(serializationOptions)
+			, mSessionResources(sessionResources)
 		{ }
 
 		[[nodiscard]] const SerializationOptions& GetOptions() const noexcept {
 			return mSerializationOptions;
 		}
 
+		/// <summary>
+		/// Returns the resources of the serializer session or `nullptr` when serialization is called without session.
+		/// </summary>
+		[[nodiscard]] SessionResources* GetSessionResources() const noexcept {
+			return mSessionResources;
+		}
+
 		void AddValidationError(std::string path, std::string errorMsg)
 		{
 			if (const auto it = mErrorsMap.find(path); it == mErrorsMap.end()) {
@@ -32,6 +81,19 @@ namespace BitSerializer
 			}
 		}
 
+		/// <summary>
+		/// Moves validation errors from other context (used for merging results of parallel loading).
+		/// </summary>
+		void MergeValidationErrors(SerializationContext& other)
+		{
+			for (auto& [path, errors] : other.mErrorsMap)
+			{
+				auto& targetErrors = mErrorsMap[path];
+				targetErrors.insert(targetErrors.end(), std::make_move_iterator(errors.begin()), std::make_move_iterator(errors.end()));
+			}
+			other.mErrorsMap.clear();
+		}
+
 		void OnFinishSerialization()
 		{
 			if (!mErrorsMap.empty()) {
@@ -42,5 +104,6 @@ namespace BitSerializer
 	private:
 		ValidationMap mErrorsMap;
 		const SerializationOptions& mSerializationOptions;
+		SessionResources* mSessionResources;
 	};
 }
@@ -3,6 +3,7 @@
 * This file is part of BitSerializer library, licensed under the MIT license.  *
 *******************************************************************************/
 #pragma once
+#include <cstddef>
 #include <cstdint>
 #include "bitserializer/conversion_detail/convert_utf.h"
 
@@ -30,6 +31,29 @@ namespace BitSerializer
 		uint16_t paddingCharNum = 1;
 	};
 
+	/// <summary>
+	/// Type of compression of streams and files.
+	/// </summary>
+	enum class CompressionType
+	{
+		/// <summary>
+		/// Data is not compressed.
+		/// </summary>
+		None,
+		/// <summary>
+		/// Deflate in the gzip container (requires zlib).
+		/// </summary>
+		Gzip,
+		/// <summary>
+		/// Deflate in the zlib container (requires zlib).
+		/// </summary>
+		Zlib,
+		/// <summary>
+		/// Zstandard frame (requires libzstd).
+		/// </summary>
+		Zstd
+	};
+
 	/// <summary>
 	/// Contains a set of options for output stream.
 	/// Some options cannot be applicable to all types of archive, in that case it will be ignored.
@@ -45,6 +69,53 @@ namespace BitSerializer
 		/// The encoding for output stream (applicable for formats which based on UTF encoded text).
 		/// </summary>
 		Convert::UtfType encoding = Convert::UtfType::Utf8;
+
+		/// <summary>
+		/// Compression of output stream (the compression of input stream is set by `inputCompression`).
+		/// </summary>
+		CompressionType compression = CompressionType::None;
+
+		/// <summary>
+		/// Compression of input stream, when it is `None` only gzip and zstd are detected automatically by magic bytes
+		/// (zlib stream has no reliable signature, so it should be set explicitly).
+		/// </summary>
+		CompressionType inputCompression = CompressionType::None;
+
+		/// <summary>
+		/// Compression level, zero means the default level of the selected algorithm.
+		/// </summary>
+		int compressionLevel = 0;
+	};
+
+	/// <summary>
+	/// Contains a set of options for parallel processing of large arrays.
+	/// Parallel processing is applicable only for archives which support it, in other cases arrays are processed sequentially.
+	/// </summary>
+	struct ParallelOptions
+	{
+		/// <summary>
+		/// Enables parallel loading of arrays (disabled by default).
+		/// Items of the array are loaded into a pre-sized container by several threads, so the serialization
+		/// functions of loading types must not have side effects which are not thread-safe.
+		/// </summary>
+		bool enableParallelLoad = false;
+
+		/// <summary>
+		/// Enables parallel saving of root arrays (disabled by default, supported by RapidJson, RapidYaml and CSV archives).
+		/// Each thread saves its part of array to the separate buffer, which are spliced into the output in original order.
+		/// </summary>
+		bool enableParallelSave = false;
+
+		/// <summary>
+		/// The minimum number of items in array for processing in parallel.
+		/// </summary>
+		size_t minArraySize = 10000;
+
+		/// <summary>
+		/// The number of threads (including the calling thread) for processing one array, zero means all threads of the pool.
+		/// When it exceeds the number of threads in the pool, the array is split into more parts which are processed by available threads.
+		/// </summary>
+		size_t maxThreads = 0;
 	};
 
 	/// <summary>
@@ -77,6 +148,27 @@ namespace BitSerializer
 		ThrowError
 	};
 
+	/// <summary>
+	/// Profile of parsing the input text (currently used only for XML format).
+	/// </summary>
+	enum class ParseProfile
+	{
+		/// <summary>
+		/// Parses only elements, attributes and escaped characters, without normalization of line endings and whitespaces in attributes.
+		/// The fastest way for loading documents which were generated by this library.
+		/// </summary>
+		Minimal,
+		/// <summary>
+		/// Default profile of the base library (comments and processing instructions are skipped).
+		/// </summary>
+		Default,
+		/// <summary>
+		/// Additionally parses the declaration and the document type definition (DOCTYPE) as nodes of document,
+		/// the document is not validated against DTD (the PugiXml library does not support it).
+		/// </summary>
+		Strict
+	};
+
 	/// <summary>
 	/// Contains a set of serialization options.
 	/// Some options cannot be applicable to all types of archive, in that case it will be ignored.
@@ -93,6 +185,11 @@ namespace BitSerializer
 		/// </summary>
 		StreamOptions streamOptions;
 
+		/// <summary>
+		/// Contains a set of options for parallel processing of large arrays.
+		/// </summary>
+		ParallelOptions parallelOptions;
+
 		/// <summary>
 		/// Policy for case when size of target type is not enough for loading number.
 		/// For example, when loading number is 500 but target type is char.
@@ -111,5 +208,11 @@ namespace BitSerializer
 		/// Values separator, currently used only for CSV format (allowed: ',', ';', '\t', ' ', '|').
 		/// </summary>
 		char valuesSeparator = ',';
+
+		/// <summary>
+		/// Profile of parsing the input text, currently used only for XML format.
+		/// </summary>
+		/// <seealso cref="ParseProfile" />
+		ParseProfile parseProfile = ParseProfile::Default;
 	};
 }
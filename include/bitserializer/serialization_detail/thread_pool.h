@@ -0,0 +1,203 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace BitSerializer
+{
+	/// <summary>
+	/// Simple pool of worker threads, used for parallel loading/saving of large arrays.
+	/// The thread which calls `ParallelFor()` also participates in the processing of tasks.
+	/// </summary>
+	class ThreadPool
+	{
+	public:
+		/// <summary>
+		/// Creates the pool with specified number of worker threads (by default - the number of hardware threads minus one for the calling thread).
+		/// </summary>
+		explicit ThreadPool(size_t threadsNum = GetDefaultThreadsNumber())
+		{
+			mThreads.reserve(threadsNum);
+			for (size_t i = 0; i < threadsNum; ++i)
+			{
+				mThreads.emplace_back([this]() { WorkerLoop(); });
+			}
+		}
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		~ThreadPool()
+		{
+			{
+				std::lock_guard lock(mMutex);
+				mIsStopping = true;
+			}
+			mCondition.notify_all();
+			for (auto& thread : mThreads)
+			{
+				thread.join();
+			}
+		}
+
+		/// <summary>
+		/// Returns the number of worker threads (without the calling thread).
+		/// </summary>
+		[[nodiscard]] size_t GetThreadsNumber() const noexcept {
+			return mThreads.size();
+		}
+
+		/// <summary>
+		/// Returns the default pool which is shared between all serialization sessions.
+		/// </summary>
+		static ThreadPool& GetDefault()
+		{
+			static ThreadPool threadPool;
+			return threadPool;
+		}
+
+		/// <summary>
+		/// Returns `true` when the current thread is a worker thread of one of pools.
+		/// </summary>
+		static bool IsWorkerThread() noexcept {
+			return GetWorkerThreadFlag();
+		}
+
+		/// <summary>
+		/// Calls `func(taskIndex)` for each task in range [0, tasksNum) and waits for completion.
+		/// The first exception (in order of tasks) is rethrown after all tasks have been finished.
+		/// Nested calls from worker threads are executed sequentially.
+		/// </summary>
+		template <typename TFunc>
+		void ParallelFor(size_t tasksNum, TFunc&& func)
+		{
+			if (tasksNum == 0) {
+				return;
+			}
+			if (tasksNum == 1 || mThreads.empty() || IsWorkerThread())
+			{
+				for (size_t i = 0; i < tasksNum; ++i) {
+					func(i);
+				}
+				return;
+			}
+
+			// The state is shared with helpers, which can be started after finishing all tasks
+			auto state = std::make_shared<ParallelForState>(tasksNum, std::ref(func));
+			const size_t helpersNum = std::min(tasksNum - 1, mThreads.size());
+			{
+				std::lock_guard lock(mMutex);
+				for (size_t i = 0; i < helpersNum; ++i) {
+					mTasks.emplace_back([state]() { state->ProcessTasks(); });
+				}
+			}
+			if (helpersNum == 1) {
+				mCondition.notify_one();
+			}
+			else {
+				mCondition.notify_all();
+			}
+
+			state->ProcessTasks();
+			state->Wait();
+
+			for (const auto& exceptionPtr : state->exceptions)
+			{
+				if (exceptionPtr) {
+					std::rethrow_exception(exceptionPtr);
+				}
+			}
+		}
+
+	private:
+		struct ParallelForState
+		{
+			ParallelForState(size_t tasksNum, std::function<void(size_t)> taskFunc)
+				: totalTasks(tasksNum)
+				, func(std::move(taskFunc))
+				, exceptions(tasksNum)
+			{ }
+
+			void ProcessTasks()
+			{
+				for (size_t taskIndex = nextTask++; taskIndex < totalTasks; taskIndex = nextTask++)
+				{
+					try {
+						func(taskIndex);
+					}
+					catch (...) {
+						exceptions[taskIndex] = std::current_exception();
+					}
+
+					if (++finishedTasks == totalTasks)
+					{
+						std::lock_guard lock(mutex);
+						condition.notify_all();
+					}
+				}
+			}
+
+			void Wait()
+			{
+				std::unique_lock lock(mutex);
+				condition.wait(lock, [this]() { return finishedTasks == totalTasks; });
+			}
+
+			const size_t totalTasks;
+			std::function<void(size_t)> func;
+			std::vector<std::exception_ptr> exceptions;
+			std::atomic<size_t> nextTask = 0;
+			std::atomic<size_t> finishedTasks = 0;
+			std::mutex mutex;
+			std::condition_variable condition;
+		};
+
+		static size_t GetDefaultThreadsNumber() noexcept
+		{
+			const size_t hardwareThreads = std::thread::hardware_concurrency();
+			return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+		}
+
+		static bool& GetWorkerThreadFlag() noexcept
+		{
+			thread_local bool isWorkerThread = false;
+			return isWorkerThread;
+		}
+
+		void WorkerLoop()
+		{
+			GetWorkerThreadFlag() = true;
+			while (true)
+			{
+				std::function<void()> task;
+				{
+					std::unique_lock lock(mMutex);
+					mCondition.wait(lock, [this]() { return mIsStopping || !mTasks.empty(); });
+					if (mTasks.empty()) {
+						return;
+					}
+					task = std::move(mTasks.front());
+					mTasks.pop_front();
+				}
+				task();
+			}
+		}
+
+		std::vector<std::thread> mThreads;
+		std::deque<std::function<void()>> mTasks;
+		std::mutex mMutex;
+		std::condition_variable mCondition;
+		bool mIsStopping = false;
+	};
+}
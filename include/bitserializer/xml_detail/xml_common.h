@@ -0,0 +1,83 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include <string>
+#include <string_view>
+#include "bitserializer/serialization_detail/archive_base.h"
+
+namespace BitSerializer::Xml::Detail {
+
+/// <summary>
+/// The traits of XML archive, which reads and writes XML directly (without building the document in memory).
+/// </summary>
+struct XmlStreamingArchiveTraits
+{
+	static constexpr ArchiveType archive_type = ArchiveType::Xml;
+	using key_type = std::string;
+	using supported_key_types = TSupportedKeyTypes<key_type, const char*>;
+	using preferred_output_format = std::string;
+	using preferred_stream_char_type = char;
+	static constexpr char path_separator = '/';
+
+protected:
+	~XmlStreamingArchiveTraits() = default;
+};
+
+namespace XmlExtensions
+{
+	/// <summary>
+	/// Appends the text with escaping special characters, the runs of characters without escaping are appended at once.
+	/// </summary>
+	inline void AppendEscaped(std::string& outputStr, std::string_view str, bool isAttribute)
+	{
+		const char* it = str.data();
+		const char* const endIt = it + str.size();
+		while (it != endIt)
+		{
+			const char* runIt = it;
+			for (; runIt != endIt; ++runIt)
+			{
+				const auto sym = static_cast<unsigned char>(*runIt);
+				if (sym == '&' || sym == '<' || sym == '>' || (sym < 0x20 && (isAttribute || (sym != '\t' && sym != '\n' && sym != '\r')))
+					|| (isAttribute && sym == '"'))
+				{
+					break;
+				}
+			}
+			outputStr.append(it, runIt);
+			if (runIt == endIt) {
+				break;
+			}
+
+			switch (const auto sym = static_cast<unsigned char>(*runIt))
+			{
+			case '&':
+				outputStr.append("&amp;");
+				break;
+			case '<':
+				outputStr.append("&lt;");
+				break;
+			case '>':
+				outputStr.append("&gt;");
+				break;
+			case '"':
+				outputStr.append("&quot;");
+				break;
+			default:
+				// Control characters are written as numeric character references
+				outputStr.append("&#");
+				if (sym >= 10) {
+					outputStr.push_back(static_cast<char>('0' + sym / 10));
+				}
+				outputStr.push_back(static_cast<char>('0' + sym % 10));
+				outputStr.push_back(';');
+				break;
+			}
+			it = runIt + 1;
+		}
+	}
+}
+
+}
@@ -0,0 +1,1146 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <charconv>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "bitserializer/serialization_detail/archive_base.h"
+#include "bitserializer/serialization_detail/errors_handling.h"
+#include "bitserializer/xml_detail/xml_common.h"
+
+namespace BitSerializer::Xml::Detail {
+
+/// <summary>
+/// Pull parser, which reads XML sequentially element by element, without building the document in memory.
+/// Supports the subset of XML which is used for serialization: elements, attributes, text, entities and CDATA sections
+/// (the declaration, DOCTYPE, comments and processing instructions are skipped). Text is decoded to UTF-8.
+/// </summary>
+class XmlPullReader
+{
+public:
+	using attributes_type = std::vector<std::pair<std::string, std::string>>;
+
+	enum class Token
+	{
+		StartElement,
+		Text,
+		EndElement
+	};
+
+	/// <summary>
+	/// Creates the reader from the UTF-8 string (the string must outlive the reader).
+	/// </summary>
+	explicit XmlPullReader(std::string_view inputStr)
+		: mData(inputStr)
+	{
+		// Skip UTF-8 BOM
+		if (mData.size() >= 3 && mData.compare(0, 3, "\xEF\xBB\xBF") == 0) {
+			mPos = 3;
+		}
+	}
+
+	/// <summary>
+	/// Creates the reader from the stream in any UTF encoding (decodes it to UTF-8 by chunks).
+	/// </summary>
+	explicit XmlPullReader(std::istream& inputStream)
+		: mEncodedStreamReader(std::make_unique<Convert::CEncodedStreamReader<Convert::Utf8>>(inputStream))
+	{ }
+
+	/// <summary>
+	/// Creates the reader from the element, which was captured by another reader (the path prefix is used for error messages).
+	/// </summary>
+	XmlPullReader(std::string&& capturedXml, std::string pathPrefix)
+		: mBuffer(std::move(capturedXml))
+		, mData(mBuffer)
+		, mPathPrefix(std::move(pathPrefix))
+	{ }
+
+	XmlPullReader(const XmlPullReader&) = delete;
+	XmlPullReader& operator=(const XmlPullReader&) = delete;
+
+	/// <summary>
+	/// Skips the prolog and reads the start tag of the root element, returns `false` when there is no root element.
+	/// </summary>
+	bool ReadRootElement()
+	{
+		assert(mDepth == 0);
+		while (true)
+		{
+			SkipWhitespaces();
+			if (!EnsureAvailable(1)) {
+				return false;
+			}
+			if (mData[mPos] != '<') {
+				ThrowParsingError("Unexpected text before the root element");
+			}
+
+			if (StartsWith("<?")) {
+				SkipUntil("?>", 2);
+			}
+			else if (StartsWith("<!--")) {
+				SkipUntil("-->", 4);
+			}
+			else if (StartsWith("<!DOCTYPE")) {
+				SkipDoctype();
+			}
+			else
+			{
+				ReadStartTag();
+				return true;
+			}
+		}
+	}
+
+	/// <summary>
+	/// Reads the next token in the content of current element, the text is appended to the passed string (when it is not null).
+	/// When the end tag is reached, the current element becomes the parent.
+	/// </summary>
+	Token ReadNext(std::string* text)
+	{
+		assert(mDepth != 0);
+		if (mIsEmptyElement)
+		{
+			mIsEmptyElement = false;
+			--mDepth;
+			return Token::EndElement;
+		}
+
+		bool hasText = false;
+		while (true)
+		{
+			if (!EnsureAvailable(1)) {
+				ThrowParsingError("Unexpected end of XML document");
+			}
+			if (mData[mPos] != '<')
+			{
+				ReadText('<', text);
+				hasText = true;
+			}
+			else if (StartsWith("<!--")) {
+				SkipUntil("-->", 4);
+			}
+			else if (StartsWith("<![CDATA["))
+			{
+				SkipUntil("]]>", 9, text);
+				hasText = true;
+			}
+			else if (StartsWith("<?")) {
+				SkipUntil("?>", 2);
+			}
+			else if (hasText) {
+				return Token::Text;
+			}
+			else if (StartsWith("</"))
+			{
+				ReadEndTag();
+				return Token::EndElement;
+			}
+			else
+			{
+				ReadStartTag();
+				return Token::StartElement;
+			}
+		}
+	}
+
+	/// <summary>
+	/// Reads the start tag of the next child element, returns `false` when the end of current element is reached.
+	/// </summary>
+	bool ReadChildElement()
+	{
+		while (true)
+		{
+			const auto token = ReadNext(nullptr);
+			if (token == Token::StartElement) {
+				return true;
+			}
+			if (token == Token::EndElement) {
+				return false;
+			}
+		}
+	}
+
+	/// <summary>
+	/// Reads the text of current element up to its end tag (child elements are skipped).
+	/// Returns null when the element does not contain text, like PugiXml, the text consisting of only whitespaces is not treated as a value.
+	/// </summary>
+	const std::string* ReadText()
+	{
+		mText.clear();
+		while (true)
+		{
+			const auto token = ReadNext(&mText);
+			if (token == Token::EndElement) {
+				break;
+			}
+			if (token == Token::StartElement) {
+				SkipElement();
+			}
+		}
+
+		const auto isWhitespace = [](char sym) { return sym == ' ' || sym == '\t' || sym == '\n' || sym == '\r'; };
+		return std::all_of(mText.cbegin(), mText.cend(), isWhitespace) ? nullptr : &mText;
+	}
+
+	/// <summary>
+	/// Checks that the content of current element starts with a child element (leading whitespaces and comments are skipped).
+	/// </summary>
+	bool HasChildElements()
+	{
+		if (mIsEmptyElement) {
+			return false;
+		}
+		while (true)
+		{
+			SkipWhitespaces();
+			if (StartsWith("<!--")) {
+				SkipUntil("-->", 4);
+			}
+			else if (StartsWith("<?")) {
+				SkipUntil("?>", 2);
+			}
+			else
+			{
+				return EnsureAvailable(2) && mData[mPos] == '<' && mData[mPos + 1] != '/' && mData[mPos + 1] != '!';
+			}
+		}
+	}
+
+	/// <summary>
+	/// Skips the rest of current element including its end tag.
+	/// </summary>
+	void SkipElement()
+	{
+		for (const size_t depth = mDepth; mDepth >= depth;) {
+			ReadNext(nullptr);
+		}
+	}
+
+	/// <summary>
+	/// Skips the rest of nested elements until the specified depth.
+	/// </summary>
+	void SkipTo(size_t depth)
+	{
+		while (mDepth > depth) {
+			SkipElement();
+		}
+	}
+
+	/// <summary>
+	/// Reads the rest of current element (which start tag has been read) and appends it to the output as XML.
+	/// </summary>
+	void CaptureElement(std::string& outputXml)
+	{
+		const size_t depth = mDepth;
+		outputXml.push_back('<');
+		outputXml.append(mElements[depth - 1]);
+		for (const auto& [name, value] : mAttributes)
+		{
+			outputXml.push_back(' ');
+			outputXml.append(name);
+			outputXml.append("=\"");
+			XmlExtensions::AppendEscaped(outputXml, value, true);
+			outputXml.push_back('"');
+		}
+		outputXml.push_back('>');
+
+		while (true)
+		{
+			mText.clear();
+			const auto token = ReadNext(&mText);
+			if (token == Token::Text) {
+				XmlExtensions::AppendEscaped(outputXml, mText, false);
+			}
+			else if (token == Token::StartElement) {
+				CaptureElement(outputXml);
+			}
+			else
+			{
+				// The name of closed element is kept in the stack until the next element at the same level
+				outputXml.append("</");
+				outputXml.append(mElements[depth - 1]);
+				outputXml.push_back('>');
+				return;
+			}
+		}
+	}
+
+	/// <summary>
+	/// Returns the depth of current element (the root element has depth 1).
+	/// </summary>
+	[[nodiscard]] size_t GetDepth() const noexcept {
+		return mDepth;
+	}
+
+	[[nodiscard]] const std::string& GetElementName() const noexcept
+	{
+		assert(mDepth != 0);
+		return mElements[mDepth - 1];
+	}
+
+	/// <summary>
+	/// Moves out the attributes of the last read start tag.
+	/// </summary>
+	attributes_type TakeAttributes() noexcept {
+		return std::move(mAttributes);
+	}
+
+	/// <summary>
+	/// Gets the path to the element at the specified depth (names are separated by '/').
+	/// </summary>
+	[[nodiscard]] std::string GetPath(size_t depth) const
+	{
+		assert(depth <= mElements.size());
+		std::string path = mPathPrefix;
+		for (size_t i = 0; i < depth; ++i)
+		{
+			path.push_back(XmlStreamingArchiveTraits::path_separator);
+			path.append(mElements[i]);
+		}
+		return path;
+	}
+
+	[[nodiscard]] std::string GetPath() const {
+		return GetPath(mDepth);
+	}
+
+private:
+	bool ReadNextChunk()
+	{
+		if (!mEncodedStreamReader) {
+			return false;
+		}
+
+		// Discard the parsed part of buffer
+		mDiscardedSize += mPos;
+		mBuffer.erase(0, mPos);
+		mPos = 0;
+		const bool result = mEncodedStreamReader->ReadChunk(mBuffer);
+		mData = mBuffer;
+		return result;
+	}
+
+	bool EnsureAvailable(size_t size)
+	{
+		while (mData.size() - mPos < size)
+		{
+			if (!ReadNextChunk()) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool StartsWith(std::string_view str)
+	{
+		return EnsureAvailable(str.size()) && mData.compare(mPos, str.size(), str) == 0;
+	}
+
+	char GetChar()
+	{
+		if (!EnsureAvailable(1)) {
+			ThrowParsingError("Unexpected end of XML document");
+		}
+		return mData[mPos++];
+	}
+
+	static bool IsWhitespace(char sym) noexcept {
+		return sym == ' ' || sym == '\t' || sym == '\n' || sym == '\r';
+	}
+
+	void SkipWhitespaces()
+	{
+		while (EnsureAvailable(1) && IsWhitespace(mData[mPos])) {
+			++mPos;
+		}
+	}
+
+	/// <summary>
+	/// Skips (or appends to the output) the content until the end marker.
+	/// </summary>
+	void SkipUntil(std::string_view endMarker, size_t startMarkerSize, std::string* outputStr = nullptr)
+	{
+		mPos += startMarkerSize;
+		while (true)
+		{
+			const auto foundPos = mData.find(endMarker, mPos);
+			if (foundPos != std::string_view::npos)
+			{
+				if (outputStr) {
+					outputStr->append(mData.data() + mPos, foundPos - mPos);
+				}
+				mPos = foundPos + endMarker.size();
+				return;
+			}
+
+			// Keep the tail of data, which can contain the beginning of marker
+			const size_t tailSize = std::min(mData.size() - mPos, endMarker.size() - 1);
+			const size_t endPos = mData.size() - tailSize;
+			if (outputStr) {
+				outputStr->append(mData.data() + mPos, endPos - mPos);
+			}
+			mPos = endPos;
+			if (!ReadNextChunk()) {
+				ThrowParsingError("Unexpected end of XML document");
+			}
+		}
+	}
+
+	void SkipDoctype()
+	{
+		// DOCTYPE can contain an internal subset in square brackets
+		size_t bracketsDepth = 0;
+		for (char sym = GetChar(); sym != '>' || bracketsDepth != 0; sym = GetChar())
+		{
+			if (sym == '[') {
+				++bracketsDepth;
+			}
+			else if (sym == ']' && bracketsDepth != 0) {
+				--bracketsDepth;
+			}
+		}
+	}
+
+	void ReadName(std::string& name)
+	{
+		name.clear();
+		while (true)
+		{
+			size_t endPos = mPos;
+			for (; endPos < mData.size(); ++endPos)
+			{
+				const char sym = mData[endPos];
+				if (IsWhitespace(sym) || sym == '/' || sym == '>' || sym == '=' || sym == '<' || sym == '"' || sym == '\'') {
+					break;
+				}
+			}
+			name.append(mData.data() + mPos, endPos - mPos);
+			mPos = endPos;
+			if (endPos != mData.size() || !ReadNextChunk()) {
+				break;
+			}
+		}
+
+		if (name.empty()) {
+			ThrowParsingError("Expected the name of element or attribute");
+		}
+	}
+
+	void ReadStartTag()
+	{
+		++mPos;
+		if (mDepth == mElements.size()) {
+			mElements.emplace_back();
+		}
+		ReadName(mElements[mDepth++]);
+
+		mAttributes.clear();
+		while (true)
+		{
+			SkipWhitespaces();
+			const char sym = GetChar();
+			if (sym == '>')
+			{
+				mIsEmptyElement = false;
+				return;
+			}
+			if (sym == '/')
+			{
+				if (GetChar() != '>') {
+					ThrowParsingError("Expected '>' at the end of empty element");
+				}
+				mIsEmptyElement = true;
+				return;
+			}
+
+			--mPos;
+			auto& [name, value] = mAttributes.emplace_back();
+			ReadName(name);
+			SkipWhitespaces();
+			if (GetChar() != '=') {
+				ThrowParsingError("Expected '=' after the name of attribute");
+			}
+			SkipWhitespaces();
+			const char quote = GetChar();
+			if (quote != '"' && quote != '\'') {
+				ThrowParsingError("Expected quoted value of attribute");
+			}
+			ReadText(quote, &value);
+			++mPos;
+		}
+	}
+
+	void ReadEndTag()
+	{
+		mPos += 2;
+		ReadName(mNameBuffer);
+		if (mNameBuffer != mElements[mDepth - 1]) {
+			ThrowParsingError("Mismatched end tag '" + mNameBuffer + "', expected '" + mElements[mDepth - 1] + "'");
+		}
+		SkipWhitespaces();
+		if (GetChar() != '>') {
+			ThrowParsingError("Expected '>' at the end of end tag");
+		}
+		--mDepth;
+	}
+
+	/// <summary>
+	/// Reads (or skips when output is null) the text until the end symbol, decodes entities and normalizes line endings.
+	/// </summary>
+	void ReadText(char endSym, std::string* outputStr)
+	{
+		const bool isAttribute = endSym != '<';
+		while (true)
+		{
+			if (!EnsureAvailable(1)) {
+				ThrowParsingError("Unexpected end of XML document");
+			}
+
+			// Append the run of characters without escaping at once
+			size_t endPos = mPos;
+			for (; endPos < mData.size(); ++endPos)
+			{
+				const char sym = mData[endPos];
+				if (sym == endSym || sym == '&' || sym == '\r' || (isAttribute && (sym == '\n' || sym == '\t'))) {
+					break;
+				}
+			}
+			if (outputStr) {
+				outputStr->append(mData.data() + mPos, endPos - mPos);
+			}
+			mPos = endPos;
+			if (mPos == mData.size()) {
+				continue;
+			}
+
+			const char sym = mData[mPos];
+			if (sym == endSym) {
+				return;
+			}
+			if (sym == '&')
+			{
+				ReadEntity(outputStr);
+				continue;
+			}
+
+			// CRLF and CR are normalized to LF, whitespaces in attributes are converted to spaces
+			++mPos;
+			if (sym == '\r' && StartsWith("\n")) {
+				++mPos;
+			}
+			if (outputStr) {
+				outputStr->push_back(isAttribute ? ' ' : '\n');
+			}
+		}
+	}
+
+	void ReadEntity(std::string* outputStr)
+	{
+		// The longest entity is the character reference like "&#x10FFFF;"
+		constexpr size_t maxEntitySize = 10;
+		EnsureAvailable(maxEntitySize);
+		const auto endPos = mData.substr(mPos, maxEntitySize).find(';');
+		if (endPos == std::string_view::npos)
+		{
+			// Unknown entities are kept as is (like in the PugiXml)
+			AppendChar(outputStr, mData[mPos++]);
+			return;
+		}
+
+		const auto entity = mData.substr(mPos + 1, endPos - 1);
+		char32_t codePoint = 0;
+		if (entity == "lt") {
+			codePoint = '<';
+		}
+		else if (entity == "gt") {
+			codePoint = '>';
+		}
+		else if (entity == "amp") {
+			codePoint = '&';
+		}
+		else if (entity == "quot") {
+			codePoint = '"';
+		}
+		else if (entity == "apos") {
+			codePoint = '\'';
+		}
+		else if (entity.size() > 1 && entity[0] == '#')
+		{
+			const bool isHex = entity[1] == 'x';
+			const char* numBegin = entity.data() + (isHex ? 2 : 1);
+			uint32_t number = 0;
+			const auto result = std::from_chars(numBegin, entity.data() + entity.size(), number, isHex ? 16 : 10);
+			if (result.ec == std::errc() && result.ptr == entity.data() + entity.size()
+				&& number <= 0x10FFFF && !Convert::Unicode::IsInSurrogatesRange(number)) {
+				codePoint = number;
+			}
+		}
+
+		if (codePoint == 0)
+		{
+			AppendChar(outputStr, mData[mPos++]);
+			return;
+		}
+		mPos += endPos + 1;
+		if (outputStr) {
+			AppendUtf8(*outputStr, codePoint);
+		}
+	}
+
+	static void AppendChar(std::string* outputStr, char sym)
+	{
+		if (outputStr) {
+			outputStr->push_back(sym);
+		}
+	}
+
+	static void AppendUtf8(std::string& outputStr, char32_t codePoint)
+	{
+		if (codePoint < 0x80) {
+			outputStr.push_back(static_cast<char>(codePoint));
+		}
+		else if (codePoint < 0x800)
+		{
+			outputStr.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+			outputStr.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+		}
+		else if (codePoint < 0x10000)
+		{
+			outputStr.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+			outputStr.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+			outputStr.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+		}
+		else
+		{
+			outputStr.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+			outputStr.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+			outputStr.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+			outputStr.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+		}
+	}
+
+	[[noreturn]] void ThrowParsingError(const std::string& message) const
+	{
+		throw ParsingException(message, 0, mDiscardedSize + mPos);
+	}
+
+	std::unique_ptr<Convert::CEncodedStreamReader<Convert::Utf8>> mEncodedStreamReader;
+	std::string mBuffer;
+	std::string_view mData;
+	size_t mPos = 0;
+	size_t mDiscardedSize = 0;
+	std::string mPathPrefix;
+	std::vector<std::string> mElements;
+	size_t mDepth = 0;
+	bool mIsEmptyElement = false;
+	attributes_type mAttributes;
+	std::string mNameBuffer;
+	std::string mText;
+};
+
+namespace XmlExtensions
+{
+	/// <summary>
+	/// Returns the key in UTF-8 (the buffer is used when conversion is required).
+	/// </summary>
+	template <typename TKey>
+	std::string_view GetUtf8KeyView(const TKey& key, std::string& buffer)
+	{
+		const auto keyView = BitSerializer::Detail::GetKeyView(key);
+		if constexpr (std::is_same_v<typename std::decay_t<decltype(keyView)>::value_type, char>) {
+			return keyView;
+		}
+		else
+		{
+			buffer.clear();
+			Convert::Utf8::Encode(keyView.cbegin(), keyView.cend(), buffer);
+			return buffer;
+		}
+	}
+
+	/// <summary>
+	/// Loads a value from the text of element or attribute (null when there is no text).
+	/// </summary>
+	template <typename T>
+	bool LoadTextValue(const std::string* text, T& value, const SerializationOptions& serializationOptions)
+	{
+		// Empty node is treated as Null
+		if (!text) {
+			return false;
+		}
+
+		bool isOverflow;
+		if constexpr ((std::is_integral_v<T> && !std::is_same_v<T, bool>) || std::is_floating_point_v<T>)
+		{
+			std::errc ec;
+			if constexpr (std::is_floating_point_v<T>) {
+				ec = Convert::Detail::TryParseFloat(std::string_view(*text), value);
+			}
+			else {
+				ec = Convert::Detail::TryParseInteger(std::string_view(*text), value);
+			}
+			if (ec == std::errc()) {
+				return true;
+			}
+			isOverflow = ec == std::errc::result_out_of_range;
+		}
+		else
+		{
+			try
+			{
+				value = Convert::To<T>(*text);
+				return true;
+			}
+			catch (const std::out_of_range&)
+			{
+				isOverflow = true;
+			}
+			catch (...)
+			{
+				isOverflow = false;
+			}
+		}
+
+		if (isOverflow)
+		{
+			if (serializationOptions.overflowNumberPolicy == OverflowNumberPolicy::ThrowError)
+			{
+				throw SerializationException(SerializationErrorCode::Overflow,
+					"The size of target field is not sufficient to deserialize number: " + *text);
+			}
+		}
+		else if (serializationOptions.mismatchedTypesPolicy == MismatchedTypesPolicy::ThrowError)
+		{
+			throw SerializationException(SerializationErrorCode::MismatchedTypes,
+				"The type of target field does not match the value being loaded: " + *text);
+		}
+		return false;
+	}
+
+	inline bool LoadTextValue(const std::string* text, std::nullptr_t&, const SerializationOptions&) noexcept {
+		return text == nullptr;
+	}
+
+	template <typename TSym, typename TStrAllocator>
+	bool LoadTextValue(const std::string* text, std::basic_string<TSym, std::char_traits<TSym>, TStrAllocator>& value, const SerializationOptions&)
+	{
+		if (!text) {
+			return false;
+		}
+		if constexpr (std::is_same_v<TSym, char>)
+			value = *text;
+		else
+			value = Convert::To<std::basic_string<TSym, std::char_traits<TSym>, TStrAllocator>>(*text);
+		return true;
+	}
+}
+
+/// <summary>
+/// Element which has been read ahead (before it was requested by key) and kept for loading later.
+/// </summary>
+struct XmlPullBufferedElement
+{
+	std::string name;
+	std::string xml;
+	bool isLoaded = false;
+};
+
+/// <summary>
+/// Constant iterator for keys of object, which is loaded by the pull parser.
+/// </summary>
+class pull_key_const_iterator
+{
+	friend class XmlPullObjectScope;
+
+	std::vector<XmlPullBufferedElement>::const_iterator mElementIt;
+
+	explicit pull_key_const_iterator(std::vector<XmlPullBufferedElement>::const_iterator it)
+		: mElementIt(it) { }
+
+public:
+	bool operator==(const pull_key_const_iterator& rhs) const {
+		return this->mElementIt == rhs.mElementIt;
+	}
+	bool operator!=(const pull_key_const_iterator& rhs) const {
+		return this->mElementIt != rhs.mElementIt;
+	}
+
+	pull_key_const_iterator& operator++() {
+		++mElementIt;
+		return *this;
+	}
+
+	const XmlStreamingArchiveTraits::key_type::value_type* operator*() const {
+		return mElementIt->name.c_str();
+	}
+};
+
+/// <summary>
+/// XML scope for loading attributes by the pull parser (attributes are read together with the start tag of element).
+/// </summary>
+class XmlPullAttributeScope final : public TArchiveScope<SerializeMode::Load>, public XmlStreamingArchiveTraits
+{
+public:
+	XmlPullAttributeScope(const XmlPullReader::attributes_type& attributes, const XmlPullReader& xmlReader, size_t depth,
+		SerializationContext& serializationContext) noexcept
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mAttributes(attributes)
+		, mXmlReader(xmlReader)
+		, mDepth(depth)
+	{ }
+
+	/// <summary>
+	/// Gets the current path in XML.
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const {
+		return mXmlReader.GetPath(mDepth);
+	}
+
+	template <typename TKey, typename T, std::enable_if_t<std::is_arithmetic_v<T> || std::is_null_pointer_v<T>, int> = 0>
+	bool SerializeValue(TKey&& key, T& value)
+	{
+		const auto* text = FindAttribute(key);
+		if (!text) {
+			return std::is_null_pointer_v<T>;
+		}
+		if constexpr (std::is_null_pointer_v<T>) {
+			return true;
+		}
+		else {
+			return XmlExtensions::LoadTextValue(text, value, GetOptions());
+		}
+	}
+
+	template <typename TKey, typename TSym, typename TStrAllocator>
+	bool SerializeValue(TKey&& key, std::basic_string<TSym, std::char_traits<TSym>, TStrAllocator>& value)
+	{
+		const auto* text = FindAttribute(key);
+		if (!text) {
+			return false;
+		}
+		// Empty attribute is loaded as empty string
+		if constexpr (std::is_same_v<TSym, char>)
+			value = *text;
+		else
+			value = Convert::To<std::basic_string<TSym, std::char_traits<TSym>, TStrAllocator>>(*text);
+		return true;
+	}
+
+private:
+	template <typename TKey>
+	const std::string* FindAttribute(const TKey& key)
+	{
+		std::string keyBuffer;
+		const auto keyView = XmlExtensions::GetUtf8KeyView(key, keyBuffer);
+		for (const auto& [name, value] : mAttributes)
+		{
+			if (name == keyView) {
+				return &value;
+			}
+		}
+		return nullptr;
+	}
+
+	const XmlPullReader::attributes_type& mAttributes;
+	const XmlPullReader& mXmlReader;
+	size_t mDepth;
+};
+
+// Forward declarations
+class XmlPullObjectScope;
+
+/// <summary>
+/// XML scope for loading arrays by the pull parser, items are read one by one from the input.
+/// </summary>
+class XmlPullArrayScope final : public TArchiveScope<SerializeMode::Load>, public XmlStreamingArchiveTraits
+{
+public:
+	XmlPullArrayScope(XmlPullReader* xmlReader, SerializationContext& serializationContext, std::unique_ptr<XmlPullReader> ownedReader = nullptr)
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mOwnedReader(std::move(ownedReader))
+		, mXmlReader(xmlReader)
+		, mDepth(xmlReader->GetDepth())
+	{ }
+
+	/// <summary>
+	/// Gets the current path in XML.
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const {
+		return mXmlReader->GetPath(mDepth);
+	}
+
+	/// <summary>
+	/// Returns the estimated number of items to load (unknown until all items are read).
+	/// </summary>
+	[[nodiscard]] size_t GetEstimatedSize() const noexcept {
+		return 0;
+	}
+
+	/// <summary>
+	/// Returns `true` when all no more values to load (reads the start tag of next item).
+	/// </summary>
+	[[nodiscard]]
+	bool IsEnd()
+	{
+		if (!mHasPendingItem && !mIsEnd)
+		{
+			mXmlReader->SkipTo(mDepth);
+			mHasPendingItem = mXmlReader->ReadChildElement();
+			mIsEnd = !mHasPendingItem;
+		}
+		return mIsEnd;
+	}
+
+	template <typename T>
+	bool SerializeValue(T& value)
+	{
+		ReadNextItem();
+		return XmlExtensions::LoadTextValue(mXmlReader->ReadText(), value, GetOptions());
+	}
+
+	std::optional<XmlPullArrayScope> OpenArrayScope(size_t arraySize)
+	{
+		ReadNextItem();
+		return mXmlReader->HasChildElements() ? std::make_optional<XmlPullArrayScope>(mXmlReader, GetContext()) : std::nullopt;
+	}
+
+	std::optional<XmlPullObjectScope> OpenObjectScope();
+
+private:
+	void ReadNextItem()
+	{
+		if (IsEnd()) {
+			throw SerializationException(SerializationErrorCode::OutOfRange, "No more items to load");
+		}
+		mHasPendingItem = false;
+	}
+
+	std::unique_ptr<XmlPullReader> mOwnedReader;
+	XmlPullReader* mXmlReader;
+	size_t mDepth;
+	bool mHasPendingItem = false;
+	bool mIsEnd = false;
+};
+
+/// <summary>
+/// XML scope for loading objects by the pull parser.
+/// As fields are usually loaded in the same order as they were saved, elements are read directly from the input,
+/// the elements which are skipped on the way to the requested key are buffered for loading them later.
+/// </summary>
+class XmlPullObjectScope final : public TArchiveScope<SerializeMode::Load>, public XmlStreamingArchiveTraits
+{
+public:
+	XmlPullObjectScope(XmlPullReader* xmlReader, SerializationContext& serializationContext, std::unique_ptr<XmlPullReader> ownedReader = nullptr)
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mOwnedReader(std::move(ownedReader))
+		, mXmlReader(xmlReader)
+		, mDepth(xmlReader->GetDepth())
+		, mAttributes(xmlReader->TakeAttributes())
+	{ }
+
+	/// <summary>
+	/// Iterating over keys requires reading all remaining elements of the object, so they are buffered.
+	/// </summary>
+	[[nodiscard]] pull_key_const_iterator cbegin()
+	{
+		BufferRemainingElements();
+		return pull_key_const_iterator(mBufferedElements.cbegin());
+	}
+
+	[[nodiscard]] pull_key_const_iterator cend()
+	{
+		BufferRemainingElements();
+		return pull_key_const_iterator(mBufferedElements.cend());
+	}
+
+	/// <summary>
+	/// Returns the estimated number of items to load (unknown until all elements are read).
+	/// </summary>
+	[[nodiscard]] size_t GetEstimatedSize() const noexcept {
+		return 0;
+	}
+
+	/// <summary>
+	/// Gets the current path in XML.
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const {
+		return mXmlReader->GetPath(mDepth);
+	}
+
+	template <typename TKey, typename T>
+	bool SerializeValue(TKey&& key, T& value)
+	{
+		std::unique_ptr<XmlPullReader> ownedReader;
+		auto* xmlReader = FindChild(key, ownedReader);
+		return xmlReader ? XmlExtensions::LoadTextValue(xmlReader->ReadText(), value, GetOptions()) : false;
+	}
+
+	template <typename TKey>
+	std::optional<XmlPullObjectScope> OpenObjectScope(TKey&& key)
+	{
+		std::unique_ptr<XmlPullReader> ownedReader;
+		auto* xmlReader = FindChild(key, ownedReader);
+		return xmlReader && xmlReader->HasChildElements()
+			? std::make_optional<XmlPullObjectScope>(xmlReader, GetContext(), std::move(ownedReader)) : std::nullopt;
+	}
+
+	template <typename TKey>
+	std::optional<XmlPullArrayScope> OpenArrayScope(TKey&& key, size_t arraySize)
+	{
+		std::unique_ptr<XmlPullReader> ownedReader;
+		auto* xmlReader = FindChild(key, ownedReader);
+		return xmlReader && xmlReader->HasChildElements()
+			? std::make_optional<XmlPullArrayScope>(xmlReader, GetContext(), std::move(ownedReader)) : std::nullopt;
+	}
+
+	std::optional<XmlPullAttributeScope> OpenAttributeScope()
+	{
+		return std::make_optional<XmlPullAttributeScope>(mAttributes, *mXmlReader, mDepth, GetContext());
+	}
+
+private:
+	/// <summary>
+	/// Finds the child element by key, returns the reader which is positioned after the start tag of found element.
+	/// The buffered elements are loaded via separate reader, which is owned by the caller.
+	/// </summary>
+	template <typename TKey>
+	XmlPullReader* FindChild(const TKey& key, std::unique_ptr<XmlPullReader>& ownedReader)
+	{
+		std::string keyBuffer;
+		const auto keyView = XmlExtensions::GetUtf8KeyView(key, keyBuffer);
+		for (auto& bufferedElement : mBufferedElements)
+		{
+			if (!bufferedElement.isLoaded && bufferedElement.name == keyView)
+			{
+				bufferedElement.isLoaded = true;
+				ownedReader = std::make_unique<XmlPullReader>(std::move(bufferedElement.xml), GetPath());
+				ownedReader->ReadRootElement();
+				return ownedReader.get();
+			}
+		}
+
+		while (!mIsEnd)
+		{
+			mXmlReader->SkipTo(mDepth);
+			if (!mXmlReader->ReadChildElement())
+			{
+				mIsEnd = true;
+				break;
+			}
+			if (mXmlReader->GetElementName() == keyView) {
+				return mXmlReader;
+			}
+			auto& bufferedElement = mBufferedElements.emplace_back();
+			bufferedElement.name = mXmlReader->GetElementName();
+			mXmlReader->CaptureElement(bufferedElement.xml);
+		}
+		return nullptr;
+	}
+
+	void BufferRemainingElements()
+	{
+		while (!mIsEnd)
+		{
+			mXmlReader->SkipTo(mDepth);
+			if (!mXmlReader->ReadChildElement())
+			{
+				mIsEnd = true;
+				break;
+			}
+			auto& bufferedElement = mBufferedElements.emplace_back();
+			bufferedElement.name = mXmlReader->GetElementName();
+			mXmlReader->CaptureElement(bufferedElement.xml);
+		}
+	}
+
+	std::unique_ptr<XmlPullReader> mOwnedReader;
+	XmlPullReader* mXmlReader;
+	size_t mDepth;
+	XmlPullReader::attributes_type mAttributes;
+	std::vector<XmlPullBufferedElement> mBufferedElements;
+	bool mIsEnd = false;
+};
+
+inline std::optional<XmlPullObjectScope> XmlPullArrayScope::OpenObjectScope()
+{
+	ReadNextItem();
+	return mXmlReader->HasChildElements() ? std::make_optional<XmlPullObjectScope>(mXmlReader, GetContext()) : std::nullopt;
+}
+
+/// <summary>
+/// XML root scope for loading by the pull parser (can serialize one array or object).
+/// </summary>
+class XmlPullRootScope final : public TArchiveScope<SerializeMode::Load>, public XmlStreamingArchiveTraits
+{
+public:
+	XmlPullRootScope(const std::string& inputStr, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mXmlReader(std::string_view(inputStr))
+	{ }
+
+	XmlPullRootScope(const char* inputStr, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mXmlReader(std::string_view(inputStr))
+	{ }
+
+	XmlPullRootScope(std::istream& inputStream, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mXmlReader(inputStream)
+	{ }
+
+	/// <summary>
+	/// Gets the current path in XML.
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const {
+		return mXmlReader.GetPath();
+	}
+
+	std::optional<XmlPullArrayScope> OpenArrayScope(size_t arraySize)
+	{
+		return mXmlReader.ReadRootElement() ? std::make_optional<XmlPullArrayScope>(&mXmlReader, GetContext()) : std::nullopt;
+	}
+
+	template <typename TKey>
+	std::optional<XmlPullArrayScope> OpenArrayScope(TKey&& key, size_t arraySize)
+	{
+		return ReadRootElement(key) ? std::make_optional<XmlPullArrayScope>(&mXmlReader, GetContext()) : std::nullopt;
+	}
+
+	std::optional<XmlPullObjectScope> OpenObjectScope()
+	{
+		return mXmlReader.ReadRootElement() ? std::make_optional<XmlPullObjectScope>(&mXmlReader, GetContext()) : std::nullopt;
+	}
+
+	template <typename TKey>
+	std::optional<XmlPullObjectScope> OpenObjectScope(TKey&& key)
+	{
+		return ReadRootElement(key) ? std::make_optional<XmlPullObjectScope>(&mXmlReader, GetContext()) : std::nullopt;
+	}
+
+	void Finalize()
+	{
+		// Read the rest of the root element for checking that the document is well-formed
+		mXmlReader.SkipTo(0);
+	}
+
+private:
+	template <typename TKey>
+	bool ReadRootElement(const TKey& key)
+	{
+		std::string keyBuffer;
+		return mXmlReader.ReadRootElement() && mXmlReader.GetElementName() == XmlExtensions::GetUtf8KeyView(key, keyBuffer);
+	}
+
+	XmlPullReader mXmlReader;
+};
+
+}
@@ -0,0 +1,575 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include <cassert>
+#include <charconv>
+#include <cstdio>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "bitserializer/serialization_detail/archive_base.h"
+#include "bitserializer/serialization_detail/errors_handling.h"
+#include "bitserializer/xml_detail/xml_common.h"
+
+namespace BitSerializer::Xml::Detail {
+
+/// <summary>
+/// Writes XML directly to the output string or stream, without building the document in memory.
+/// Texts and attributes are escaped in bulk, the output to stream is flushed by chunks.
+/// </summary>
+class XmlStreamWriter
+{
+public:
+	XmlStreamWriter(std::string& outputStr, const SerializationOptions& serializationOptions)
+		: mFormatOptions(serializationOptions.formatOptions)
+		, mEncoding(Convert::UtfType::Utf8)
+		, mOutputStream(nullptr)
+		, mOutput(outputStr)
+	{
+		mOutput.clear();
+		WriteDeclaration();
+	}
+
+	XmlStreamWriter(std::ostream& outputStream, const SerializationOptions& serializationOptions)
+		: mFormatOptions(serializationOptions.formatOptions)
+		, mEncoding(ValidateEncoding(serializationOptions.streamOptions.encoding))
+		, mOutputStream(&outputStream)
+		, mOutput(mBuffer)
+	{
+		mBuffer.reserve(FlushChunkSize + FlushChunkSize / 4);
+		if (serializationOptions.streamOptions.writeBom) {
+			Convert::WriteBom(outputStream, mEncoding);
+		}
+		WriteDeclaration();
+	}
+
+	XmlStreamWriter(const XmlStreamWriter&) = delete;
+	XmlStreamWriter& operator=(const XmlStreamWriter&) = delete;
+
+	void BeginElement(std::string_view name)
+	{
+		// The output is flushed only here and in Finalize(), as EndElement() is called from destructors of scopes
+		if (mOutputStream && mOutput.size() >= FlushChunkSize) {
+			Flush();
+		}
+
+		if (mIsStartTagOpen)
+		{
+			mOutput.push_back('>');
+			if (mFormatOptions.enableFormat) {
+				mOutput.push_back('\n');
+			}
+			mIsStartTagOpen = false;
+		}
+		if (mDepth != 0) {
+			mElements[mDepth - 1].hasChildren = true;
+		}
+
+		WriteIndent(mDepth);
+		if (mDepth == mElements.size()) {
+			mElements.emplace_back();
+		}
+		auto& element = mElements[mDepth++];
+		element.name = name;
+		element.hasChildren = false;
+
+		mOutput.push_back('<');
+		mOutput.append(element.name);
+		mIsStartTagOpen = true;
+	}
+
+	void WriteAttribute(std::string_view name, std::string_view utf8Value)
+	{
+		if (!mIsStartTagOpen)
+		{
+			throw SerializationException(SerializationErrorCode::OutOfRange,
+				"Attributes must be saved before child elements and text when XML is written directly to the output");
+		}
+		mOutput.push_back(' ');
+		mOutput.append(name);
+		mOutput.append("=\"");
+		WriteEscaped(utf8Value, true);
+		mOutput.push_back('"');
+	}
+
+	void WriteText(std::string_view utf8Value)
+	{
+		assert(mDepth != 0);
+		if (mIsStartTagOpen)
+		{
+			mOutput.push_back('>');
+			mIsStartTagOpen = false;
+		}
+		WriteEscaped(utf8Value, false);
+	}
+
+	void EndElement()
+	{
+		assert(mDepth != 0);
+		const auto& element = mElements[--mDepth];
+		if (mIsStartTagOpen)
+		{
+			// The same as PugiXml writes empty elements (with space only when formatting is enabled)
+			mOutput.append(mFormatOptions.enableFormat ? std::string_view(" />") : std::string_view("/>"));
+			mIsStartTagOpen = false;
+		}
+		else
+		{
+			if (element.hasChildren) {
+				WriteIndent(mDepth);
+			}
+			mOutput.append("</");
+			mOutput.append(element.name);
+			mOutput.push_back('>');
+		}
+		if (mFormatOptions.enableFormat) {
+			mOutput.push_back('\n');
+		}
+	}
+
+	void Finalize()
+	{
+		assert(mDepth == 0);
+		if (mOutputStream) {
+			Flush();
+		}
+	}
+
+	/// <summary>
+	/// Gets the path to the current element (names are separated by '/').
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const
+	{
+		std::string path;
+		for (size_t i = 0; i < mDepth; ++i)
+		{
+			path.push_back(XmlStreamingArchiveTraits::path_separator);
+			path.append(mElements[i].name);
+		}
+		return path;
+	}
+
+private:
+	static constexpr size_t FlushChunkSize = 64 * 1024;
+
+	struct ElementState
+	{
+		std::string name;
+		bool hasChildren = false;
+	};
+
+	static Convert::UtfType ValidateEncoding(const Convert::UtfType utfType)
+	{
+		switch (utfType)
+		{
+		case Convert::UtfType::Utf8:
+		case Convert::UtfType::Utf16le:
+		case Convert::UtfType::Utf16be:
+		case Convert::UtfType::Utf32le:
+		case Convert::UtfType::Utf32be:
+			return utfType;
+		default:
+			const auto strEncodingType = Convert::TryTo<std::string>(utfType);
+			throw SerializationException(SerializationErrorCode::UnsupportedEncoding,
+				"The archive does not support encoding: " +
+				(strEncodingType.has_value() ? strEncodingType.value() : std::to_string(static_cast<int>(utfType))));
+		}
+	}
+
+	void WriteDeclaration()
+	{
+		mOutput.append("<?xml version=\"1.0\"?>");
+		if (mFormatOptions.enableFormat) {
+			mOutput.push_back('\n');
+		}
+	}
+
+	void WriteIndent(size_t level)
+	{
+		if (mFormatOptions.enableFormat) {
+			mOutput.append(level * mFormatOptions.paddingCharNum, mFormatOptions.paddingChar);
+		}
+	}
+
+	void WriteEscaped(std::string_view str, bool isAttribute)
+	{
+		XmlExtensions::AppendEscaped(mOutput, str, isAttribute);
+	}
+
+	void Flush()
+	{
+		assert(mOutputStream);
+		switch (mEncoding)
+		{
+		case Convert::UtfType::Utf8:
+			mOutputStream->write(mBuffer.data(), static_cast<std::streamsize>(mBuffer.size()));
+			break;
+		case Convert::UtfType::Utf16le:
+			WriteEncoded<Convert::Utf16Le, std::u16string>();
+			break;
+		case Convert::UtfType::Utf16be:
+			WriteEncoded<Convert::Utf16Be, std::u16string>();
+			break;
+		case Convert::UtfType::Utf32le:
+			WriteEncoded<Convert::Utf32Le, std::u32string>();
+			break;
+		case Convert::UtfType::Utf32be:
+			WriteEncoded<Convert::Utf32Be, std::u32string>();
+			break;
+		}
+		mBuffer.clear();
+	}
+
+	template <typename TUtf, typename TString>
+	void WriteEncoded()
+	{
+		TString encodedStr;
+		TUtf::Encode(mBuffer.cbegin(), mBuffer.cend(), encodedStr);
+		mOutputStream->write(reinterpret_cast<const char*>(encodedStr.data()),
+			static_cast<std::streamsize>(encodedStr.size() * sizeof(typename TString::value_type)));
+	}
+
+	const FormatOptions mFormatOptions;
+	const Convert::UtfType mEncoding;
+	std::ostream* mOutputStream;
+	std::string mBuffer;
+	std::string& mOutput;
+	std::vector<ElementState> mElements;
+	size_t mDepth = 0;
+	bool mIsStartTagOpen = false;
+};
+
+namespace XmlExtensions
+{
+	/// <summary>
+	/// Converts a value to UTF-8 text for writing directly to the output.
+	/// </summary>
+	template <typename T, typename TCallback>
+	void VisitValueAsUtf8(const T& value, TCallback&& callback)
+	{
+		if constexpr (std::is_same_v<T, bool>) {
+			callback(value ? std::string_view("true") : std::string_view("false"));
+		}
+		else if constexpr (std::is_integral_v<T>)
+		{
+			char buffer[24];
+			const auto result = std::to_chars(buffer, buffer + sizeof buffer, value);
+			callback(std::string_view(buffer, static_cast<size_t>(result.ptr - buffer)));
+		}
+		else if constexpr (std::is_floating_point_v<T>)
+		{
+			// Uses the same precision as the PugiXml library
+			char buffer[32];
+			const int size = std::snprintf(buffer, sizeof buffer, std::is_same_v<T, float> ? "%.9g" : "%.17g", static_cast<double>(value));
+			callback(std::string_view(buffer, static_cast<size_t>(size)));
+		}
+		else if constexpr (std::is_null_pointer_v<T>) {
+			callback(std::string_view());
+		}
+		else if constexpr (std::is_same_v<T, std::string>) {
+			callback(std::string_view(value));
+		}
+		else {
+			callback(std::string_view(Convert::ToString(value)));
+		}
+	}
+}
+
+/// <summary>
+/// Constant iterator for keys of object, which is written directly to the output (the range of keys is always empty).
+/// </summary>
+class write_key_const_iterator
+{
+public:
+	bool operator==(const write_key_const_iterator&) const noexcept {
+		return true;
+	}
+	bool operator!=(const write_key_const_iterator&) const noexcept {
+		return false;
+	}
+
+	write_key_const_iterator& operator++() noexcept {
+		return *this;
+	}
+
+	const XmlStreamingArchiveTraits::key_type::value_type* operator*() const noexcept {
+		return "";
+	}
+};
+
+// Forward declarations
+class XmlWriteObjectScope;
+
+/// <summary>
+/// XML scope for writing attributes directly to the output (must be used before writing child elements).
+/// </summary>
+class XmlWriteAttributeScope final : public TArchiveScope<SerializeMode::Save>, public XmlStreamingArchiveTraits
+{
+public:
+	explicit XmlWriteAttributeScope(XmlStreamWriter* xmlWriter, SerializationContext& serializationContext) noexcept
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, mXmlWriter(xmlWriter)
+	{ }
+
+	/// <summary>
+	/// Gets the current path in XML.
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const {
+		return mXmlWriter->GetPath();
+	}
+
+	template <typename TKey, typename T, std::enable_if_t<std::is_arithmetic_v<T> || std::is_null_pointer_v<T>, int> = 0>
+	bool SerializeValue(TKey&& key, T& value)
+	{
+		XmlExtensions::VisitValueAsUtf8(value, [this, &key](std::string_view utf8Value) {
+			mXmlWriter->WriteAttribute(BitSerializer::Detail::GetKeyView(key), utf8Value);
+		});
+		return true;
+	}
+
+	template <typename TKey, typename TSym, typename TStrAllocator>
+	bool SerializeValue(TKey&& key, std::basic_string<TSym, std::char_traits<TSym>, TStrAllocator>& value)
+	{
+		XmlExtensions::VisitValueAsUtf8(value, [this, &key](std::string_view utf8Value) {
+			mXmlWriter->WriteAttribute(BitSerializer::Detail::GetKeyView(key), utf8Value);
+		});
+		return true;
+	}
+
+private:
+	XmlStreamWriter* mXmlWriter;
+};
+
+/// <summary>
+/// XML scope for writing arrays directly to the output (list of values without keys).
+/// </summary>
+class XmlWriteArrayScope final : public TArchiveScope<SerializeMode::Save>, public XmlStreamingArchiveTraits
+{
+public:
+	explicit XmlWriteArrayScope(XmlStreamWriter* xmlWriter, SerializationContext& serializationContext) noexcept
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, mXmlWriter(xmlWriter)
+	{ }
+
+	XmlWriteArrayScope(XmlWriteArrayScope&& other) noexcept
+		: TArchiveScope<SerializeMode::Save>(std::move(other))
+		, mXmlWriter(std::exchange(other.mXmlWriter, nullptr))
+	{ }
+
+	~XmlWriteArrayScope()
+	{
+		// The element is closed when scope goes out (does not write to the stream, so can't throw I/O errors)
+		if (mXmlWriter) {
+			mXmlWriter->EndElement();
+		}
+	}
+
+	/// <summary>
+	/// Gets the current path in XML.
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const {
+		return mXmlWriter->GetPath();
+	}
+
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(T& value)
+	{
+		WriteValue(value);
+		return true;
+	}
+
+	template <typename TSym, typename TStrAllocator>
+	bool SerializeValue(std::basic_string<TSym, std::char_traits<TSym>, TStrAllocator>& value)
+	{
+		WriteValue(value);
+		return true;
+	}
+
+	std::optional<XmlWriteArrayScope> OpenArrayScope(size_t arraySize)
+	{
+		mXmlWriter->BeginElement("array");
+		return std::make_optional<XmlWriteArrayScope>(mXmlWriter, GetContext());
+	}
+
+	std::optional<XmlWriteObjectScope> OpenObjectScope();
+
+private:
+	template <typename T>
+	void WriteValue(const T& value)
+	{
+		mXmlWriter->BeginElement("value");
+		if constexpr (!std::is_null_pointer_v<T>)
+		{
+			XmlExtensions::VisitValueAsUtf8(value, [this](std::string_view utf8Value) {
+				mXmlWriter->WriteText(utf8Value);
+			});
+		}
+		mXmlWriter->EndElement();
+	}
+
+	XmlStreamWriter* mXmlWriter;
+};
+
+/// <summary>
+/// XML scope for writing objects directly to the output (list of values with keys).
+/// </summary>
+class XmlWriteObjectScope final : public TArchiveScope<SerializeMode::Save>, public XmlStreamingArchiveTraits
+{
+public:
+	explicit XmlWriteObjectScope(XmlStreamWriter* xmlWriter, SerializationContext& serializationContext) noexcept
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, mXmlWriter(xmlWriter)
+	{ }
+
+	XmlWriteObjectScope(XmlWriteObjectScope&& other) noexcept
+		: TArchiveScope<SerializeMode::Save>(std::move(other))
+		, mXmlWriter(std::exchange(other.mXmlWriter, nullptr))
+	{ }
+
+	~XmlWriteObjectScope()
+	{
+		// The element is closed when scope goes out (does not write to the stream, so can't throw I/O errors)
+		if (mXmlWriter) {
+			mXmlWriter->EndElement();
+		}
+	}
+
+	/// <summary>
+	/// Written elements are not kept in memory, so the range of keys is always empty.
+	/// </summary>
+	[[nodiscard]] write_key_const_iterator cbegin() const {
+		return {};
+	}
+
+	[[nodiscard]] write_key_const_iterator cend() const {
+		return {};
+	}
+
+	/// <summary>
+	/// Gets the current path in XML.
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const {
+		return mXmlWriter->GetPath();
+	}
+
+	template <typename TKey, typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(TKey&& key, T& value)
+	{
+		WriteValue(BitSerializer::Detail::GetKeyView(key), value);
+		return true;
+	}
+
+	template <typename TKey, typename TSym, typename TStrAllocator>
+	bool SerializeValue(TKey&& key, std::basic_string<TSym, std::char_traits<TSym>, TStrAllocator>& value)
+	{
+		WriteValue(BitSerializer::Detail::GetKeyView(key), value);
+		return true;
+	}
+
+	template <typename TKey>
+	std::optional<XmlWriteObjectScope> OpenObjectScope(TKey&& key)
+	{
+		mXmlWriter->BeginElement(BitSerializer::Detail::GetKeyView(key));
+		return std::make_optional<XmlWriteObjectScope>(mXmlWriter, GetContext());
+	}
+
+	template <typename TKey>
+	std::optional<XmlWriteArrayScope> OpenArrayScope(TKey&& key, size_t arraySize)
+	{
+		mXmlWriter->BeginElement(BitSerializer::Detail::GetKeyView(key));
+		return std::make_optional<XmlWriteArrayScope>(mXmlWriter, GetContext());
+	}
+
+	std::optional<XmlWriteAttributeScope> OpenAttributeScope()
+	{
+		return std::make_optional<XmlWriteAttributeScope>(mXmlWriter, GetContext());
+	}
+
+private:
+	template <typename T>
+	void WriteValue(std::string_view key, const T& value)
+	{
+		mXmlWriter->BeginElement(key);
+		if constexpr (!std::is_null_pointer_v<T>)
+		{
+			XmlExtensions::VisitValueAsUtf8(value, [this](std::string_view utf8Value) {
+				mXmlWriter->WriteText(utf8Value);
+			});
+		}
+		mXmlWriter->EndElement();
+	}
+
+	XmlStreamWriter* mXmlWriter;
+};
+
+inline std::optional<XmlWriteObjectScope> XmlWriteArrayScope::OpenObjectScope()
+{
+	mXmlWriter->BeginElement("object");
+	return std::make_optional<XmlWriteObjectScope>(mXmlWriter, GetContext());
+}
+
+/// <summary>
+/// XML root scope for writing directly to the output string or stream (can serialize one array or object).
+/// </summary>
+class XmlWriteRootScope final : public TArchiveScope<SerializeMode::Save>, public XmlStreamingArchiveTraits
+{
+public:
+	XmlWriteRootScope(std::string& outputStr, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, mXmlWriter(outputStr, serializationContext.GetOptions())
+	{ }
+
+	XmlWriteRootScope(std::ostream& outputStream, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, mXmlWriter(outputStream, serializationContext.GetOptions())
+	{ }
+
+	/// <summary>
+	/// Gets the current path in XML.
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const {
+		return mXmlWriter.GetPath();
+	}
+
+	std::optional<XmlWriteArrayScope> OpenArrayScope(size_t arraySize)
+	{
+		mXmlWriter.BeginElement("array");
+		return std::make_optional<XmlWriteArrayScope>(&mXmlWriter, GetContext());
+	}
+
+	template <typename TKey>
+	std::optional<XmlWriteArrayScope> OpenArrayScope(TKey&& key, size_t arraySize)
+	{
+		mXmlWriter.BeginElement(BitSerializer::Detail::GetKeyView(key));
+		return std::make_optional<XmlWriteArrayScope>(&mXmlWriter, GetContext());
+	}
+
+	std::optional<XmlWriteObjectScope> OpenObjectScope()
+	{
+		mXmlWriter.BeginElement("root");
+		return std::make_optional<XmlWriteObjectScope>(&mXmlWriter, GetContext());
+	}
+
+	template <typename TKey>
+	std::optional<XmlWriteObjectScope> OpenObjectScope(TKey&& key)
+	{
+		mXmlWriter.BeginElement(BitSerializer::Detail::GetKeyView(key));
+		return std::make_optional<XmlWriteObjectScope>(&mXmlWriter, GetContext());
+	}
+
+	void Finalize()
+	{
+		mXmlWriter.Finalize();
+	}
+
+private:
+	XmlStreamWriter mXmlWriter;
+};
+
+}
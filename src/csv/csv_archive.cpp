@@ -5,6 +5,7 @@
 #include "csv_readers.h"
 #include "csv_writers.h"
 #include <algorithm>
+#include <cassert>
 
 
 namespace
@@ -21,10 +22,30 @@ namespace
 				std::string("Unsupported value separator '") + separator + '"');
 		}
 	}
+
+	BitSerializer::Csv::Detail::CCsvReaderBuffers* GetReusableBuffers(const BitSerializer::SerializationContext& serializationContext)
+	{
+		auto* sessionResources = serializationContext.GetSessionResources();
+		return sessionResources ? &sessionResources->Get<BitSerializer::Csv::Detail::CCsvReaderBuffers>() : nullptr;
+	}
 }
 
 namespace BitSerializer::Csv::Detail
 {
+	CsvWriteArrayScope CsvWriteArrayScope::CreateShard(SerializationContext& serializationContext, size_t itemsNum) const
+	{
+		auto shardWriter = std::make_unique<CCsvShardWriter>(serializationContext.GetOptions().valuesSeparator);
+		CsvWriteArrayScope shardScope(shardWriter.get(), serializationContext);
+		shardScope.mShardWriter = std::move(shardWriter);
+		return shardScope;
+	}
+
+	CsvRowsFragment CsvWriteArrayScope::FinalizeShard()
+	{
+		assert(mShardWriter);
+		return static_cast<CCsvShardWriter*>(mShardWriter.get())->TakeFragment();
+	}
+
 	CsvWriteRootScope::CsvWriteRootScope(std::string& encodedOutputStr, SerializationContext& serializationContext)
 		: TArchiveScope<SerializeMode::Save>(serializationContext)
 		, mCsvWriter(std::make_unique<CCsvStringWriter>(encodedOutputStr, true, serializationContext.GetOptions().valuesSeparator))
@@ -41,14 +62,14 @@ namespace BitSerializer::Csv::Detail
 
 	CsvReadRootScope::CsvReadRootScope(std::string_view encodedInputStr, SerializationContext& serializationContext)
 		: TArchiveScope<SerializeMode::Load>(serializationContext)
-		, mCsvReader(std::make_unique<CCsvStringReader>(encodedInputStr, true, serializationContext.GetOptions().valuesSeparator))
+		, mCsvReader(std::make_unique<CCsvStringReader>(encodedInputStr, true, serializationContext.GetOptions().valuesSeparator, GetReusableBuffers(serializationContext)))
 	{
 		ValidateSeparator(serializationContext.GetOptions().valuesSeparator);
 	}
 
 	CsvReadRootScope::CsvReadRootScope(std::istream& encodedInputStream, SerializationContext& serializationContext)
 		: TArchiveScope<SerializeMode::Load>(serializationContext)
-		, mCsvReader(std::make_unique<CCsvStreamReader>(encodedInputStream, true, serializationContext.GetOptions().valuesSeparator))
+		, mCsvReader(std::make_unique<CCsvStreamReader>(encodedInputStream, true, serializationContext.GetOptions().valuesSeparator, GetReusableBuffers(serializationContext)))
 	{
 		ValidateSeparator(serializationContext.GetOptions().valuesSeparator);
 	}
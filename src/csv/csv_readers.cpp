@@ -8,11 +8,24 @@
 
 namespace BitSerializer::Csv::Detail
 {
-	CCsvStringReader::CCsvStringReader(std::string_view inputString, bool withHeader, char separator)
+	CCsvStringReader::CCsvStringReader(std::string_view inputString, bool withHeader, char separator, CCsvReaderBuffers* reusableBuffers)
 		: mSourceString(inputString)
 		, mWithHeader(withHeader)
 		, mSeparator(separator)
+		, mReusableBuffers(reusableBuffers)
 	{
+		if (mReusableBuffers)
+		{
+			// Header strings are kept for reusing their storage (will be resized to the actual number of columns)
+			mHeaders.swap(mReusableBuffers->Headers);
+			mRowValuesMeta.swap(mReusableBuffers->RowValuesMeta);
+			mTempValueBuffer.swap(mReusableBuffers->TextBuffer);
+			mRowValuesMeta.clear();
+			if (!withHeader) {
+				mHeaders.clear();
+			}
+		}
+
 		if (withHeader)
 		{
 			if (ParseNextLine(mRowValuesMeta))
@@ -32,6 +45,16 @@ namespace BitSerializer::Csv::Detail
 		}
 	}
 
+	CCsvStringReader::~CCsvStringReader()
+	{
+		if (mReusableBuffers)
+		{
+			mReusableBuffers->Headers.swap(mHeaders);
+			mReusableBuffers->RowValuesMeta.swap(mRowValuesMeta);
+			mReusableBuffers->TextBuffer.swap(mTempValueBuffer);
+		}
+	}
+
 	bool CCsvStringReader::ReadValue(std::string_view key, std::string_view& out_value)
 	{
 		if (!mWithHeader) {
@@ -218,11 +241,24 @@ namespace BitSerializer::Csv::Detail
 
 	//------------------------------------------------------------------------------
 
-	CCsvStreamReader::CCsvStreamReader(std::istream& inputStream, bool withHeader, char separator)
+	CCsvStreamReader::CCsvStreamReader(std::istream& inputStream, bool withHeader, char separator, CCsvReaderBuffers* reusableBuffers)
 		: mEncodedStreamReader(inputStream)
 		, mWithHeader(withHeader)
 		, mSeparator(separator)
+		, mReusableBuffers(reusableBuffers)
 	{
+		if (mReusableBuffers)
+		{
+			mHeaders.swap(mReusableBuffers->Headers);
+			mRowValuesMeta.swap(mReusableBuffers->RowValuesMeta);
+			mDecodedBuffer.swap(mReusableBuffers->TextBuffer);
+			mRowValuesMeta.clear();
+			mDecodedBuffer.clear();
+			if (!withHeader) {
+				mHeaders.clear();
+			}
+		}
+
 		if (withHeader)
 		{
 			if (ParseNextLine(mRowValuesMeta))
@@ -242,6 +278,16 @@ namespace BitSerializer::Csv::Detail
 		}
 	}
 
+	CCsvStreamReader::~CCsvStreamReader()
+	{
+		if (mReusableBuffers)
+		{
+			mReusableBuffers->Headers.swap(mHeaders);
+			mReusableBuffers->RowValuesMeta.swap(mRowValuesMeta);
+			mReusableBuffers->TextBuffer.swap(mDecodedBuffer);
+		}
+	}
+
 	bool CCsvStreamReader::ReadValue(std::string_view key, std::string_view& out_value)
 	{
 		if (!mWithHeader) {
@@ -263,7 +309,7 @@ namespace BitSerializer::Csv::Detail
 		const auto& valueMeta = mRowValuesMeta.at(mValueIndex);
 		if (valueMeta.HasEscapedChars)
 		{
-			out_value = UnescapeValue(mDecodedBuffer.data() + valueMeta.Offset, mDecodedBuffer.data() + valueMeta.Size);
+			out_value = UnescapeValue(mDecodedBuffer.data() + valueMeta.Offset, mDecodedBuffer.data() + valueMeta.Offset + valueMeta.Size);
 		}
 		else
 		{
@@ -332,8 +378,8 @@ namespace BitSerializer::Csv::Detail
 		++mLineNumber;
 		mPrevValuesCount = out_values.size();
 		out_values.clear();
-		// Remove parsed string part
-		if (mCurrentPos)
+		// Remove parsed string part (only when it takes at least half of buffer, to avoid moving the rest of data after each line)
+		if (mCurrentPos && mCurrentPos * 2 >= mDecodedBuffer.size())
 		{
 			mDecodedBuffer.erase(0, mCurrentPos);
 			mCurrentPos = 0;
@@ -19,10 +19,21 @@ namespace BitSerializer::Csv::Detail
 		bool HasEscapedChars;
 	};
 
+	/// <summary>
+	/// Buffers of CSV reader, which can be reused between serialization calls of one session.
+	/// </summary>
+	struct CCsvReaderBuffers
+	{
+		std::vector<std::string> Headers;
+		std::vector<CValueMeta> RowValuesMeta;
+		std::string TextBuffer;
+	};
+
 	class CCsvStringReader final : public ICsvReader
 	{
 	public:
-		CCsvStringReader(std::string_view inputString, bool withHeader, char separator = ',');
+		CCsvStringReader(std::string_view inputString, bool withHeader, char separator = ',', CCsvReaderBuffers* reusableBuffers = nullptr);
+		~CCsvStringReader() override;
 
 		[[nodiscard]] size_t GetCurrentIndex() const noexcept override { return mRowIndex; }
 		[[nodiscard]] bool IsEnd() const noexcept override { return mCurrentPos >= mSourceString.size(); }
@@ -42,6 +53,7 @@ namespace BitSerializer::Csv::Detail
 		std::vector<std::string> mHeaders;
 		std::vector<CValueMeta> mRowValuesMeta;
 		std::string mTempValueBuffer;
+		CCsvReaderBuffers* mReusableBuffers;
 		size_t mCurrentPos = 0;
 		size_t mLineNumber = 0;
 		size_t mRowIndex = 0;
@@ -52,7 +64,8 @@ namespace BitSerializer::Csv::Detail
 	class CCsvStreamReader final : public ICsvReader
 	{
 	public:
-		CCsvStreamReader(std::istream& inputStream, bool withHeader, char separator = ',');
+		CCsvStreamReader(std::istream& inputStream, bool withHeader, char separator = ',', CCsvReaderBuffers* reusableBuffers = nullptr);
+		~CCsvStreamReader() override;
 
 		[[nodiscard]] size_t GetCurrentIndex() const noexcept override { return mRowIndex; }
 		[[nodiscard]] bool IsEnd() const override { return mCurrentPos >= mDecodedBuffer.size() && mEncodedStreamReader.IsEnd(); }
@@ -72,6 +85,7 @@ namespace BitSerializer::Csv::Detail
 
 		std::vector<std::string> mHeaders;
 		std::vector<CValueMeta> mRowValuesMeta;
+		CCsvReaderBuffers* mReusableBuffers;
 		size_t mCurrentPos = 0;
 		size_t mLineNumber = 0;
 		size_t mRowIndex = 0;
@@ -165,6 +165,41 @@ namespace BitSerializer::Csv::Detail
 		mCurrentRow.clear();
 	}
 
+	void CCsvStringWriter::WriteFragment(const CsvRowsFragment& fragment)
+	{
+		if (fragment.rowsCount == 0)
+		{
+			return;
+		}
+
+		if (mRowIndex == 0)
+		{
+			if (mWithHeader)
+			{
+				mOutputString.append(fragment.header);
+				mOutputString.push_back('\r');
+				mOutputString.push_back('\n');
+			}
+
+			// Reserve output buffer
+			if (mEstimatedSize > fragment.rowsCount)
+			{
+				const auto estimatedByteSize = mOutputString.size()
+					+ static_cast<size_t>(static_cast<double>(fragment.rows.size()) / static_cast<double>(fragment.rowsCount) * static_cast<double>(mEstimatedSize) * 1.2);
+				mOutputString.reserve(estimatedByteSize);
+			}
+			mPrevValuesCount = fragment.valuesCount;
+		}
+		else if (fragment.valuesCount != mPrevValuesCount)
+		{
+			throw SerializationException(SerializationErrorCode::OutOfRange,
+				"Number of values are different than in previous line");
+		}
+
+		mOutputString.append(fragment.rows);
+		mRowIndex += fragment.rowsCount;
+	}
+
 	//------------------------------------------------------------------------------
 
 	CCsvStreamWriter::CCsvStreamWriter(std::ostream& outputStream, bool withHeader, char separator, const StreamOptions& streamOptions)
@@ -231,4 +266,102 @@ namespace BitSerializer::Csv::Detail
 		mValueIndex = 0;
 		mCurrentRow.clear();
 	}
+
+	void CCsvStreamWriter::WriteFragment(const CsvRowsFragment& fragment)
+	{
+		if (fragment.rowsCount == 0)
+		{
+			return;
+		}
+
+		if (mRowIndex == 0)
+		{
+			if (mWithHeader)
+			{
+				mCsvHeader = fragment.header;
+				mCsvHeader.push_back('\r');
+				mCsvHeader.push_back('\n');
+				WriteToStreamWithEncoding(mCsvHeader, mOutputStream, mStreamOptions.encoding);
+			}
+			mPrevValuesCount = fragment.valuesCount;
+		}
+		else if (fragment.valuesCount != mPrevValuesCount)
+		{
+			throw SerializationException(SerializationErrorCode::OutOfRange,
+				"Number of values are different than in previous line");
+		}
+
+		WriteToStreamWithEncoding(fragment.rows, mOutputStream, mStreamOptions.encoding);
+		mRowIndex += fragment.rowsCount;
+	}
+
+	//------------------------------------------------------------------------------
+
+	CCsvShardWriter::CCsvShardWriter(char separator)
+		: mSeparator(separator)
+	{
+		mFragment.header.reserve(256);
+	}
+
+	void CCsvShardWriter::WriteValue(const std::string_view& key, const std::string& value)
+	{
+		// Collect keys only from the first row
+		if (mFragment.rowsCount == 0)
+		{
+			if (mValueIndex)
+			{
+				mFragment.header.push_back(mSeparator);
+			}
+			WriteEscapedValue(key, mFragment.header, mSeparator);
+		}
+
+		if (mValueIndex)
+		{
+			mFragment.rows.push_back(mSeparator);
+		}
+		WriteEscapedValue(value, mFragment.rows, mSeparator);
+		++mValueIndex;
+	}
+
+	void CCsvShardWriter::NextLine()
+	{
+		if (mFragment.rowsCount == 0)
+		{
+			mFragment.valuesCount = mValueIndex;
+		}
+		else if (mValueIndex != mFragment.valuesCount)
+		{
+			// Compare number of values with previous row
+			throw SerializationException(SerializationErrorCode::OutOfRange,
+				"Number of values are different than in previous line");
+		}
+
+		mFragment.rows.push_back('\r');
+		mFragment.rows.push_back('\n');
+
+		++mFragment.rowsCount;
+		mValueIndex = 0;
+	}
+
+	void CCsvShardWriter::WriteFragment(const CsvRowsFragment& fragment)
+	{
+		if (fragment.rowsCount == 0)
+		{
+			return;
+		}
+
+		if (mFragment.rowsCount == 0)
+		{
+			mFragment.header = fragment.header;
+			mFragment.valuesCount = fragment.valuesCount;
+		}
+		else if (fragment.valuesCount != mFragment.valuesCount)
+		{
+			throw SerializationException(SerializationErrorCode::OutOfRange,
+				"Number of values are different than in previous line");
+		}
+
+		mFragment.rows.append(fragment.rows);
+		mFragment.rowsCount += fragment.rowsCount;
+	}
 }
@@ -15,6 +15,7 @@ namespace BitSerializer::Csv::Detail
 		void SetEstimatedSize(size_t size) override;
 		void WriteValue(const std::string_view& key, const std::string& value) override;
 		void NextLine() override;
+		void WriteFragment(const CsvRowsFragment& fragment) override;
 		[[nodiscard]] size_t GetCurrentIndex() const noexcept override { return mRowIndex; }
 
 	private:
@@ -37,6 +38,7 @@ namespace BitSerializer::Csv::Detail
 		void SetEstimatedSize(size_t size) noexcept override { /* Not required for stream */ }
 		void WriteValue(const std::string_view& key, const std::string& value) override;
 		void NextLine() override;
+		void WriteFragment(const CsvRowsFragment& fragment) override;
 		[[nodiscard]] size_t GetCurrentIndex() const noexcept override { return mRowIndex; }
 
 	private:
@@ -51,4 +53,27 @@ namespace BitSerializer::Csv::Detail
 		size_t mValueIndex = 0;
 		size_t mPrevValuesCount = 0;
 	};
+
+	/// <summary>
+	/// Writes rows to the fragment, which is merged into the main output later (used for parallel saving).
+	/// </summary>
+	class CCsvShardWriter final : public ICsvWriter
+	{
+	public:
+		explicit CCsvShardWriter(char separator = ',');
+
+		void SetEstimatedSize(size_t size) noexcept override { /* Not required for shard */ }
+		void WriteValue(const std::string_view& key, const std::string& value) override;
+		void NextLine() override;
+		void WriteFragment(const CsvRowsFragment& fragment) override;
+		[[nodiscard]] size_t GetCurrentIndex() const noexcept override { return mFragment.rowsCount; }
+
+		[[nodiscard]] CsvRowsFragment TakeFragment() noexcept { return std::move(mFragment); }
+
+	private:
+		const char mSeparator;
+
+		CsvRowsFragment mFragment;
+		size_t mValueIndex = 0;
+	};
 }
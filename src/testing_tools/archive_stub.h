@@ -6,6 +6,7 @@
 #include <cassert>
 #include <string>
 #include <map>
+#include <memory>
 #include <variant>
 #include <optional>
 #include <type_traits>
@@ -201,7 +202,60 @@ public:
 	/// </summary>
 	[[nodiscard]] size_t GetEstimatedSize() const
 	{
-		return 0;
+		// Returns the exact size only when parallel loading is enabled, for testing both ways of loading containers
+		return this->GetOptions().parallelOptions.enableParallelLoad ? GetSize() : 0;
+	}
+
+	/// <summary>
+	/// Creates an independent scope for loading items starting from the specified index (used for parallel loading).
+	/// </summary>
+	[[nodiscard]] ArchiveStubArrayScope CreateShard(size_t startIndex, SerializationContext& serializationContext) const
+	{
+		static_assert(TMode == SerializeMode::Load);
+		ArchiveStubArrayScope shardScope(mNode, serializationContext, mParent, mParentKey);
+		shardScope.mIndex = startIndex;
+		return shardScope;
+	}
+
+	/// <summary>
+	/// Returns `true` when the array can be saved via shards (used for parallel saving).
+	/// </summary>
+	[[nodiscard]] bool CanCreateShards() const noexcept
+	{
+		return TMode == SerializeMode::Save;
+	}
+
+	/// <summary>
+	/// Creates an independent scope which saves the specified number of items to its own array (used for parallel saving).
+	/// </summary>
+	[[nodiscard]] ArchiveStubArrayScope CreateShard(SerializationContext& serializationContext, size_t itemsNum) const
+	{
+		static_assert(TMode == SerializeMode::Save);
+		auto shardData = std::make_unique<TestIoData>();
+		shardData->emplace<TestIoDataArray>(TestIoDataArray(itemsNum));
+		ArchiveStubArrayScope shardScope(shardData.get(), serializationContext, mParent, mParentKey);
+		shardScope.mShardData = std::move(shardData);
+		return shardScope;
+	}
+
+	/// <summary>
+	/// Returns items which were saved to the shard.
+	/// </summary>
+	[[nodiscard]] TestIoDataArray FinalizeShard()
+	{
+		static_assert(TMode == SerializeMode::Save);
+		return std::move(std::get<TestIoDataArray>(*mNode));
+	}
+
+	/// <summary>
+	/// Appends items which were saved to the shard.
+	/// </summary>
+	void MergeShard(TestIoDataArray&& shardItems)
+	{
+		static_assert(TMode == SerializeMode::Save);
+		auto& archiveArray = std::get<TestIoDataArray>(*mNode);
+		archiveArray.insert(archiveArray.end(), std::make_move_iterator(shardItems.begin()), std::make_move_iterator(shardItems.end()));
+		mIndex += shardItems.size();
 	}
 
 	/// <summary>
@@ -310,6 +364,7 @@ protected:
 
 private:
 	size_t mIndex;
+	std::unique_ptr<TestIoData> mShardData;
 };
 
 
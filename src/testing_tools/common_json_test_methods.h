@@ -3,8 +3,11 @@
 * This file is part of BitSerializer library, licensed under the MIT license.  *
 *******************************************************************************/
 #pragma once
+#include <thread>
 #include "gtest/gtest.h"
 #include "common_test_entities.h"
+#include "bitserializer/lazy.h"
+#include "bitserializer/raw_json.h"
 
 /// <summary>
 /// Tests archive method which should return current path in object scope (when loading).
@@ -268,4 +271,204 @@ void TestSaveFormattedJson()
 		"  \"TestValue\": \"Hello world!\"\n"
 		"}");
 	EXPECT_EQ(expected, outputStr);
-}
\ No newline at end of file
+}
+/// <summary>
+/// Test class with the payload which is loaded on demand.
+/// </summary>
+class TestEnvelopeWithLazyPayload
+{
+public:
+	using payload_type = TestClassWithSubTypes<int, std::string, std::vector<TestPointClass>>;
+
+	template <class TArchive>
+	void Serialize(TArchive& archive)
+	{
+		archive << BitSerializer::AutoKeyValue("route", route);
+		archive << BitSerializer::AutoKeyValue("payload", payload);
+	}
+
+	std::string route;
+	BitSerializer::Lazy<payload_type> payload;
+};
+
+/// <summary>
+/// Tests that the lazy value keeps the raw fragment, which is written back as is until the value is accessed for modification.
+/// </summary>
+template <typename TArchive>
+void TestLazyValueWithRawFragment()
+{
+	// Arrange
+	TestEnvelopeWithLazyPayload source;
+	::BuildFixture(source.route);
+	TestEnvelopeWithLazyPayload::payload_type sourcePayload;
+	::BuildFixture(sourcePayload);
+	source.payload = sourcePayload;
+	std::string sourceJson;
+	BitSerializer::SaveObject<TArchive>(source, sourceJson);
+
+	// Act / Assert (load without deserializing the payload)
+	TestEnvelopeWithLazyPayload actual;
+	BitSerializer::LoadObject<TArchive>(actual, sourceJson);
+	EXPECT_EQ(source.route, actual.route);
+	EXPECT_FALSE(actual.payload.IsLoaded());
+	ASSERT_TRUE(actual.payload.HasFragment());
+
+	// Act / Assert (the fragment is written back as is)
+	std::string forwardedJson;
+	BitSerializer::SaveObject<TArchive>(actual, forwardedJson);
+	EXPECT_EQ(sourceJson, forwardedJson);
+	EXPECT_FALSE(actual.payload.IsLoaded());
+
+	// Act / Assert (reading access loads the value, but keeps the fragment)
+	const auto& constActual = actual;
+	sourcePayload.Assert(constActual.payload.Get());
+	EXPECT_TRUE(actual.payload.IsLoaded());
+	EXPECT_TRUE(actual.payload.HasFragment());
+
+	// Act / Assert (modifying access discards the fragment)
+	std::get<0>(*actual.payload) += 1;
+	EXPECT_FALSE(actual.payload.HasFragment());
+	std::string modifiedJson;
+	BitSerializer::SaveObject<TArchive>(actual, modifiedJson);
+	TestEnvelopeWithLazyPayload reloaded;
+	BitSerializer::LoadObject<TArchive>(reloaded, modifiedJson);
+	EXPECT_EQ(std::get<0>(sourcePayload) + 1, std::get<0>(reloaded.payload.Get()));
+}
+
+/// <summary>
+/// Tests that the lazy value is loaded only once, when it is accessed concurrently from several threads.
+/// </summary>
+template <typename TArchive>
+void TestLazyValueConcurrentAccess(size_t threadsNum = 8)
+{
+	// Arrange
+	TestEnvelopeWithLazyPayload source;
+	::BuildFixture(source.payload.Get());
+	std::string sourceJson;
+	BitSerializer::SaveObject<TArchive>(source, sourceJson);
+	TestEnvelopeWithLazyPayload actual;
+	BitSerializer::LoadObject<TArchive>(actual, sourceJson);
+	const auto& constActual = actual;
+
+	// Act
+	std::vector<const TestEnvelopeWithLazyPayload::payload_type*> loadedValues(threadsNum);
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < threadsNum; ++i) {
+		threads.emplace_back([&constActual, &loadedValues, i]() { loadedValues[i] = &constActual.payload.Get(); });
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+
+	// Assert
+	for (const auto* loadedValue : loadedValues)
+	{
+		ASSERT_EQ(loadedValues.front(), loadedValue);
+		source.payload.Get().Assert(*loadedValue);
+	}
+}
+
+/// <summary>
+/// Tests that the lazy values in array (without keys) keep raw fragments.
+/// </summary>
+template <typename TArchive>
+void TestLazyValuesInArray()
+{
+	// Arrange
+	std::vector<BitSerializer::Lazy<TestPointClass>> source(5);
+	for (auto& item : source) {
+		::BuildFixture(item.Get());
+	}
+	std::string sourceJson;
+	BitSerializer::SaveObject<TArchive>(source, sourceJson);
+
+	// Act
+	std::vector<BitSerializer::Lazy<TestPointClass>> actual;
+	BitSerializer::LoadObject<TArchive>(actual, sourceJson);
+	std::string forwardedJson;
+	BitSerializer::SaveObject<TArchive>(actual, forwardedJson);
+
+	// Assert
+	EXPECT_EQ(sourceJson, forwardedJson);
+	ASSERT_EQ(source.size(), actual.size());
+	for (size_t i = 0; i < source.size(); ++i)
+	{
+		EXPECT_TRUE(actual[i].HasFragment());
+		EXPECT_EQ(std::as_const(source[i]).Get(), std::as_const(actual[i]).Get());
+	}
+}
+
+/// <summary>
+/// Test class with the payload which is already encoded JSON.
+/// </summary>
+template <typename TRawJson>
+class TestEnvelopeWithRawPayload
+{
+public:
+	template <class TArchive>
+	void Serialize(TArchive& archive)
+	{
+		archive << BitSerializer::AutoKeyValue("route", route);
+		archive << BitSerializer::AutoKeyValue("payload", payload);
+	}
+
+	std::string route;
+	TRawJson payload;
+};
+
+/// <summary>
+/// Tests serialization of raw JSON values (borrowed on save and captured on load).
+/// </summary>
+template <typename TArchive>
+void TestRawJsonValue()
+{
+	// Arrange
+	const std::string cachedFragment = R"({"x":10,"y":20,"z":[1,2,"text"]})";
+	TestEnvelopeWithRawPayload<BitSerializer::RawJsonView> source;
+	source.route = "test";
+	source.payload = BitSerializer::RawJsonView(cachedFragment);
+
+	// Act
+	std::string outputJson;
+	BitSerializer::SaveObject<TArchive>(source, outputJson);
+	TestEnvelopeWithRawPayload<BitSerializer::RawJson> actual;
+	BitSerializer::LoadObject<TArchive>(actual, outputJson);
+
+	// Assert
+	EXPECT_EQ("test", actual.route);
+	EXPECT_EQ(cachedFragment, actual.payload.Get());
+	TestPointClass point;
+	BitSerializer::LoadObject<TArchive>(point, actual.payload.Get());
+	EXPECT_EQ(TestPointClass(10, 20), point);
+}
+
+/// <summary>
+/// Tests serialization of raw JSON values in array and at the root scope, the empty value should be saved as null.
+/// </summary>
+template <typename TArchive>
+void TestRawJsonValuesInArray()
+{
+	// Arrange
+	std::vector<BitSerializer::RawJson> source = {
+		BitSerializer::RawJson(R"({"x":1})"),
+		BitSerializer::RawJson("[1,2]"),
+		BitSerializer::RawJson("\"str\""),
+		BitSerializer::RawJson()
+	};
+
+	// Act
+	std::string outputJson;
+	BitSerializer::SaveObject<TArchive>(source, outputJson);
+	std::vector<BitSerializer::RawJson> actual;
+	BitSerializer::LoadObject<TArchive>(actual, outputJson);
+	BitSerializer::RawJson rootValue;
+	BitSerializer::LoadObject<TArchive>(rootValue, outputJson);
+
+	// Assert
+	ASSERT_EQ(source.size(), actual.size());
+	for (size_t i = 0; i + 1 < source.size(); ++i) {
+		EXPECT_EQ(source[i], actual[i]);
+	}
+	EXPECT_EQ("null", actual.back().Get());
+	EXPECT_EQ(R"([{"x":1},[1,2],"str",null])", rootValue.Get());
+}
@@ -5,8 +5,10 @@
 #pragma once
 #include <filesystem>
 #include <optional>
+#include <sstream>
 #include "common_test_entities.h"
 #include "bitserializer/types/std/vector.h"
+#include "bitserializer/push_loader.h"
 
 
 /// <summary>
@@ -203,6 +205,86 @@ void TestSerializeArrayToStream(T(&testArray)[ArraySize])
 	}
 }
 
+/// <summary>
+/// Test template of loading only the part of document, which is addressed by path.
+/// </summary>
+template <typename TArchive>
+void TestLoadObjectByPath()
+{
+	// Arrange
+	TestClassWithSubTypes<int, TestPointClass, std::vector<TestPointClass>> source;
+	::BuildFixture(source);
+	std::get<2>(source).resize(3);
+	for (auto& point : std::get<2>(source)) {
+		::BuildFixture(point);
+	}
+	const auto output = BitSerializer::SaveObject<TArchive>(source);
+	const char separator = TArchive::path_separator;
+	const auto makePath = [separator](std::initializer_list<std::string_view> segments)
+	{
+		std::string path;
+		for (const auto segment : segments) {
+			path.append(1, separator).append(segment);
+		}
+		return path;
+	};
+
+	// Act / Assert
+	int intValue = 0;
+	EXPECT_TRUE(BitSerializer::LoadObject<TArchive>(intValue, output, makePath({ "Member_0" })));
+	EXPECT_EQ(std::get<0>(source), intValue);
+
+	TestPointClass point;
+	EXPECT_TRUE(BitSerializer::LoadObject<TArchive>(point, output, makePath({ "Member_1" })));
+	EXPECT_EQ(std::get<1>(source), point);
+
+	EXPECT_TRUE(BitSerializer::LoadObject<TArchive>(intValue, output, makePath({ "Member_1", "y" })));
+	EXPECT_EQ(std::get<1>(source).y, intValue);
+
+	EXPECT_TRUE(BitSerializer::LoadObject<TArchive>(point, output, makePath({ "Member_2", "2" })));
+	EXPECT_EQ(std::get<2>(source)[2], point);
+
+	EXPECT_TRUE(BitSerializer::LoadObject<TArchive>(intValue, output, makePath({ "Member_2", "1", "x" })));
+	EXPECT_EQ(std::get<2>(source)[1].x, intValue);
+
+	std::vector<TestPointClass> points;
+	EXPECT_TRUE(BitSerializer::LoadObject<TArchive>(points, output, makePath({ "Member_2" })));
+	EXPECT_EQ(std::get<2>(source), points);
+
+	EXPECT_FALSE(BitSerializer::LoadObject<TArchive>(point, output, makePath({ "Member_2", "3" })));
+	EXPECT_FALSE(BitSerializer::LoadObject<TArchive>(point, output, makePath({ "Member_2", "x" })));
+	EXPECT_FALSE(BitSerializer::LoadObject<TArchive>(intValue, output, makePath({ "Missing", "x" })));
+	EXPECT_THROW(BitSerializer::LoadObject<TArchive>(intValue, output, "Member_0"), BitSerializer::SerializationException);
+}
+
+/// <summary>
+/// Test template of loading the row of CSV-like document (root array), which is addressed by path.
+/// </summary>
+template <typename TArchive>
+void TestLoadArrayItemByPath()
+{
+	// Arrange
+	std::vector<TestPointClass> source(10);
+	for (auto& point : source) {
+		::BuildFixture(point);
+	}
+	const auto output = BitSerializer::SaveObject<TArchive>(source);
+	const std::string separator(1, TArchive::path_separator);
+
+	// Act / Assert
+	TestPointClass point;
+	EXPECT_TRUE(BitSerializer::LoadObject<TArchive>(point, output, separator + "7"));
+	EXPECT_EQ(source[7], point);
+
+	int intValue = 0;
+	std::stringstream stream(output);
+	EXPECT_TRUE(BitSerializer::LoadObject<TArchive>(intValue, stream, separator + "3" + separator + "y"));
+	EXPECT_EQ(source[3].y, intValue);
+
+	EXPECT_FALSE(BitSerializer::LoadObject<TArchive>(point, output, separator + "10"));
+	EXPECT_FALSE(BitSerializer::LoadObject<TArchive>(point, output, separator + "-1"));
+}
+
 /// <summary>
 /// Test template of serialization to file.
 /// </summary>
@@ -225,6 +307,57 @@ void TestSerializeArrayToFile()
 	}
 }
 
+/// <summary>
+/// Test template of serialization to compressed file (the compression is detected automatically on load, except zlib).
+/// </summary>
+template <typename TArchive, size_t ArraySize = 1000>
+void TestSerializeArrayToCompressedFile(BitSerializer::CompressionType compression)
+{
+	// Arrange
+	auto path = std::filesystem::temp_directory_path() / "TestArchiveCompressed.data";
+	std::vector<TestPointClass> testArray(ArraySize), actual;
+	for (auto& value : testArray) {
+		::BuildFixture(value);
+	}
+	BitSerializer::SerializationOptions serializationOptions;
+	serializationOptions.streamOptions.compression = compression;
+	// The zlib stream has no reliable signature, so it should be set explicitly for loading
+	BitSerializer::SerializationOptions loadOptions;
+	const bool isDetectable = compression != BitSerializer::CompressionType::Zlib;
+	loadOptions.streamOptions.inputCompression = isDetectable ? BitSerializer::CompressionType::None : compression;
+
+	// Act
+	BitSerializer::SaveObjectToFile<TArchive>(testArray, path, serializationOptions);
+	BitSerializer::LoadObjectFromFile<TArchive>(actual, path, loadOptions);
+
+	// Assert
+	EXPECT_EQ(testArray, actual);
+	std::ifstream file(path, std::ios::binary);
+	const std::string fileContent{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+	EXPECT_EQ(isDetectable ? compression : BitSerializer::CompressionType::None, BitSerializer::Detail::DetectCompression(fileContent));
+}
+
+/// <summary>
+/// Test template of asynchronous serialization to file.
+/// </summary>
+template <typename TArchive, size_t ArraySize = 1000>
+void TestSerializeArrayToFileAsync()
+{
+	// Arrange
+	auto path = std::filesystem::temp_directory_path() / "TestArchiveAsync.data";
+	std::vector<TestPointClass> testArray(ArraySize), actual;
+	for (auto& value : testArray) {
+		::BuildFixture(value);
+	}
+
+	// Act
+	BitSerializer::SaveObjectToFileAsync<TArchive>(testArray, path).get();
+	BitSerializer::LoadObjectFromFileAsync<TArchive>(actual, path).get();
+
+	// Assert
+	EXPECT_EQ(testArray, actual);
+}
+
 /// <summary>
 /// Test template of serialization for STL containers.
 /// </summary>
@@ -491,3 +624,235 @@ void TestIterateKeysInObjectScope()
 	++it;
 	EXPECT_TRUE(it == endIt);
 }
+
+/// <summary>
+/// Template for test parallel loading of large array to STL container with random access iterators.
+/// </summary>
+template <typename TArchive, typename TContainer>
+void TestParallelLoadContainer(size_t arraySize = 1000)
+{
+	// Arrange
+	TContainer expected(arraySize);
+	for (auto& value : expected) {
+		::BuildFixture(value);
+	}
+	typename TArchive::preferred_output_format outputArchive;
+	BitSerializer::SerializationOptions options;
+	options.parallelOptions.enableParallelLoad = true;
+	options.parallelOptions.minArraySize = 10;
+	options.parallelOptions.maxThreads = 4;
+	TContainer actual;
+
+	// Act
+	BitSerializer::SaveObject<TArchive>(expected, outputArchive);
+	BitSerializer::LoadObject<TArchive>(actual, outputArchive, options);
+
+	// Assert
+	EXPECT_EQ(expected, actual);
+}
+
+/// <summary>
+/// Template for test collecting validation errors from all threads when loading array in parallel.
+/// The errors (including their paths) should be the same as when loading sequentially.
+/// </summary>
+template <typename TArchive>
+void TestValidationWhenParallelLoadArray(size_t arraySize = 100)
+{
+	// Arrange
+	std::vector<TestClassForCheckValidation<int>> testObj(arraySize);
+	for (auto& value : testObj) {
+		::BuildFixture(value);
+	}
+	typename TArchive::preferred_output_format outputArchive;
+	BitSerializer::SaveObject<TArchive>(testObj, outputArchive);
+
+	auto loadAndGetErrors = [&testObj, &outputArchive](bool enableParallelLoad)
+	{
+		BitSerializer::SerializationOptions options;
+		options.parallelOptions.enableParallelLoad = enableParallelLoad;
+		options.parallelOptions.minArraySize = 10;
+		options.parallelOptions.maxThreads = 4;
+		try
+		{
+			BitSerializer::LoadObject<TArchive>(testObj, outputArchive, options);
+		}
+		catch (const BitSerializer::ValidationException& ex)
+		{
+			return ex.GetValidationErrors();
+		}
+		return BitSerializer::ValidationMap();
+	};
+
+	// Act
+	const auto expectedErrors = loadAndGetErrors(false);
+	const auto actualErrors = loadAndGetErrors(true);
+
+	// Assert
+	EXPECT_EQ(arraySize, actualErrors.size());
+	EXPECT_EQ(expectedErrors, actualErrors);
+}
+
+/// <summary>
+/// Template for test parallel saving of large array (the result should be the same as when saving sequentially).
+/// </summary>
+template <typename TArchive, typename TContainer>
+void TestParallelSaveContainer(size_t arraySize = 1000, BitSerializer::SerializationOptions options = {})
+{
+	// Arrange
+	TContainer expected(arraySize);
+	for (auto& value : expected) {
+		::BuildFixture(value);
+	}
+	using OutputFormat = typename TArchive::preferred_output_format;
+	OutputFormat expectedOutput, actualOutput;
+	BitSerializer::SaveObject<TArchive>(expected, expectedOutput, options);
+	options.parallelOptions.enableParallelSave = true;
+	options.parallelOptions.minArraySize = 10;
+	options.parallelOptions.maxThreads = 4;
+	TContainer actual;
+
+	// Act
+	BitSerializer::SaveObject<TArchive>(expected, actualOutput, options);
+	BitSerializer::LoadObject<TArchive>(actual, actualOutput);
+
+	// Assert
+	EXPECT_EQ(expected, actual);
+	if constexpr (std::is_same_v<OutputFormat, std::string> || std::is_same_v<OutputFormat, std::wstring>) {
+		EXPECT_EQ(expectedOutput, actualOutput);
+	}
+}
+
+/// <summary>
+/// Template for test parallel saving of large array to stream (the result should be the same as when saving sequentially).
+/// </summary>
+template <typename TArchive, typename TContainer>
+void TestParallelSaveContainerToStream(BitSerializer::SerializationOptions options = {}, size_t arraySize = 1000)
+{
+	// Arrange
+	TContainer expected(arraySize);
+	for (auto& value : expected) {
+		::BuildFixture(value);
+	}
+	std::stringstream expectedStream, actualStream;
+	BitSerializer::SaveObject<TArchive>(expected, expectedStream, options);
+	options.parallelOptions.enableParallelSave = true;
+	options.parallelOptions.minArraySize = 10;
+	options.parallelOptions.maxThreads = 4;
+
+	// Act
+	BitSerializer::SaveObject<TArchive>(expected, actualStream, options);
+
+	// Assert
+	EXPECT_EQ(expectedStream.str(), actualStream.str());
+}
+
+/// <summary>
+/// Template for test serializer session, which reuses resources between calls (the result should be the same as without session).
+/// </summary>
+template <typename TArchive, typename TContainer>
+void TestSerializerSession()
+{
+	// Arrange
+	BitSerializer::SerializerSession<TArchive> session;
+	const size_t sizes[] = { 10, 100, 3, 100 };
+
+	for (const size_t size : sizes)
+	{
+		TContainer expected(size), actual, actualFromStream;
+		for (auto& value : expected) {
+			::BuildFixture(value);
+		}
+		const auto expectedOutput = BitSerializer::SaveObject<TArchive>(expected);
+
+		// Act
+		const auto actualOutput = session.SaveObject(expected);
+		session.LoadObject(actual, actualOutput);
+		std::stringstream stream;
+		session.SaveObject(expected, stream);
+		session.LoadObject(actualFromStream, stream);
+
+		// Assert
+		EXPECT_EQ(expectedOutput, actualOutput);
+		EXPECT_EQ(expected, actual);
+		EXPECT_EQ(expected, actualFromStream);
+	}
+}
+
+/// <summary>
+/// Template for test saving and loading of the batch of independent objects, the invalid input should fail only its own item.
+/// </summary>
+template <typename TArchive, typename T>
+void TestSaveLoadObjectsBatch(size_t batchSize = 100)
+{
+	// Arrange
+	std::vector<T> expected(batchSize), actual;
+	for (auto& value : expected) {
+		::BuildFixture(value);
+	}
+	std::vector<typename TArchive::preferred_output_format> outputs;
+	BitSerializer::ThreadPool threadPool(3);
+
+	// Act
+	const auto saveErrors = BitSerializer::SaveObjects<TArchive>(expected, outputs, {}, threadPool);
+	const size_t invalidItemIndex = batchSize / 2;
+	outputs[invalidItemIndex].clear();
+	const auto loadErrors = BitSerializer::LoadObjects<TArchive>(outputs, actual, {}, threadPool);
+
+	// Assert
+	ASSERT_EQ(batchSize, saveErrors.size());
+	ASSERT_EQ(batchSize, loadErrors.size());
+	ASSERT_EQ(batchSize, actual.size());
+	for (size_t i = 0; i < batchSize; ++i)
+	{
+		EXPECT_FALSE(saveErrors[i]);
+		if (i == invalidItemIndex)
+		{
+			ASSERT_TRUE(loadErrors[i]);
+			EXPECT_THROW(std::rethrow_exception(loadErrors[i]), BitSerializer::ParsingException);
+		}
+		else
+		{
+			EXPECT_FALSE(loadErrors[i]);
+			EXPECT_EQ(BitSerializer::SaveObject<TArchive>(expected[i]), outputs[i]);
+			EXPECT_EQ(expected[i], actual[i]);
+		}
+	}
+}
+
+/// <summary>
+/// Template for test push-style loading, when the data is fed by chunks of specified size.
+/// </summary>
+template <typename TArchive, typename T>
+void TestPushLoader(std::vector<T>& expected, size_t chunkSize)
+{
+	// Arrange
+	const auto output = BitSerializer::SaveObject<TArchive>(expected);
+	std::vector<T> actual;
+	BitSerializer::PushLoader<TArchive, T> loader([&actual](T&& item) {
+		actual.emplace_back(std::move(item));
+	});
+
+	// Act
+	for (size_t pos = 0; pos < output.size(); pos += chunkSize) {
+		loader.Feed(std::string_view(output).substr(pos, chunkSize));
+	}
+	loader.Finish();
+
+	// Assert
+	EXPECT_EQ(expected, actual);
+}
+
+/// <summary>
+/// Template for test push-style loading of array with different sizes of chunks.
+/// </summary>
+template <typename TArchive, typename T>
+void TestPushLoader(size_t arraySize = 100)
+{
+	std::vector<T> expected(arraySize);
+	for (auto& value : expected) {
+		::BuildFixture(value);
+	}
+	for (const size_t chunkSize : { 1, 7, 64, 100000 }) {
+		TestPushLoader<TArchive>(expected, chunkSize);
+	}
+}
@@ -77,6 +77,24 @@ TEST(ConvertApi, ToWString) {
 	EXPECT_EQ(L"500", Convert::ToWString(500));
 }
 
+//-----------------------------------------------------------------------------
+// Test function AppendTo
+//-----------------------------------------------------------------------------
+TEST(ConvertApi, AppendToShouldAppendValuesToString) {
+	std::string actual = "values:";
+	Convert::AppendTo(-15, actual);
+	Convert::AppendTo(",", actual);
+	Convert::AppendTo(2.5, actual);
+	EXPECT_EQ("values:-15,2.5", actual);
+}
+
+TEST(ConvertApi, AppendToShouldAppendValuesToUtf16String) {
+	std::u16string actual = u"[";
+	Convert::AppendTo(std::numeric_limits<uint64_t>::max(), actual);
+	Convert::AppendTo(u8"]", actual);
+	EXPECT_EQ(u"[18446744073709551615]", actual);
+}
+
 //-----------------------------------------------------------------------------
 // Test registration of stream operations for Convert::UtfType
 //-----------------------------------------------------------------------------
@@ -6,6 +6,24 @@
 
 using namespace BitSerializer;
 
+namespace
+{
+	enum class TestSparseEnum : int64_t
+	{
+		Min = INT64_MIN,
+		Zero = 0,
+		Thousand = 1000,
+		Max = INT64_MAX
+	};
+}
+
+REGISTER_ENUM(TestSparseEnum, {
+	{ TestSparseEnum::Max,		"Max" },
+	{ TestSparseEnum::Thousand,	"Thousand" },
+	{ TestSparseEnum::Zero,		"Zero" },
+	{ TestSparseEnum::Min,		"Min" }
+})
+
 //-----------------------------------------------------------------------------
 // Test conversion for enum types
 //-----------------------------------------------------------------------------
@@ -62,6 +80,23 @@ TEST(ConvertEnums, ConvertEnumChainFromStream) {
 	EXPECT_EQ(TestEnum::Two, actualEnum2);
 }
 
+TEST(ConvertEnums, ShouldConvertSparseEnum) {
+	EXPECT_EQ("Min", Convert::ToString(TestSparseEnum::Min));
+	EXPECT_EQ("Thousand", Convert::ToString(TestSparseEnum::Thousand));
+	EXPECT_EQ("Max", Convert::ToString(TestSparseEnum::Max));
+	EXPECT_EQ(TestSparseEnum::Min, Convert::To<TestSparseEnum>("min"));
+	EXPECT_EQ(TestSparseEnum::Zero, Convert::To<TestSparseEnum>(u"ZERO"));
+	EXPECT_EQ(TestSparseEnum::Max, Convert::To<TestSparseEnum>(U"mAx"));
+}
+
+TEST(ConvertEnums, ShouldThrowExceptionWhenEnumIsNotRegistered) {
+	EXPECT_THROW(Convert::ToString(static_cast<TestEnum>(100)), std::invalid_argument);
+	EXPECT_THROW(Convert::ToString(static_cast<TestSparseEnum>(999)), std::invalid_argument);
+	EXPECT_THROW(Convert::To<TestEnum>("Zero"), std::invalid_argument);
+	EXPECT_THROW(Convert::To<TestSparseEnum>("Thousands"), std::invalid_argument);
+	EXPECT_THROW(Convert::To<TestSparseEnum>(""), std::invalid_argument);
+}
+
 
 //-----------------------------------------------------------------------------
 // Test conversion for class types (struct, class, union)
@@ -219,6 +219,36 @@ TEST(ConvertFundamentals, UInt64ToString) {
 	EXPECT_EQ(U"18446744073709551615", Convert::To<std::u32string>(std::numeric_limits<uint64_t>::max()));
 }
 
+TEST(ConvertFundamentals, IntegerFromUtf16StringShouldStopAtFirstNonDigit) {
+	EXPECT_EQ(-42, Convert::To<int32_t>(u"-42 kg"));
+	EXPECT_EQ(7u, Convert::To<uint8_t>(U"7."));
+	EXPECT_THROW(Convert::To<uint32_t>(u"-1"), std::invalid_argument);
+	EXPECT_THROW(Convert::To<int32_t>(U"+1"), std::invalid_argument);
+	EXPECT_THROW(Convert::To<int8_t>(u"-"), std::invalid_argument);
+	EXPECT_THROW(Convert::To<int8_t>(u"-129"), std::out_of_range);
+	EXPECT_THROW(Convert::To<uint16_t>(U"999999999999999999999999"), std::out_of_range);
+}
+
+TEST(ConvertFundamentals, TryParseIntegerShouldReturnErrorCodeWithoutChangingValue) {
+	int32_t value = 5;
+	EXPECT_EQ(std::errc(), Convert::Detail::TryParseInteger(std::string_view(" 42"), value));
+	EXPECT_EQ(42, value);
+	EXPECT_EQ(std::errc::not_supported, Convert::Detail::TryParseInteger(std::string_view("1.5"), value));
+	EXPECT_EQ(std::errc::not_supported, Convert::Detail::TryParseInteger(std::u16string_view(u"1.5"), value));
+	EXPECT_EQ(std::errc::invalid_argument, Convert::Detail::TryParseInteger(std::string_view("abc"), value));
+	EXPECT_EQ(std::errc::result_out_of_range, Convert::Detail::TryParseInteger(std::string_view("9999999999"), value));
+	EXPECT_EQ(42, value);
+}
+
+TEST(ConvertFundamentals, IntegerToStringShouldFormatAllDigits) {
+	EXPECT_EQ("-128", Convert::ToString(std::numeric_limits<int8_t>::min()));
+	EXPECT_EQ("9", Convert::ToString(9));
+	EXPECT_EQ("10", Convert::ToString(10));
+	EXPECT_EQ("-100", Convert::ToString(-100));
+	EXPECT_EQ(L"1234567890", Convert::ToWString(1234567890));
+	EXPECT_EQ(u"-2147483648", Convert::To<std::u16string>(std::numeric_limits<int32_t>::min()));
+}
+
 //-----------------------------------------------------------------------------
 TEST(ConvertFundamentals, FloatFromString) {
 	EXPECT_EQ(0.f, Convert::To<float>("  0  "));
@@ -226,6 +256,17 @@ TEST(ConvertFundamentals, FloatFromString) {
 	EXPECT_EQ(-123.123f, Convert::To<float>(U"  -123.123  "));
 }
 
+TEST(ConvertFundamentals, FloatFromStringShouldRoundTrip) {
+	EXPECT_EQ(std::numeric_limits<float>::max(), Convert::To<float>(Convert::ToString(std::numeric_limits<float>::max())));
+	EXPECT_EQ(std::numeric_limits<float>::denorm_min(), Convert::To<float>(Convert::To<std::u16string>(std::numeric_limits<float>::denorm_min())));
+	EXPECT_EQ(0.1f, Convert::To<float>(U"+0.1"));
+}
+
+TEST(ConvertFundamentals, FloatFromStringWithOutOfRangeValueShouldThrowException) {
+	EXPECT_THROW(Convert::To<float>("1e39"), std::out_of_range);
+	EXPECT_THROW(Convert::To<float>(u"-1e39"), std::out_of_range);
+}
+
 TEST(ConvertFundamentals, FloatFromEmptyStringShouldThrowException) {
 	EXPECT_THROW(Convert::To<float>(""), std::invalid_argument);
 }
@@ -236,12 +277,26 @@ TEST(ConvertFundamentals, FloatFromStringWithWrongTextShouldThrowException) {
 	EXPECT_THROW(Convert::To<float>(U"x45.4"), std::invalid_argument);
 }
 
+TEST(ConvertFundamentals, FloatFromStringWithTrailingCharactersShouldThrowException) {
+	EXPECT_THROW(Convert::To<float>("0x10"), std::invalid_argument);
+	EXPECT_THROW(Convert::To<double>(u"1.5 kg"), std::invalid_argument);
+	EXPECT_THROW(Convert::To<double>(U"2.5\u00B0"), std::invalid_argument);
+	EXPECT_EQ(1.5, Convert::To<double>("1.5 \r\n"));
+}
+
 TEST(ConvertFundamentals, FloatToString) {
 	EXPECT_EQ("0", Convert::ToString(0.f));
 	EXPECT_EQ(u"-100.255", Convert::To<std::u16string>(-100.255f));
 	EXPECT_EQ("23613", Convert::ToString(23613.f));
 }
 
+TEST(ConvertFundamentals, FloatToStringShouldBeShortestRoundTrip) {
+	EXPECT_EQ("0.1", Convert::ToString(0.1f));
+	EXPECT_EQ(U"1e-07", Convert::To<std::u32string>(1e-7f));
+	EXPECT_EQ("3.4028235e+38", Convert::ToString(std::numeric_limits<float>::max()));
+	EXPECT_EQ("1e-45", Convert::ToString(std::numeric_limits<float>::denorm_min()));
+}
+
 //-----------------------------------------------------------------------------
 TEST(ConvertFundamentals, DoubleFromString) {
 	EXPECT_EQ(-0.0, Convert::To<double>("  -0  "));
@@ -249,6 +304,22 @@ TEST(ConvertFundamentals, DoubleFromString) {
 	EXPECT_EQ(-1234567.1234567, Convert::To<double>(U"  -1234567.1234567  "));
 }
 
+TEST(ConvertFundamentals, DoubleFromStringShouldRoundTrip) {
+	EXPECT_EQ(std::numeric_limits<double>::max(), Convert::To<double>(Convert::ToString(std::numeric_limits<double>::max())));
+	EXPECT_EQ(std::numeric_limits<double>::denorm_min(), Convert::To<double>(Convert::To<std::u32string>(std::numeric_limits<double>::denorm_min())));
+	EXPECT_EQ(0.1 + 0.2, Convert::To<double>(Convert::To<std::wstring>(0.1 + 0.2)));
+}
+
+TEST(ConvertFundamentals, DoubleFromLongString) {
+	EXPECT_EQ(1.5, Convert::To<double>(std::string(100, '0') + "1.5"));
+	EXPECT_EQ(1.5, Convert::To<double>(std::u16string(100, u'0') + u"1.5"));
+}
+
+TEST(ConvertFundamentals, DoubleFromStringWithOutOfRangeValueShouldThrowException) {
+	EXPECT_THROW(Convert::To<double>("1e400"), std::out_of_range);
+	EXPECT_THROW(Convert::To<double>(U"1e400"), std::out_of_range);
+}
+
 TEST(ConvertFundamentals, DoubleFromEmptyStringShouldThrowException) {
 	EXPECT_THROW(Convert::To<double>(""), std::invalid_argument);
 }
@@ -265,6 +336,13 @@ TEST(ConvertFundamentals, DoubleToString) {
 	EXPECT_EQ(U"1234567.1234567", Convert::To<std::u32string>(1234567.1234567));
 }
 
+TEST(ConvertFundamentals, DoubleToStringShouldBeShortestRoundTrip) {
+	EXPECT_EQ("0.30000000000000004", Convert::ToString(0.1 + 0.2));
+	EXPECT_EQ(u"1e+100", Convert::To<std::u16string>(1e100));
+	EXPECT_EQ("1.7976931348623157e+308", Convert::ToString(std::numeric_limits<double>::max()));
+	EXPECT_EQ("2.2250738585072014e-308", Convert::ToString(std::numeric_limits<double>::min()));
+}
+
 //-----------------------------------------------------------------------------
 
 TEST(ConvertFundamentals, LongDoubleFromString) {
@@ -54,6 +54,23 @@ public:
 		}
 	}
 
+	void ReadBlocksFromStream()
+	{
+		static constexpr int MaxIterartions = 100;
+
+		typename reader_type::target_string_view_type block;
+		for (int i = 0; i < MaxIterartions; ++i)
+		{
+			if (!mEncodedStreamReader->ReadBlock(block))
+			{
+				break;
+			}
+			mActualString.append(block);
+			// For prevent infinite loop when something went wrong
+			ASSERT_TRUE(i < 100);
+		}
+	}
+
 protected:
 	std::string mInputString;
 	std::stringstream mInputStream;
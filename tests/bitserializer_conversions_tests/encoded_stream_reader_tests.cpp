@@ -159,3 +159,120 @@ TYPED_TEST(EncodedStreamReaderTest, ShouldReadFromUtf32BeStreamWithBom)
 	// Assert
 	EXPECT_EQ(this->mExpectedString, this->mActualString);
 }
+
+TYPED_TEST(EncodedStreamReaderTest, ShouldReadBlocksFromUtf8Stream)
+{
+	// Arrange
+	this->template PrepareEncodedStreamReader<Convert::Utf8>(U"Привет мир!", true);
+
+	// Act
+	this->ReadBlocksFromStream();
+
+	// Assert
+	EXPECT_EQ(this->mExpectedString, this->mActualString);
+}
+
+TYPED_TEST(EncodedStreamReaderTest, ShouldReadBlocksFromUtf16LeStream)
+{
+	// Arrange
+	this->template PrepareEncodedStreamReader<Convert::Utf16Le>(U"Привет мир!", true);
+
+	// Act
+	this->ReadBlocksFromStream();
+
+	// Assert
+	EXPECT_EQ(this->mExpectedString, this->mActualString);
+}
+
+//------------------------------------------------------------------------------
+
+TEST(EncodedStreamReader, ShouldUseChunkSizeWhichIsPassedToConstructor)
+{
+	// Arrange
+	std::stringstream inputStream(u8"Привет мир!");
+
+	// Act
+	Convert::CEncodedStreamReader<Convert::Utf8> encodedStreamReader(inputStream, 7);
+	std::string actual;
+	while (encodedStreamReader.ReadChunk(actual)) {}
+
+	// Assert
+	EXPECT_EQ(8U, encodedStreamReader.GetChunkSize());
+	EXPECT_EQ(u8"Привет мир!", actual);
+}
+
+TEST(EncodedStreamReader, ShouldReadWholeStreamByOneBlockWhenItFitsToChunk)
+{
+	// Arrange
+	std::stringstream inputStream("\xEF\xBB\xBF" "Hello world!");
+	Convert::CEncodedStreamReader<Convert::Utf8> encodedStreamReader(inputStream);
+	std::string_view block;
+
+	// Act / Assert
+	ASSERT_TRUE(encodedStreamReader.ReadBlock(block));
+	EXPECT_EQ("Hello world!", block);
+	EXPECT_FALSE(encodedStreamReader.ReadBlock(block));
+	EXPECT_TRUE(encodedStreamReader.IsEnd());
+}
+
+TEST(EncodedStreamReader, ShouldNotSplitUtf8SequencesBetweenBlocks)
+{
+	// Arrange
+	std::stringstream inputStream(u8"Привет мир!");
+	Convert::CEncodedStreamReader<Convert::Utf8> encodedStreamReader(inputStream, 5);
+	std::string_view block;
+	std::string actual;
+
+	// Act
+	while (encodedStreamReader.ReadBlock(block))
+	{
+		std::u32string decoded;
+		EXPECT_EQ(block.end(), Convert::Utf8::Decode(block.begin(), block.end(), decoded, Convert::EncodeErrorPolicy::ThrowException));
+		actual.append(block);
+	}
+
+	// Assert
+	EXPECT_EQ(u8"Привет мир!", actual);
+}
+
+TEST(EncodedStreamReader, ShouldWriteErrorMarkForInvalidUtf8SequencesWhenReadBlocks)
+{
+	// Arrange
+	std::stringstream inputStream("Hello\xFF world\xED\xA0\x80!\xC3");
+	Convert::CEncodedStreamReader<Convert::Utf8> encodedStreamReader(inputStream, 8, Convert::EncodeErrorPolicy::WriteErrorMark, "*");
+	std::string_view block;
+	std::string actual;
+
+	// Act
+	while (encodedStreamReader.ReadBlock(block)) {
+		actual.append(block);
+	}
+
+	// Assert
+	EXPECT_EQ("Hello* world***!*", actual);
+}
+
+TEST(EncodedStreamReader, ShouldSkipInvalidUtf8SequencesWhenReadChunks)
+{
+	// Arrange
+	std::stringstream inputStream("Hello\xC0\xAF world\xF4\x90\x80\x80!");
+	Convert::CEncodedStreamReader<Convert::Utf8> encodedStreamReader(inputStream, Convert::EncodeErrorPolicy::Skip);
+	std::string actual;
+
+	// Act
+	while (encodedStreamReader.ReadChunk(actual)) {}
+
+	// Assert
+	EXPECT_EQ("Hello world!", actual);
+}
+
+TEST(EncodedStreamReader, ShouldThrowExceptionForInvalidUtf8SequenceWhenReadBlocks)
+{
+	// Arrange
+	std::stringstream inputStream("Hello \x80 world!");
+	Convert::CEncodedStreamReader<Convert::Utf8> encodedStreamReader(inputStream, Convert::EncodeErrorPolicy::ThrowException);
+	std::string_view block;
+
+	// Act / Assert
+	EXPECT_THROW(while (encodedStreamReader.ReadBlock(block)) {}, std::runtime_error);
+}
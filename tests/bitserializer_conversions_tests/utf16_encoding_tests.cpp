@@ -353,6 +353,23 @@ TEST_F(Utf16BeDecodeTest, ShouldDecodeUtf16BeToUtf32WithSurrogates) {
 	EXPECT_EQ(U"😀😎🙋", DecodeUtf16As<std::u32string>(SwapByteOrder(u"😀😎🙋")));
 }
 
+TEST_F(Utf16BeDecodeTest, ShouldDecodeLongTextWithMixedCharacters)
+{
+	// Arrange (long blocks are decoded in bulk)
+	std::u16string sourceStr;
+	std::u32string expectedUtf32;
+	for (int i = 0; i < 10; ++i)
+	{
+		sourceStr += u"The quick brown fox jumps over the lazy dog_Привет😀";
+		expectedUtf32 += U"The quick brown fox jumps over the lazy dog_Привет😀";
+	}
+
+	// Act / Assert
+	EXPECT_EQ(sourceStr, DecodeUtf16As<std::u16string>(SwapByteOrder(sourceStr)));
+	EXPECT_EQ(expectedUtf32, DecodeUtf16As<std::u32string>(SwapByteOrder(sourceStr)));
+	EXPECT_EQ(Convert::To<std::string>(sourceStr), DecodeUtf16As<std::string>(SwapByteOrder(sourceStr)));
+}
+
 TEST_F(Utf16BeDecodeTest, ShouldPutErrorMarkWhenSurrogateStartsWithWrongCode) {
 	const std::u16string wrongStartCodes({ Convert::Unicode::LowSurrogatesEnd, Convert::Unicode::LowSurrogatesStart });
 	EXPECT_EQ(U"☐☐test☐☐",
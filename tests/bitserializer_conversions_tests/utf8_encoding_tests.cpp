@@ -101,6 +101,21 @@ TEST_F(Utf8EncodeTest, ShouldHandlePolicySkip) {
 	EXPECT_EQ(u8"test", EncodeUtf8(u"test\xDE00", Convert::EncodeErrorPolicy::Skip));
 }
 
+TEST_F(Utf8EncodeTest, ShouldEncodeLongTextWithMixedCharacters)
+{
+	// Arrange (long ASCII blocks are encoded in bulk)
+	std::u16string sourceStr;
+	std::string expectedStr;
+	for (int i = 0; i < 10; ++i)
+	{
+		sourceStr += u"The quick brown fox jumps over the lazy dog_Привет😀";
+		expectedStr += u8"The quick brown fox jumps over the lazy dog_Привет😀";
+	}
+
+	// Act / Assert
+	EXPECT_EQ(expectedStr, EncodeUtf8(sourceStr));
+}
+
 TEST_F(Utf8EncodeTest, ShouldReturnIteratorToEnd)
 {
 	// Arrange
@@ -266,4 +281,23 @@ TEST_F(Utf8DecodeTest, ShouldReturnIteratorToEnd)
 	EXPECT_TRUE(actualIt == testStr.cend());
 }
 
+TEST_F(Utf8DecodeTest, ShouldDecodeLongTextWithMixedCharacters)
+{
+	// Arrange (long ASCII blocks are decoded in bulk)
+	std::string sourceStr;
+	std::u16string expectedUtf16;
+	std::u32string expectedUtf32;
+	for (int i = 0; i < 10; ++i)
+	{
+		sourceStr += u8"The quick brown fox jumps over the lazy dog_Привет😀";
+		expectedUtf16 += u"The quick brown fox jumps over the lazy dog_Привет😀";
+		expectedUtf32 += U"The quick brown fox jumps over the lazy dog_Привет😀";
+	}
+
+	// Act / Assert
+	EXPECT_EQ(expectedUtf16, DecodeUtf8As<std::u16string>(sourceStr));
+	EXPECT_EQ(expectedUtf32, DecodeUtf8As<std::u32string>(sourceStr));
+	EXPECT_EQ(u"ASCII text before the wrong start code☐", DecodeUtf8As<std::u16string>("ASCII text before the wrong start code\xFE"));
+}
+
 #pragma warning(pop)
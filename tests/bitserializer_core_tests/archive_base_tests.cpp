@@ -2,6 +2,7 @@
 * Copyright (C) 2018-2023 by Pavel Kisliak                                     *
 * This file is part of BitSerializer library, licensed under the MIT license.  *
 *******************************************************************************/
+#include <cstring>
 #include <gtest/gtest.h>
 #include "bitserializer/serialization_detail/archive_base.h"
 
@@ -188,3 +189,65 @@ TEST(ArchiveBase_SafeNumberCast, ShouldReturnFalseWhenOverflowNegativeFloat)
 	EXPECT_FALSE(Detail::SafeNumberCast(sourceNumber, targetNumber, OverflowNumberPolicy::Skip));
 	EXPECT_EQ(0.f, targetNumber);
 }
+
+//-----------------------------------------------------------------------------
+// Tests of GetKeyView()
+//-----------------------------------------------------------------------------
+TEST(ArchiveBase_GetKeyView, ShouldGetLengthOfStringLiteralAtCompileTime)
+{
+	constexpr auto keyView = Detail::GetKeyView("Key1");
+	static_assert(keyView.size() == 4);
+	EXPECT_EQ("Key1", keyView);
+}
+
+TEST(ArchiveBase_GetKeyView, ShouldGetViewOfWideStringLiteral)
+{
+	const auto keyView = Detail::GetKeyView(L"Key");
+	static_assert(std::is_same_v<std::wstring_view, std::decay_t<decltype(keyView)>>);
+	EXPECT_EQ(L"Key", keyView);
+}
+
+TEST(ArchiveBase_GetKeyView, ShouldGetViewOfEmptyStringLiteral)
+{
+	constexpr auto keyView = Detail::GetKeyView(u"");
+	static_assert(keyView.empty());
+}
+
+TEST(ArchiveBase_GetKeyView, ShouldGetViewOfPointerToCString)
+{
+	const char* key = "TestKey";
+	const auto keyView = Detail::GetKeyView(key);
+	EXPECT_EQ(key, keyView.data());
+	EXPECT_EQ(7, keyView.size());
+}
+
+TEST(ArchiveBase_GetKeyView, ShouldGetViewOfStdString)
+{
+	const std::u32string key = U"TestKey";
+	const auto keyView = Detail::GetKeyView(key);
+	EXPECT_EQ(key.data(), keyView.data());
+	EXPECT_EQ(key.size(), keyView.size());
+}
+
+TEST(ArchiveBase_GetKeyView, ShouldGetViewOfStringView)
+{
+	constexpr std::string_view key = "TestKey";
+	constexpr auto keyView = Detail::GetKeyView(key);
+	static_assert(keyView == key);
+}
+
+TEST(ArchiveBase_GetKeyView, ShouldGetViewOfCharArrayUntilNullTerminator)
+{
+	char key[16];
+	std::strcpy(key, "value");
+	const auto keyView = Detail::GetKeyView(key);
+	EXPECT_EQ(key, keyView.data());
+	EXPECT_EQ("value", keyView);
+}
+
+TEST(ArchiveBase_GetKeyView, ShouldGetViewOfWholeCharArrayWithoutNullTerminator)
+{
+	static constexpr char key[3] = { 'K', 'e', 'y' };
+	constexpr auto keyView = Detail::GetKeyView(key);
+	static_assert(keyView == "Key");
+}
@@ -0,0 +1,101 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include <filesystem>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <gtest/gtest.h>
+#include "bitserializer/serialization_detail/async_file_stream.h"
+
+using namespace BitSerializer::Detail;
+
+namespace
+{
+	std::string BuildTestData(size_t size)
+	{
+		std::string data(size, 0);
+		for (size_t i = 0; i < size; ++i) {
+			data[i] = static_cast<char>('a' + i % 26);
+		}
+		return data;
+	}
+
+	void WriteFile(const std::filesystem::path& path, const std::string& data, size_t blockSize)
+	{
+		AsyncFileWriteBuffer fileBuffer(blockSize);
+		ASSERT_TRUE(fileBuffer.Open(path));
+		std::ostream stream(&fileBuffer);
+		stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+		ASSERT_FALSE(stream.flush().fail());
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Tests of asynchronous file stream buffers
+//-----------------------------------------------------------------------------
+TEST(AsyncFileStream, ShouldWriteAndReadFileByBlocks)
+{
+	// Arrange
+	const auto path = std::filesystem::temp_directory_path() / "TestAsyncFileStream.data";
+	const auto expected = BuildTestData(10000);
+
+	// Act
+	WriteFile(path, expected, 64);
+	AsyncFileReadBuffer fileBuffer(64);
+	ASSERT_TRUE(fileBuffer.Open(path));
+	std::istream stream(&fileBuffer);
+	const std::string actual((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+	// Assert
+	EXPECT_EQ(expected, actual);
+}
+
+TEST(AsyncFileStream, ShouldReadFileWithSizeMultipleOfBlockSize)
+{
+	// Arrange
+	const auto path = std::filesystem::temp_directory_path() / "TestAsyncFileStream.data";
+	const auto expected = BuildTestData(256);
+
+	// Act
+	WriteFile(path, expected, 64);
+	AsyncFileReadBuffer fileBuffer(64);
+	ASSERT_TRUE(fileBuffer.Open(path));
+	std::istream stream(&fileBuffer);
+	const std::string actual((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+	// Assert
+	EXPECT_EQ(expected, actual);
+}
+
+TEST(AsyncFileStream, ShouldSeekWithinCurrentBlock)
+{
+	// Arrange
+	const auto path = std::filesystem::temp_directory_path() / "TestAsyncFileStream.data";
+	WriteFile(path, BuildTestData(100), 64);
+	AsyncFileReadBuffer fileBuffer(64);
+	ASSERT_TRUE(fileBuffer.Open(path));
+	std::istream stream(&fileBuffer);
+	char buffer[70];
+
+	// Act / Assert
+	EXPECT_EQ(0, stream.tellg());
+	stream.read(buffer, 3);
+	EXPECT_EQ(3, stream.tellg());
+	stream.seekg(1);
+	EXPECT_EQ('b', stream.get());
+
+	stream.read(buffer, 70);
+	EXPECT_EQ(72, stream.tellg());
+	stream.seekg(64);
+	EXPECT_EQ('m', stream.get());
+	EXPECT_TRUE(stream.seekg(0).fail());
+}
+
+TEST(AsyncFileStream, ShouldReturnFalseWhenFileDoesNotExist)
+{
+	AsyncFileReadBuffer fileBuffer;
+	EXPECT_FALSE(fileBuffer.Open(std::filesystem::temp_directory_path() / "NotExistingDir" / "NotExistingFile.data"));
+}
@@ -111,6 +111,21 @@ TEST(AutoAttributeValue, ShouldConvertKeyToRequiredType)
 	EXPECT_EQ("key1", attrValue.GetKey());
 }
 
+TEST(AutoAttributeValue, ShouldCacheConvertedStringLiteralKey)
+{
+	// Arrange
+	int value = 10;
+	constexpr auto& key = L"key1";
+
+	// Act
+	const auto attrValue1 = AutoAttributeValue(key, value).AdaptAndMoveToBaseAttributeValue<std::string>();
+	const auto attrValue2 = AutoAttributeValue(key, value).AdaptAndMoveToBaseAttributeValue<std::string>();
+
+	// Assert
+	EXPECT_EQ("key1", attrValue1.GetKey());
+	EXPECT_EQ(&attrValue1.GetKey(), &attrValue2.GetKey());
+}
+
 TEST(AutoAttributeValue, ShouldStoreRefToValue)
 {
 	// Arrange
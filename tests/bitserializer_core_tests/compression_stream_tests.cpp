@@ -0,0 +1,167 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <gtest/gtest.h>
+#include "bitserializer/serialization_detail/compression_stream.h"
+
+using namespace BitSerializer;
+using namespace BitSerializer::Detail;
+
+namespace
+{
+	std::string BuildTestData(size_t size)
+	{
+		std::string data(size, 0);
+		for (size_t i = 0; i < size; ++i) {
+			data[i] = static_cast<char>('a' + (i * 7 + i / 100) % 26);
+		}
+		return data;
+	}
+
+	std::string Compress(const std::string& data, CompressionType compression)
+	{
+		std::stringstream output;
+		CompressionOutputBuffer compressionBuffer(*output.rdbuf(), compression, 0);
+		std::ostream stream(&compressionBuffer);
+		stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+		compressionBuffer.Finish();
+		return output.str();
+	}
+
+	std::string Decompress(std::istream& input, CompressionType compression = CompressionType::None)
+	{
+		auto decompressionBuffer = DecompressionInputBuffer::Create(*input.rdbuf(), compression);
+		if (decompressionBuffer == nullptr) {
+			return { std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>() };
+		}
+		std::istream stream(decompressionBuffer.get());
+		std::string result{ std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>() };
+		decompressionBuffer->ThrowIfError();
+		return result;
+	}
+
+	std::string Decompress(const std::string& data, CompressionType compression = CompressionType::None)
+	{
+		std::istringstream input(data);
+		return Decompress(input, compression);
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Tests of compression stream buffers
+//-----------------------------------------------------------------------------
+TEST(CompressionStream, ShouldDetectCompressionByMagicBytes)
+{
+	EXPECT_EQ(CompressionType::Gzip, DetectCompression("\x1F\x8B\x08"));
+	EXPECT_EQ(CompressionType::Zstd, DetectCompression("\x28\xB5\x2F\xFD"));
+	// Zlib has no real magic number, so it is not detected
+	EXPECT_EQ(CompressionType::None, DetectCompression("\x78\x9C"));
+	EXPECT_EQ(CompressionType::None, DetectCompression("x,y"));
+	EXPECT_EQ(CompressionType::None, DetectCompression("(\xB5"));
+	EXPECT_EQ(CompressionType::None, DetectCompression(""));
+}
+
+TEST(CompressionStream, ShouldPassThroughNotCompressedData)
+{
+	std::istringstream input("x,y\n1,2\n");
+	EXPECT_EQ(nullptr, DecompressionInputBuffer::Create(*input.rdbuf()));
+	EXPECT_EQ("x,y\n1,2\n", Decompress(input));
+}
+
+TEST(CompressionStream, ShouldPassThroughTextWhichLooksLikeZlibHeader)
+{
+	std::istringstream input("x^2,y\n1,2\n");
+	EXPECT_EQ(nullptr, DecompressionInputBuffer::Create(*input.rdbuf()));
+	EXPECT_EQ("x^2,y\n1,2\n", Decompress(input));
+}
+
+TEST(CompressionStream, ShouldPassThroughNotCompressedDataWhenMagicBytesCannotBePutBack)
+{
+	// Unbuffered source does not support putting back characters
+	class UnbufferedSource : public std::streambuf
+	{
+	public:
+		explicit UnbufferedSource(std::string data) : mData(std::move(data)) {}
+	protected:
+		int_type underflow() override { return mPos < mData.size() ? traits_type::to_int_type(mData[mPos]) : traits_type::eof(); }
+		int_type uflow() override { return mPos < mData.size() ? traits_type::to_int_type(mData[mPos++]) : traits_type::eof(); }
+	private:
+		std::string mData;
+		size_t mPos = 0;
+	};
+
+	// The first byte is the same as in the gzip signature
+	UnbufferedSource source("\x1Fxyz,abc");
+	auto decompressionBuffer = DecompressionInputBuffer::Create(source);
+	ASSERT_NE(nullptr, decompressionBuffer);
+	std::istream stream(decompressionBuffer.get());
+	EXPECT_EQ("\x1Fxyz,abc", std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()));
+}
+
+#if defined BITSERIALIZER_HAS_ZLIB
+TEST(CompressionStream, ShouldCompressAndDecompressGzip)
+{
+	const auto data = BuildTestData(DecompressionInputBuffer::BlockSize * 3 + 17);
+	const auto compressed = Compress(data, CompressionType::Gzip);
+	EXPECT_EQ(CompressionType::Gzip, DetectCompression(compressed));
+	EXPECT_LT(compressed.size(), data.size() / 10);
+	EXPECT_EQ(data, Decompress(compressed));
+}
+
+TEST(CompressionStream, ShouldCompressAndDecompressZlib)
+{
+	const auto data = BuildTestData(1000);
+	const auto compressed = Compress(data, CompressionType::Zlib);
+	EXPECT_EQ(data, Decompress(compressed, CompressionType::Zlib));
+}
+
+TEST(CompressionStream, ShouldDecompressConcatenatedGzipMembers)
+{
+	const auto compressed = Compress("first,", CompressionType::Gzip) + Compress("second", CompressionType::Gzip);
+	EXPECT_EQ("first,second", Decompress(compressed));
+}
+
+TEST(CompressionStream, ShouldSupportSeekingWithinCurrentBlock)
+{
+	std::istringstream input(Compress(BuildTestData(1000), CompressionType::Gzip));
+	auto decompressionBuffer = DecompressionInputBuffer::Create(*input.rdbuf());
+	ASSERT_NE(nullptr, decompressionBuffer);
+	std::istream stream(decompressionBuffer.get());
+
+	char buffer[10];
+	ASSERT_TRUE(stream.read(buffer, sizeof buffer));
+	EXPECT_EQ(std::streampos(10), stream.tellg());
+	ASSERT_TRUE(stream.seekg(3));
+	EXPECT_EQ(BuildTestData(1000).substr(3), std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()));
+}
+
+TEST(CompressionStream, ShouldReportErrorWhenCompressedDataIsTruncated)
+{
+	const auto compressed = Compress(BuildTestData(100000), CompressionType::Gzip);
+	EXPECT_THROW(Decompress(compressed.substr(0, compressed.size() / 2)), ParsingException);
+}
+
+TEST(CompressionStream, ShouldReportErrorWhenCompressedDataIsCorrupted)
+{
+	auto compressed = Compress(BuildTestData(100000), CompressionType::Zlib);
+	compressed[compressed.size() / 2] ^= 0x55;
+	compressed[compressed.size() / 2 + 1] ^= 0x55;
+	EXPECT_THROW(Decompress(compressed, CompressionType::Zlib), ParsingException);
+}
+#endif
+
+#if defined BITSERIALIZER_HAS_ZSTD
+TEST(CompressionStream, ShouldCompressAndDecompressZstd)
+{
+	const auto data = BuildTestData(DecompressionInputBuffer::BlockSize * 3 + 17);
+	const auto compressed = Compress(data, CompressionType::Zstd);
+	EXPECT_EQ(CompressionType::Zstd, DetectCompression(compressed));
+	EXPECT_EQ(data, Decompress(compressed));
+}
+#endif
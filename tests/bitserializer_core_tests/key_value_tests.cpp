@@ -2,6 +2,7 @@
 * Copyright (C) 2018-2023 by Pavel Kisliak                                     *
 * This file is part of BitSerializer library, licensed under the MIT license.  *
 *******************************************************************************/
+#include <cwchar>
 #include <gtest/gtest.h>
 #include "bitserializer/serialization_detail/key_value.h"
 #include "bitserializer/serialization_detail/validators.h"
@@ -111,6 +112,69 @@ TEST(AutoKeyValue, ShouldConvertKeyToRequiredType)
 	EXPECT_EQ("key1", keyValue.GetKey());
 }
 
+TEST(AutoKeyValue, ShouldConvertStringLiteralKeyToRequiredType)
+{
+	// Arrange
+	int value = 10;
+
+	// Act
+	const auto keyValue = AutoKeyValue(L"key1", value).AdaptAndMoveToBaseKeyValue<std::string>();
+
+	// Assert
+	EXPECT_EQ("key1", keyValue.GetKey());
+}
+
+TEST(AutoKeyValue, ShouldCacheConvertedStringLiteralKey)
+{
+	// Arrange
+	int value = 10;
+	constexpr auto& key = L"key1";
+
+	// Act
+	const auto keyValue1 = AutoKeyValue(key, value).AdaptAndMoveToBaseKeyValue<std::string>();
+	const auto keyValue2 = AutoKeyValue(key, value).AdaptAndMoveToBaseKeyValue<std::string>();
+
+	// Assert
+	EXPECT_EQ(&keyValue1.GetKey(), &keyValue2.GetKey());
+}
+
+TEST(AutoKeyValue, ShouldConvertAgainWhenCachedKeyAddressHasDifferentText)
+{
+	// Arrange (emulates local arrays which are placed at the same address in different calls)
+	int value = 10;
+	wchar_t buffer[8] = L"first";
+	const wchar_t(&key)[8] = buffer;
+	const auto keyValue1 = AutoKeyValue(key, value).AdaptAndMoveToBaseKeyValue<std::string>();
+	EXPECT_EQ("first", keyValue1.GetKey());
+
+	// Act
+	std::wcscpy(buffer, L"second");
+	const auto keyValue2 = AutoKeyValue(key, value).AdaptAndMoveToBaseKeyValue<std::string>();
+
+	// Assert
+	EXPECT_EQ("second", keyValue2.GetKey());
+}
+
+TEST(AutoKeyValue, ShouldNotChangePreviouslyAdaptedKeyWhenCachedKeyAddressHasDifferentText)
+{
+	// Arrange
+	int value = 10;
+	wchar_t buffer[8] = L"first";
+	const wchar_t(&key)[8] = buffer;
+	const auto keyValue1 = AutoKeyValue(key, value).AdaptAndMoveToBaseKeyValue<std::string>();
+
+	// Act
+	std::wcscpy(buffer, L"second");
+	const auto keyValue2 = AutoKeyValue(key, value).AdaptAndMoveToBaseKeyValue<std::string>();
+	std::wcscpy(buffer, L"first");
+	const auto keyValue3 = AutoKeyValue(key, value).AdaptAndMoveToBaseKeyValue<std::string>();
+
+	// Assert
+	EXPECT_EQ("first", keyValue1.GetKey());
+	EXPECT_EQ("second", keyValue2.GetKey());
+	EXPECT_EQ(&keyValue1.GetKey(), &keyValue3.GetKey());
+}
+
 TEST(AutoKeyValue, ShouldStoreRefToValue)
 {
 	// Arrange
@@ -0,0 +1,85 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include <gtest/gtest.h>
+#include "bitserializer/lazy.h"
+#include "testing_tools/common_test_methods.h"
+#include "testing_tools/archive_stub.h"
+
+using namespace BitSerializer;
+
+//-----------------------------------------------------------------------------
+// Tests of Lazy<T> in archives without support of raw fragments (the value is loaded immediately)
+//-----------------------------------------------------------------------------
+namespace
+{
+	struct TestClassWithLazyMember
+	{
+		template <class TArchive>
+		void Serialize(TArchive& archive)
+		{
+			archive << AutoKeyValue("value", value);
+		}
+
+		Lazy<TestClassWithSubTypes<int, TestPointClass>> value;
+	};
+}
+
+TEST(LazyValue, ShouldSerializeAsClassMember)
+{
+	// Arrange
+	TestClassWithSubTypes<int, TestPointClass> sourceValue;
+	::BuildFixture(sourceValue);
+	TestClassWithLazyMember source;
+	source.value = sourceValue;
+	ArchiveStub::preferred_output_format output;
+	TestClassWithLazyMember actual;
+
+	// Act
+	BitSerializer::SaveObject<ArchiveStub>(source, output);
+	BitSerializer::LoadObject<ArchiveStub>(actual, output);
+
+	// Assert
+	EXPECT_TRUE(actual.value.IsLoaded());
+	EXPECT_FALSE(actual.value.HasFragment());
+	sourceValue.Assert(std::as_const(actual.value).Get());
+}
+
+TEST(LazyValue, ShouldSerializeInArray)
+{
+	// Arrange
+	std::vector<Lazy<TestPointClass>> source(3);
+	for (auto& item : source) {
+		::BuildFixture(item.Get());
+	}
+	ArchiveStub::preferred_output_format output;
+	std::vector<Lazy<TestPointClass>> actual;
+
+	// Act
+	BitSerializer::SaveObject<ArchiveStub>(source, output);
+	BitSerializer::LoadObject<ArchiveStub>(actual, output);
+
+	// Assert
+	ASSERT_EQ(source.size(), actual.size());
+	for (size_t i = 0; i < source.size(); ++i) {
+		EXPECT_EQ(std::as_const(source[i]).Get(), std::as_const(actual[i]).Get());
+	}
+}
+
+TEST(LazyValue, ShouldCopyAndMoveValue)
+{
+	// Arrange
+	Lazy<std::string> source(std::string("test"));
+
+	// Act
+	Lazy<std::string> copied(source);
+	Lazy<std::string> moved(std::move(copied));
+	Lazy<std::string> assigned;
+	assigned = moved;
+
+	// Assert
+	EXPECT_EQ("test", *moved);
+	EXPECT_EQ("test", *assigned);
+	EXPECT_EQ(4U, assigned->size());
+}
@@ -77,6 +77,30 @@ TEST(STD_Containers, SerializeVectorOfBooleansAsClassMember) {
 	TestSerializeClass<ArchiveStub>(BuildFixture<TestClassWithSubType<test_type>>());
 }
 
+TEST(STD_Containers, ShouldLoadVectorInParallel) {
+	TestParallelLoadContainer<ArchiveStub, std::vector<int>>();
+	TestParallelLoadContainer<ArchiveStub, std::vector<std::string>>();
+	TestParallelLoadContainer<ArchiveStub, std::vector<TestPointClass>>();
+}
+
+TEST(STD_Containers, ShouldLoadVectorOfVectorsInParallel) {
+	TestParallelLoadContainer<ArchiveStub, std::vector<std::vector<int>>>(100);
+}
+
+TEST(STD_Containers, ShouldSaveVectorInParallel) {
+	TestParallelSaveContainer<ArchiveStub, std::vector<int>>();
+	TestParallelSaveContainer<ArchiveStub, std::vector<std::string>>();
+	TestParallelSaveContainer<ArchiveStub, std::vector<TestPointClass>>();
+}
+
+TEST(STD_Containers, ShouldSaveVectorOfVectorsInParallel) {
+	TestParallelSaveContainer<ArchiveStub, std::vector<std::vector<int>>>(100);
+}
+
+TEST(STD_Containers, ShouldCollectValidationErrorsWhenLoadVectorInParallel) {
+	TestValidationWhenParallelLoadArray<ArchiveStub>();
+}
+
 //-----------------------------------------------------------------------------
 // Tests of serialization for std::deque
 //-----------------------------------------------------------------------------
@@ -98,6 +122,14 @@ TEST(STD_Containers, SerializeDequeAsClassMember) {
 	TestSerializeClass<ArchiveStub>(BuildFixture<TestClassWithSubType<test_type>>());
 }
 
+TEST(STD_Containers, ShouldLoadDequeInParallel) {
+	TestParallelLoadContainer<ArchiveStub, std::deque<float>>();
+}
+
+TEST(STD_Containers, ShouldSaveDequeInParallel) {
+	TestParallelSaveContainer<ArchiveStub, std::deque<float>>();
+}
+
 //-----------------------------------------------------------------------------
 // Tests of serialization for std::bitset
 //-----------------------------------------------------------------------------
@@ -0,0 +1,86 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include <atomic>
+#include <stdexcept>
+#include <gtest/gtest.h>
+#include "bitserializer/serialization_detail/thread_pool.h"
+
+using namespace BitSerializer;
+
+//-----------------------------------------------------------------------------
+// Tests of ThreadPool
+//-----------------------------------------------------------------------------
+TEST(ThreadPool, ShouldProcessAllTasks)
+{
+	// Arrange
+	ThreadPool threadPool(3);
+	std::vector<std::atomic<int>> calls(100);
+
+	// Act
+	threadPool.ParallelFor(calls.size(), [&calls](size_t taskIndex) {
+		++calls[taskIndex];
+	});
+
+	// Assert
+	for (const auto& callsNum : calls) {
+		EXPECT_EQ(1, callsNum);
+	}
+}
+
+TEST(ThreadPool, ShouldProcessTasksWhenPoolHasNoThreads)
+{
+	// Arrange
+	ThreadPool threadPool(0);
+	size_t processedTasks = 0;
+
+	// Act
+	threadPool.ParallelFor(10, [&processedTasks](size_t) {
+		++processedTasks;
+	});
+
+	// Assert
+	EXPECT_EQ(10, processedTasks);
+}
+
+TEST(ThreadPool, ShouldRethrowFirstExceptionAfterFinishingAllTasks)
+{
+	// Arrange
+	ThreadPool threadPool(3);
+	std::atomic<size_t> processedTasks = 0;
+
+	// Act / Assert
+	try
+	{
+		threadPool.ParallelFor(10, [&processedTasks](size_t taskIndex) {
+			++processedTasks;
+			if (taskIndex == 3 || taskIndex == 7) {
+				throw std::runtime_error(std::to_string(taskIndex));
+			}
+		});
+		FAIL() << "Exception was expected";
+	}
+	catch (const std::runtime_error& ex)
+	{
+		EXPECT_STREQ("3", ex.what());
+	}
+	EXPECT_EQ(10, processedTasks);
+}
+
+TEST(ThreadPool, ShouldProcessNestedTasksSequentially)
+{
+	// Arrange
+	ThreadPool threadPool(3);
+	std::atomic<size_t> processedTasks = 0;
+
+	// Act
+	threadPool.ParallelFor(4, [&threadPool, &processedTasks](size_t) {
+		threadPool.ParallelFor(4, [&processedTasks](size_t) {
+			++processedTasks;
+		});
+	});
+
+	// Assert
+	EXPECT_EQ(16, processedTasks);
+}
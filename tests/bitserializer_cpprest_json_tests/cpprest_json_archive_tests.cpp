@@ -5,6 +5,7 @@
 #include "bitserializer/cpprestjson_archive.h"
 #include "testing_tools/common_test_methods.h"
 #include "testing_tools/common_json_test_methods.h"
+#include "bitserializer/types/std/map.h"
 
 using BitSerializer::Json::CppRest::JsonArchive;
 
@@ -180,6 +181,32 @@ TEST(JsonRestCpp, ShouldIterateKeysInObjectScope) {
 	TestIterateKeysInObjectScope<JsonArchive>();
 }
 
+TEST(JsonRestCpp, SerializeWideObject)
+{
+	// Arrange
+	std::map<std::string, int> expected, actual;
+	for (int i = 1000; i > 0; --i) {
+		expected.emplace("field_" + std::to_string(i), i);
+	}
+
+	// Act
+	const auto jsonResult = BitSerializer::SaveObject<JsonArchive>(expected);
+	BitSerializer::LoadObject<JsonArchive>(actual, jsonResult);
+
+	// Assert
+	EXPECT_EQ(expected, actual);
+}
+
+TEST(JsonRestCpp, ShouldKeepRawFragmentOfLazyValue) {
+	TestLazyValueWithRawFragment<JsonArchive>();
+	TestLazyValuesInArray<JsonArchive>();
+}
+
+TEST(JsonRestCpp, ShouldSerializeRawJsonValues) {
+	TestRawJsonValue<JsonArchive>();
+	TestRawJsonValuesInArray<JsonArchive>();
+}
+
 //-----------------------------------------------------------------------------
 // Test paths in archive
 //-----------------------------------------------------------------------------
@@ -2,6 +2,7 @@
 * Copyright (C) 2018-2023 by Pavel Kisliak                                     *
 * This file is part of BitSerializer library, licensed under the MIT license.  *
 *******************************************************************************/
+#include <cstring>
 #include "testing_tools/common_test_methods.h"
 #include "csv_archive_fixture.h"
 
@@ -17,6 +18,49 @@ TEST_F(CsvArchiveTests, SerializeArrayOfClasses)
 	TestSerializeArray<CsvArchive, TestPointClass>();
 }
 
+TEST_F(CsvArchiveTests, SerializeArrayOfClassesWithEnums)
+{
+	TestSerializeArray<CsvArchive, TestClassWithSubTypes<TestEnum, int, TestEnum>>();
+}
+
+namespace
+{
+	struct TestClassWithBufferKeys
+	{
+		template <class TArchive>
+		void Serialize(TArchive& archive)
+		{
+			char xKey[16];
+			std::strcpy(xKey, "x");
+			char yKey[16];
+			std::strcpy(yKey, "y");
+			archive << KeyValue(xKey, x);
+			archive << KeyValue(yKey, y);
+		}
+
+		int x = 0, y = 0;
+	};
+}
+
+TEST_F(CsvArchiveTests, SerializeClassWithKeysInCharBuffers)
+{
+	// Arrange
+	TestClassWithBufferKeys source[1];
+	source[0].x = 10;
+	source[0].y = 20;
+	std::string outputData;
+	TestClassWithBufferKeys actual[1];
+
+	// Act
+	BitSerializer::SaveObject<CsvArchive>(source, outputData);
+	BitSerializer::LoadObject<CsvArchive>(actual, outputData);
+
+	// Assert
+	EXPECT_EQ("x,y\r\n10,20\r\n", outputData);
+	EXPECT_EQ(10, actual[0].x);
+	EXPECT_EQ(20, actual[0].y);
+}
+
 //-----------------------------------------------------------------------------
 // Test paths in archive
 //-----------------------------------------------------------------------------
@@ -160,6 +204,128 @@ TEST_F(CsvArchiveTests, SerializeToFile) {
 	TestSerializeArrayToFile<CsvArchive>();
 }
 
+TEST_F(CsvArchiveTests, SerializeToFileAsync) {
+	TestSerializeArrayToFileAsync<CsvArchive>();
+}
+
+#if defined BITSERIALIZER_HAS_ZLIB
+TEST_F(CsvArchiveTests, SerializeToGzipCompressedFile) {
+	TestSerializeArrayToCompressedFile<CsvArchive>(CompressionType::Gzip);
+}
+
+TEST_F(CsvArchiveTests, SerializeToZlibCompressedFile) {
+	TestSerializeArrayToCompressedFile<CsvArchive>(CompressionType::Zlib);
+}
+#endif
+
+#if defined BITSERIALIZER_HAS_ZSTD
+TEST_F(CsvArchiveTests, SerializeToZstdCompressedFile) {
+	TestSerializeArrayToCompressedFile<CsvArchive>(CompressionType::Zstd);
+}
+#endif
+
+//-----------------------------------------------------------------------------
+// Tests of parallel saving
+//-----------------------------------------------------------------------------
+TEST_F(CsvArchiveTests, ShouldSaveArrayInParallel) {
+	TestParallelSaveContainer<CsvArchive, std::vector<TestPointClass>>();
+	TestParallelSaveContainer<CsvArchive, std::vector<TestClassWithSubTypes<int, std::string, bool>>>();
+}
+
+TEST_F(CsvArchiveTests, ShouldSaveArrayInParallelToEncodedStream)
+{
+	SerializationOptions serializationOptions;
+	serializationOptions.streamOptions.encoding = Convert::UtfType::Utf16le;
+	serializationOptions.streamOptions.writeBom = true;
+	TestParallelSaveContainerToStream<CsvArchive, std::vector<TestPointClass>>(serializationOptions);
+}
+
+//-----------------------------------------------------------------------------
+// Tests of serializer session
+//-----------------------------------------------------------------------------
+TEST_F(CsvArchiveTests, ShouldReuseResourcesInSerializerSession) {
+	TestSerializerSession<CsvArchive, std::vector<TestPointClass>>();
+	TestSerializerSession<CsvArchive, std::vector<TestClassWithSubTypes<int, std::string, bool>>>();
+}
+
+TEST_F(CsvArchiveTests, ShouldKeepOptionsPassedAsTemporaryToSerializerSession)
+{
+	// Arrange
+	SerializerSession<CsvArchive> session(SerializationOptions{ {}, {}, {}, OverflowNumberPolicy::ThrowError, MismatchedTypesPolicy::ThrowError, ';' });
+	std::vector<TestPointClass> source(1, TestPointClass(1, 2));
+	std::vector<TestPointClass> actual;
+
+	// Act
+	const auto& output = session.SaveObject(source);
+	session.LoadObject(actual, output);
+
+	// Assert
+	EXPECT_EQ("x;y\r\n1;2\r\n", output);
+	ASSERT_EQ(1U, actual.size());
+	EXPECT_EQ(source[0], actual[0]);
+}
+
+TEST_F(CsvArchiveTests, ShouldSaveAndLoadBatchOfObjects) {
+	TestSaveLoadObjectsBatch<CsvArchive, std::vector<TestPointClass>>();
+}
+
+TEST_F(CsvArchiveTests, ShouldLoadRowByPath) {
+	TestLoadArrayItemByPath<CsvArchive>();
+}
+
+//-----------------------------------------------------------------------------
+// Tests of push-style loading
+//-----------------------------------------------------------------------------
+TEST_F(CsvArchiveTests, ShouldLoadRowsFedByChunks) {
+	TestPushLoader<CsvArchive, TestPointClass>();
+	TestPushLoader<CsvArchive, TestClassWithSubTypes<int, std::string, bool>>();
+}
+
+TEST_F(CsvArchiveTests, ShouldLoadQuotedValuesWithLineBreaksFedByChunks)
+{
+	std::vector<TestClassWithSubTypes<std::string, int>> expected(3);
+	expected[0] = { "first\nline", 1 };
+	expected[1] = { "\"quoted\",\r\nvalue", 2 };
+	expected[2] = { "last", 3 };
+	for (const size_t chunkSize : { 1, 3, 16 }) {
+		TestPushLoader<CsvArchive>(expected, chunkSize);
+	}
+}
+
+TEST_F(CsvArchiveTests, ShouldLoadLastRowWithoutLineEndingFedByChunks)
+{
+	std::vector<TestPointClass> actual;
+	PushLoader<CsvArchive, TestPointClass> loader([&actual](TestPointClass&& item) { actual.emplace_back(item); });
+	loader.Feed("x,y\r\n1,2\r\n3,");
+	EXPECT_EQ(1U, actual.size());
+	loader.Feed("4");
+	loader.Finish();
+
+	ASSERT_EQ(2U, actual.size());
+	EXPECT_EQ(3, actual[1].x);
+	EXPECT_EQ(4, actual[1].y);
+}
+
+TEST_F(CsvArchiveTests, ShouldKeepOptionsPassedAsTemporaryToPushLoader)
+{
+	std::vector<TestPointClass> actual;
+	PushLoader<CsvArchive, TestPointClass> loader([&actual](TestPointClass&& item) { actual.emplace_back(item); },
+		SerializationOptions{ {}, {}, {}, OverflowNumberPolicy::ThrowError, MismatchedTypesPolicy::ThrowError, ';' });
+	loader.Feed("x;y\r\n1;2\r\n");
+	loader.Finish();
+
+	ASSERT_EQ(1U, actual.size());
+	EXPECT_EQ(1, actual[0].x);
+	EXPECT_EQ(2, actual[0].y);
+}
+
+TEST_F(CsvArchiveTests, ThrowParsingExceptionWhenQuotedValueIsNotCompletedFedByChunks)
+{
+	PushLoader<CsvArchive, TestClassWithSubTypes<std::string>> loader([](auto&&) {});
+	loader.Feed("Member_0\r\n\"incomplete");
+	EXPECT_THROW(loader.Finish(), ParsingException);
+}
+
 //-----------------------------------------------------------------------------
 // Tests of errors handling
 //-----------------------------------------------------------------------------
@@ -212,6 +378,9 @@ TEST_F(CsvArchiveTests, ThrowMismatchedTypesExceptionWhenLoadStringToInteger) {
 TEST_F(CsvArchiveTests, ThrowMismatchedTypesExceptionWhenLoadStringToFloat) {
 	TestMismatchedTypesPolicy<CsvArchive, std::string, float>(MismatchedTypesPolicy::ThrowError);
 }
+TEST_F(CsvArchiveTests, ThrowMismatchedTypesExceptionWhenLoadStringToEnum) {
+	TestMismatchedTypesPolicy<CsvArchive, std::string, TestEnum>(MismatchedTypesPolicy::ThrowError);
+}
 TEST_F(CsvArchiveTests, ThrowSerializationExceptionWhenLoadFloatToInteger) {
 	TestMismatchedTypesPolicy<CsvArchive, float, uint32_t>(MismatchedTypesPolicy::ThrowError);
 	TestMismatchedTypesPolicy<CsvArchive, double, uint32_t>(MismatchedTypesPolicy::ThrowError);
@@ -5,6 +5,8 @@
 #include "bitserializer/pugixml_archive.h"
 #include "testing_tools/common_test_methods.h"
 #include "testing_tools/common_xml_test_methods.h"
+#include "bitserializer/types/std/map.h"
+#include "bitserializer/types/std/vector.h"
 
 using BitSerializer::Xml::PugiXml::XmlArchive;
 
@@ -58,6 +60,16 @@ TEST(PugiXmlArchive, SerializeTwoDimensionalArray) {
 	TestSerializeTwoDimensionalArray<XmlArchive, int32_t>();
 }
 
+TEST(PugiXmlArchive, ShouldLoadArrayInParallel) {
+	TestParallelLoadContainer<XmlArchive, std::vector<int32_t>>();
+	TestParallelLoadContainer<XmlArchive, std::vector<std::string>>();
+	TestParallelLoadContainer<XmlArchive, std::vector<TestPointClass>>();
+}
+
+TEST(PugiXmlArchive, ShouldCollectValidationErrorsWhenLoadArrayInParallel) {
+	TestValidationWhenParallelLoadArray<XmlArchive>();
+}
+
 //-----------------------------------------------------------------------------
 // Tests of serialization for classes
 //-----------------------------------------------------------------------------
@@ -130,6 +142,83 @@ TEST(PugiXmlArchive, ShouldAllowToLoadFloatFromInteger)
 	EXPECT_EQ(100, actual.GetValue());
 }
 
+namespace
+{
+	struct TestClassWithNotTerminatedKeys
+	{
+		template <class TArchive>
+		void Serialize(TArchive& archive)
+		{
+			static constexpr char xKey[] = { 'x' };
+			static constexpr char yKey[] = { 'y' };
+			archive << BitSerializer::KeyValue(xKey, x);
+			archive << BitSerializer::KeyValue(yKey, y);
+		}
+
+		int x = 0, y = 0;
+	};
+}
+
+TEST(PugiXmlArchive, ShouldLoadClassWithKeysWithoutNullTerminator)
+{
+	TestClassWithNotTerminatedKeys actual;
+	BitSerializer::LoadObject<XmlArchive>(actual, "<root><xy>1</xy><y>20</y><x>10</x></root>");
+	EXPECT_EQ(10, actual.x);
+	EXPECT_EQ(20, actual.y);
+}
+
+//-----------------------------------------------------------------------------
+// Tests of parse profiles
+//-----------------------------------------------------------------------------
+TEST(PugiXmlArchive, ShouldLoadWithMinimalParseProfile)
+{
+	// Arrange
+	BitSerializer::SerializationOptions serializationOptions;
+	serializationOptions.parseProfile = BitSerializer::ParseProfile::Minimal;
+	TestClassWithSubType<std::string> expected("<Hello & \"world\">");
+	std::string outputXml;
+	BitSerializer::SaveObject<XmlArchive>(expected, outputXml);
+	TestClassWithSubType<std::string> actual;
+
+	// Act
+	BitSerializer::LoadObject<XmlArchive>(actual, outputXml, serializationOptions);
+
+	// Assert
+	EXPECT_EQ(expected.GetValue(), actual.GetValue());
+}
+
+TEST(PugiXmlArchive, ShouldLoadIntegersWithMinimalParseProfile)
+{
+	// Arrange
+	BitSerializer::SerializationOptions serializationOptions;
+	serializationOptions.parseProfile = BitSerializer::ParseProfile::Minimal;
+	using TestType = TestClassWithSubTypes<int8_t, uint8_t, int16_t, uint16_t, int32_t, uint32_t, int64_t, uint64_t>;
+	auto expected = BuildFixture<TestType>();
+	std::string outputXml;
+	BitSerializer::SaveObject<XmlArchive>(expected, outputXml);
+	TestType actual;
+
+	// Act
+	BitSerializer::LoadObject<XmlArchive>(actual, outputXml, serializationOptions);
+
+	// Assert
+	expected.Assert(actual);
+}
+
+TEST(PugiXmlArchive, ShouldLoadDocumentWithDeclarationWithStrictParseProfile)
+{
+	// Arrange
+	BitSerializer::SerializationOptions serializationOptions;
+	serializationOptions.parseProfile = BitSerializer::ParseProfile::Strict;
+	TestClassWithSubType<int32_t> actual(0);
+
+	// Act
+	BitSerializer::LoadObject<XmlArchive>(actual, R"(<?xml version="1.0"?><!DOCTYPE root><root><TestValue>10</TestValue></root>)", serializationOptions);
+
+	// Assert
+	EXPECT_EQ(10, actual.GetValue());
+}
+
 //-----------------------------------------------------------------------------
 // Tests of serialization for attributes
 //-----------------------------------------------------------------------------
@@ -373,3 +462,220 @@ TEST(PugiXmlArchive, ThrowValidationExceptionWhenNumberOverflowInt32) {
 TEST(PugiXmlArchive, ThrowValidationExceptionWhenNumberOverflowFloat) {
 	TestOverflowNumberPolicy<XmlArchive, double, float>(BitSerializer::OverflowNumberPolicy::Skip);
 }
+
+//-----------------------------------------------------------------------------
+// Tests of streaming XML writer
+//-----------------------------------------------------------------------------
+using BitSerializer::Xml::PugiXml::XmlStreamingArchive;
+
+namespace
+{
+	class TestClassWithAttributeAfterChildElement
+	{
+	public:
+		template <class TArchive>
+		void Serialize(TArchive& archive)
+		{
+			archive << BitSerializer::KeyValue("x", x);
+			archive << BitSerializer::AttributeValue("y", y);
+		}
+
+		int x = 1;
+		int y = 2;
+	};
+}
+
+TEST(PugiXmlStreamingArchive, SerializeArrayOfClasses) {
+	TestSerializeArray<XmlStreamingArchive, TestPointClass>();
+}
+
+TEST(PugiXmlStreamingArchive, SerializeTwoDimensionalArray) {
+	TestSerializeTwoDimensionalArray<XmlStreamingArchive, int32_t>();
+}
+
+TEST(PugiXmlStreamingArchive, SerializeClassWithMemberString) {
+	TestSerializeClass<XmlStreamingArchive>(BuildFixture<TestClassWithSubTypes<std::string, std::wstring, std::u16string, std::u32string>>());
+}
+
+TEST(PugiXmlStreamingArchive, SerializeClassWithMemberNumbers) {
+	TestSerializeClass<XmlStreamingArchive>(BuildFixture<TestClassWithSubTypes<bool, int8_t, uint64_t, float, double>>());
+}
+
+TEST(PugiXmlStreamingArchive, SerializeClassHierarchy) {
+	TestSerializeClass<XmlStreamingArchive>(BuildFixture<TestClassWithInheritance>());
+}
+
+TEST(PugiXmlStreamingArchive, SerializeClassWithSubArrayOfClasses) {
+	TestSerializeClass<XmlStreamingArchive>(BuildFixture<TestClassWithSubArray<TestPointClass>>());
+}
+
+TEST(PugiXmlStreamingArchive, SerializeAttributes) {
+	TestSerializeClass<XmlStreamingArchive>(BuildFixture<TestClassWithAttributes<bool, int64_t, double, std::nullptr_t, std::string>>());
+}
+
+namespace
+{
+	void TestSaveSameXmlAsDomArchive(bool enableFormat)
+	{
+		// Arrange
+		using TestType = TestClassWithSubTypes<bool, int32_t, uint64_t, std::string, std::wstring, std::nullptr_t, std::vector<std::nullptr_t>>;
+		auto testObj = BuildFixture<TestType>();
+		BitSerializer::SerializationOptions serializationOptions;
+		serializationOptions.formatOptions.enableFormat = enableFormat;
+		std::string expectedXml, actualXml;
+		BitSerializer::SaveObject<XmlArchive>(testObj, expectedXml, serializationOptions);
+
+		// Act
+		BitSerializer::SaveObject<XmlStreamingArchive>(testObj, actualXml, serializationOptions);
+
+		// Assert
+		EXPECT_EQ(expectedXml, actualXml);
+	}
+}
+
+TEST(PugiXmlStreamingArchive, ShouldSaveSameXmlAsDomArchive) {
+	TestSaveSameXmlAsDomArchive(false);
+}
+
+TEST(PugiXmlStreamingArchive, ShouldSaveSameFormattedXmlAsDomArchive) {
+	TestSaveSameXmlAsDomArchive(true);
+}
+
+TEST(PugiXmlStreamingArchive, SaveWithFormatting) {
+	TestSaveFormattedXml<XmlStreamingArchive>();
+}
+
+TEST(PugiXmlStreamingArchive, SaveToUtf8StreamWithBom) {
+	TestSaveXmlToEncodedStream<XmlStreamingArchive, BitSerializer::Convert::Utf8>(true);
+}
+
+TEST(PugiXmlStreamingArchive, SaveToUtf16LeStreamWithBom) {
+	TestSaveXmlToEncodedStream<XmlStreamingArchive, BitSerializer::Convert::Utf16Le>(true);
+}
+
+TEST(PugiXmlStreamingArchive, SaveToUtf32BeStream) {
+	TestSaveXmlToEncodedStream<XmlStreamingArchive, BitSerializer::Convert::Utf32Be>(false);
+}
+
+TEST(PugiXmlStreamingArchive, IterateKeysInObjectScope) {
+	TestIterateKeysInObjectScope<XmlStreamingArchive>();
+}
+
+TEST(PugiXmlStreamingArchive, SerializeMap)
+{
+	// Arrange
+	std::map<std::string, int> expected{ { "x", 1 }, { "y", 2 }, { "z", 3 } }, actual;
+	std::string outputXml;
+
+	// Act
+	BitSerializer::SaveObject<XmlStreamingArchive>(expected, outputXml);
+	BitSerializer::LoadObject<XmlStreamingArchive>(actual, outputXml);
+
+	// Assert
+	EXPECT_EQ(expected, actual);
+}
+
+TEST(PugiXmlStreamingArchive, SerializeVectorOfClassesViaStream)
+{
+	// Arrange
+	std::vector<TestClassWithSubTypes<int32_t, std::string>> expected(1000), actual;
+	for (auto& item : expected) {
+		::BuildFixture(item);
+	}
+	std::stringstream stream;
+
+	// Act
+	BitSerializer::SaveObject<XmlStreamingArchive>(expected, stream);
+	stream.seekg(0);
+	BitSerializer::LoadObject<XmlStreamingArchive>(actual, stream);
+
+	// Assert
+	ASSERT_EQ(expected.size(), actual.size());
+	for (size_t i = 0; i < expected.size(); ++i) {
+		expected[i].Assert(actual[i]);
+	}
+}
+
+TEST(PugiXmlStreamingArchive, ShouldLoadElementsInAnyOrder)
+{
+	// Arrange
+	TestPointClass actual;
+
+	// Act
+	BitSerializer::LoadObject<XmlStreamingArchive>(actual, R"(<root><y>20</y><x>10</x></root>)");
+
+	// Assert
+	EXPECT_EQ(10, actual.x);
+	EXPECT_EQ(20, actual.y);
+}
+
+TEST(PugiXmlStreamingArchive, ShouldSkipUnknownElementsAndComments)
+{
+	// Arrange
+	TestPointClass actual;
+	const char* testXml = R"(<?xml version="1.0"?><!DOCTYPE root [<!ENTITY e "v">]><!-- comment -->
+<root>
+	<unknown attr="1"><z>1</z><![CDATA[</unknown>]]></unknown>
+	<x>10</x><!-- comment -->
+	<?pi data?><y>20</y>
+</root>)";
+
+	// Act
+	BitSerializer::LoadObject<XmlStreamingArchive>(actual, testXml);
+
+	// Assert
+	EXPECT_EQ(10, actual.x);
+	EXPECT_EQ(20, actual.y);
+}
+
+TEST(PugiXmlStreamingArchive, ShouldDecodeEntitiesAndCData)
+{
+	// Arrange
+	TestClassWithSubType<std::string> actual;
+
+	// Act
+	BitSerializer::LoadObject<XmlStreamingArchive>(actual,
+		"<root><TestValue>&lt;a&gt; &amp; &quot;&apos; &#x41;&#66; &unknown; <![CDATA[<b> & ]]>\r\n</TestValue></root>");
+
+	// Assert
+	EXPECT_EQ("<a> & \"' AB &unknown; <b> & \n", actual.GetValue());
+}
+
+TEST(PugiXmlStreamingArchive, ShouldKeepCharacterReferencesToSurrogatesAsIs)
+{
+	// Arrange
+	TestClassWithSubType<std::string> actual;
+
+	// Act
+	BitSerializer::LoadObject<XmlStreamingArchive>(actual, "<root><TestValue>&#xD800;&#57343;&#x10000;</TestValue></root>");
+
+	// Assert
+	EXPECT_EQ("&#xD800;&#57343;\xF0\x90\x80\x80", actual.GetValue());
+}
+
+TEST(PugiXmlStreamingArchive, LoadFromUtf8StreamWithBom) {
+	TestLoadXmlFromEncodedStream<XmlStreamingArchive, BitSerializer::Convert::Utf8>(true);
+}
+
+TEST(PugiXmlStreamingArchive, LoadFromUtf16BeStream) {
+	TestLoadXmlFromEncodedStream<XmlStreamingArchive, BitSerializer::Convert::Utf16Be>(false);
+}
+
+TEST(PugiXmlStreamingArchive, LoadFromUtf32LeStreamWithBom) {
+	TestLoadXmlFromEncodedStream<XmlStreamingArchive, BitSerializer::Convert::Utf32Le>(true);
+}
+
+TEST(PugiXmlStreamingArchive, ThrowExceptionWhenBadSyntaxInSource)
+{
+	TestPointClass testObj;
+	EXPECT_THROW(BitSerializer::LoadObject<XmlStreamingArchive>(testObj, "<root><x>10</x>"), BitSerializer::ParsingException);
+	EXPECT_THROW(BitSerializer::LoadObject<XmlStreamingArchive>(testObj, "<root><x>10</y></root>"), BitSerializer::ParsingException);
+	EXPECT_THROW(BitSerializer::LoadObject<XmlStreamingArchive>(testObj, "<root><x a=1>10</x></root>"), BitSerializer::ParsingException);
+}
+
+TEST(PugiXmlStreamingArchive, ThrowExceptionWhenAttributeSavedAfterChildElement)
+{
+	TestClassWithAttributeAfterChildElement testObj;
+	std::string outputXml;
+	EXPECT_THROW(BitSerializer::SaveObject<XmlStreamingArchive>(testObj, outputXml), BitSerializer::SerializationException);
+}
@@ -5,6 +5,7 @@
 #include "testing_tools/common_test_methods.h"
 #include "testing_tools/common_json_test_methods.h"
 #include "bitserializer/rapidjson_archive.h"
+#include "bitserializer/types/std/map.h"
 
 using BitSerializer::Json::RapidJson::JsonArchive;
 
@@ -148,6 +149,126 @@ TEST(RapidJsonArchive, SerializeTwoDimensionalArray)
 	TestSerializeTwoDimensionalArray<JsonArchive, int32_t>();
 }
 
+TEST(RapidJsonArchive, ShouldLoadArrayInParallel)
+{
+	TestParallelLoadContainer<JsonArchive, std::vector<int32_t>>();
+	TestParallelLoadContainer<JsonArchive, std::vector<std::string>>();
+	TestParallelLoadContainer<JsonArchive, std::vector<TestPointClass>>();
+}
+
+TEST(RapidJsonArchive, ShouldCollectValidationErrorsWhenLoadArrayInParallel)
+{
+	TestValidationWhenParallelLoadArray<JsonArchive>();
+}
+
+TEST(RapidJsonArchive, ShouldSaveArrayInParallel)
+{
+	TestParallelSaveContainer<JsonArchive, std::vector<int32_t>>();
+	TestParallelSaveContainer<JsonArchive, std::vector<std::string>>();
+	TestParallelSaveContainer<JsonArchive, std::vector<TestPointClass>>();
+}
+
+TEST(RapidJsonArchive, ShouldSaveArrayInParallelWithFormatting)
+{
+	BitSerializer::SerializationOptions serializationOptions;
+	serializationOptions.formatOptions.enableFormat = true;
+	TestParallelSaveContainer<JsonArchive, std::vector<std::vector<int32_t>>>(100, serializationOptions);
+}
+
+TEST(RapidJsonArchive, ShouldReuseResourcesInSerializerSession) {
+	TestSerializerSession<JsonArchive, std::vector<TestPointClass>>();
+	TestSerializerSession<JsonArchive, std::vector<std::string>>();
+}
+
+TEST(RapidJsonArchive, ShouldSaveAndLoadBatchOfObjects) {
+	TestSaveLoadObjectsBatch<JsonArchive, TestPointClass>();
+}
+
+TEST(RapidJsonArchive, ShouldLoadObjectByPath) {
+	TestLoadObjectByPath<JsonArchive>();
+	TestLoadArrayItemByPath<JsonArchive>();
+}
+
+TEST(RapidJsonArchive, ShouldKeepRawFragmentOfLazyValue) {
+	TestLazyValueWithRawFragment<JsonArchive>();
+	TestLazyValuesInArray<JsonArchive>();
+}
+
+TEST(RapidJsonArchive, ShouldLoadLazyValueOnceWhenConcurrentAccess) {
+	TestLazyValueConcurrentAccess<JsonArchive>();
+}
+
+TEST(RapidJsonArchive, ShouldSaveLazyValuesInParallel)
+{
+	BitSerializer::SerializationOptions serializationOptions;
+	serializationOptions.parallelOptions.enableParallelSave = true;
+	serializationOptions.parallelOptions.minArraySize = 1;
+	std::vector<BitSerializer::Lazy<TestPointClass>> source(4), loaded;
+	for (auto& item : source) {
+		::BuildFixture(item.Get());
+	}
+	const auto sourceJson = BitSerializer::SaveObject<JsonArchive>(source);
+	BitSerializer::LoadObject<JsonArchive>(loaded, sourceJson);
+	std::string forwardedJson;
+	BitSerializer::SaveObject<JsonArchive>(loaded, forwardedJson, serializationOptions);
+	EXPECT_EQ(sourceJson, forwardedJson);
+}
+
+TEST(RapidJsonArchive, ShouldSpliceRawJsonValues) {
+	TestRawJsonValue<JsonArchive>();
+	TestRawJsonValuesInArray<JsonArchive>();
+}
+
+TEST(RapidJsonArchive, ShouldQuoteStringsWhichLookLikeRawFragmentWrappers)
+{
+	// Arrange
+	std::vector<std::map<std::string, std::string>> source(1);
+	source[0]["$rawJson"] = R"({"x":1})";
+
+	// Act
+	std::string outputJson;
+	BitSerializer::SaveObject<JsonArchive>(source, outputJson);
+
+	// Assert
+	EXPECT_EQ(R"([{"$rawJson":"{\"x\":1}"}])", outputJson);
+}
+
+TEST(RapidJsonArchive, ShouldLoadArrayItemsFedByChunks) {
+	TestPushLoader<JsonArchive, TestPointClass>();
+	TestPushLoader<JsonArchive, TestClassWithSubTypes<std::string, std::vector<int>>>();
+}
+
+TEST(RapidJsonArchive, ShouldLoadArrayItemsWithSpecialSymbolsInStringsFedByChunks)
+{
+	std::vector<std::string> actual;
+	BitSerializer::PushLoader<JsonArchive, std::string> loader([&actual](std::string&& item) { actual.emplace_back(std::move(item)); });
+	const std::string_view json = "\xEF\xBB\xBF [ \"a,]\", \"\\\"[{\" ,\n\"\" ]  ";
+	for (const char ch : json) {
+		loader.Feed(std::string_view(&ch, 1));
+	}
+	loader.Finish();
+
+	const std::vector<std::string> expected = { "a,]", "\"[{", "" };
+	EXPECT_EQ(expected, actual);
+}
+
+TEST(RapidJsonArchive, ThrowParsingExceptionWhenArrayIsNotCompletedFedByChunks)
+{
+	BitSerializer::PushLoader<JsonArchive, int> loader([](int&&) {});
+	loader.Feed("[1, 2");
+	EXPECT_THROW(loader.Finish(), BitSerializer::ParsingException);
+	BitSerializer::PushLoader<JsonArchive, int> loader2([](int&&) {});
+	EXPECT_THROW(loader2.Feed("{\"x\": 1}"), BitSerializer::ParsingException);
+}
+
+TEST(RapidJsonArchive, ShouldSaveArrayInParallelToEncodedStream)
+{
+	BitSerializer::SerializationOptions serializationOptions;
+	serializationOptions.streamOptions.encoding = BitSerializer::Convert::UtfType::Utf16le;
+	serializationOptions.streamOptions.writeBom = true;
+	TestParallelSaveContainerToStream<JsonArchive, std::vector<std::wstring>>(serializationOptions);
+}
+
 //-----------------------------------------------------------------------------
 // Tests of serialization for classes
 //-----------------------------------------------------------------------------
@@ -341,6 +462,16 @@ TEST(RapidJsonArchive, SerializeToFile) {
 	TestSerializeArrayToFile<JsonArchive>();
 }
 
+TEST(RapidJsonArchive, SerializeToFileAsync) {
+	TestSerializeArrayToFileAsync<JsonArchive>();
+}
+
+#if defined BITSERIALIZER_HAS_ZLIB
+TEST(RapidJsonArchive, SerializeToGzipCompressedFile) {
+	TestSerializeArrayToCompressedFile<JsonArchive>(BitSerializer::CompressionType::Gzip);
+}
+#endif
+
 //-----------------------------------------------------------------------------
 // Tests of errors handling
 //-----------------------------------------------------------------------------
@@ -6,6 +6,8 @@
 #include "testing_tools/common_json_test_methods.h"
 #include "testing_tools/common_yaml_test_methods.h"
 #include "bitserializer/rapidyaml_archive.h"
+#include "bitserializer/types/std/map.h"
+#include "bitserializer/types/std/vector.h"
 
 using YamlArchive = BitSerializer::Yaml::RapidYaml::YamlArchive;
 
@@ -62,6 +64,42 @@ TEST(RapidYamlArchive, SerializeTwoDimensionalArray)
 	TestSerializeTwoDimensionalArray<YamlArchive, int32_t>();
 }
 
+TEST(RapidYamlArchive, ShouldLoadArrayInParallel)
+{
+	TestParallelLoadContainer<YamlArchive, std::vector<int32_t>>();
+	TestParallelLoadContainer<YamlArchive, std::vector<std::string>>();
+	TestParallelLoadContainer<YamlArchive, std::vector<TestPointClass>>();
+}
+
+TEST(RapidYamlArchive, ShouldCollectValidationErrorsWhenLoadArrayInParallel)
+{
+	TestValidationWhenParallelLoadArray<YamlArchive>();
+}
+
+TEST(RapidYamlArchive, ShouldSaveArrayInParallel)
+{
+	TestParallelSaveContainer<YamlArchive, std::vector<int32_t>>();
+	TestParallelSaveContainer<YamlArchive, std::vector<std::string>>();
+	TestParallelSaveContainer<YamlArchive, std::vector<TestPointClass>>();
+	TestParallelSaveContainer<YamlArchive, std::vector<std::vector<int32_t>>>(100);
+}
+
+TEST(RapidYamlArchive, ShouldSaveArrayInParallelToStream)
+{
+	BitSerializer::SerializationOptions serializationOptions;
+	serializationOptions.streamOptions.writeBom = true;
+	TestParallelSaveContainerToStream<YamlArchive, std::vector<TestPointClass>>(serializationOptions);
+}
+
+TEST(RapidYamlArchive, ShouldReuseResourcesInSerializerSession) {
+	TestSerializerSession<YamlArchive, std::vector<TestPointClass>>();
+}
+
+TEST(RapidYamlArchive, ShouldLoadObjectByPath) {
+	TestLoadObjectByPath<YamlArchive>();
+	TestLoadArrayItemByPath<YamlArchive>();
+}
+
 //-----------------------------------------------------------------------------
 // Tests of serialization for classes
 //-----------------------------------------------------------------------------
@@ -142,6 +180,22 @@ TEST(RapidYamlArchive, ShouldAllowToLoadFloatFromInteger)
 	EXPECT_EQ(100, actual.GetValue());
 }
 
+TEST(RapidYamlArchive, ShouldSaveFloatingPointInShortestForm)
+{
+	TestClassWithSubTypes testEntity(0.5, 0.1f, 1e100);
+	const auto actual = BitSerializer::SaveObject<YamlArchive>(testEntity);
+	EXPECT_NE(std::string::npos, actual.find("Member_0: 0.5\n"));
+	EXPECT_NE(std::string::npos, actual.find("Member_1: 0.1\n"));
+	EXPECT_NE(std::string::npos, actual.find("Member_2: 1e+100\n"));
+}
+
+TEST(RapidYamlArchive, ShouldLoadFloatWithLeadingPlus)
+{
+	TestClassWithSubType<double> actual(0);
+	BitSerializer::LoadObject<YamlArchive>(actual, "TestValue: +1.5");
+	EXPECT_EQ(1.5, actual.GetValue());
+}
+
 //-----------------------------------------------------------------------------
 // Test paths in archive
 //-----------------------------------------------------------------------------
@@ -184,6 +238,49 @@ TEST(RapidYamlArchive, LoadFromUtf8StreamWithBom) {
 	TestLoadYamlFromEncodedStream<YamlArchive, BitSerializer::Convert::Utf8>(true);
 }
 
+TEST(RapidYamlArchive, LoadLargeArrayFromStream)
+{
+	// Arrange
+	std::vector<TestPointClass> expected(10000), actual;
+	for (auto& item : expected) {
+		::BuildFixture(item);
+	}
+	std::stringstream stream;
+	BitSerializer::SaveObject<YamlArchive>(expected, stream);
+
+	// Act
+	BitSerializer::LoadObject<YamlArchive>(actual, stream);
+
+	// Assert
+	ASSERT_EQ(expected.size(), actual.size());
+	for (size_t i = 0; i < expected.size(); ++i) {
+		expected[i].Assert(actual[i]);
+	}
+}
+
+TEST(RapidYamlArchive, ShouldNotLeakDataBetweenSequentialSessions)
+{
+	// Arrange
+	std::map<std::string, int> expected1{ { "x", 1 }, { "y", 2 } }, actual1;
+	std::map<std::string, int> expected2{ { "z", 3 } }, actual2;
+	std::vector<int> expected3{ 4, 5, 6 }, actual3;
+
+	// Act (each session takes the tree which was released by the previous one)
+	const auto yaml1 = BitSerializer::SaveObject<YamlArchive>(expected1);
+	BitSerializer::LoadObject<YamlArchive>(actual1, yaml1);
+	const auto yaml2 = BitSerializer::SaveObject<YamlArchive>(expected2);
+	BitSerializer::LoadObject<YamlArchive>(actual2, yaml2);
+	const auto yaml3 = BitSerializer::SaveObject<YamlArchive>(expected3);
+	BitSerializer::LoadObject<YamlArchive>(actual3, yaml3);
+
+	// Assert
+	EXPECT_EQ(expected1, actual1);
+	EXPECT_EQ(expected2, actual2);
+	EXPECT_EQ(expected3, actual3);
+	EXPECT_EQ(std::string::npos, yaml2.find('x'));
+	EXPECT_EQ(std::string::npos, yaml3.find('z'));
+}
+
 TEST(RapidYamlArchive, SaveToUtf8Stream) {
 	TestSaveYamlToEncodedStream<YamlArchive, BitSerializer::Convert::Utf8>(false);
 }
@@ -195,6 +292,16 @@ TEST(RapidYamlArchive, SerializeToFile) {
 	TestSerializeArrayToFile<YamlArchive>();
 }
 
+TEST(RapidYamlArchive, SerializeToFileAsync) {
+	TestSerializeArrayToFileAsync<YamlArchive>();
+}
+
+#if defined BITSERIALIZER_HAS_ZLIB
+TEST(RapidYamlArchive, SerializeToGzipCompressedFile) {
+	TestSerializeArrayToCompressedFile<YamlArchive>(BitSerializer::CompressionType::Gzip);
+}
+#endif
+
 //-----------------------------------------------------------------------------
 // Tests of errors handling
 //-----------------------------------------------------------------------------